@@ -0,0 +1,524 @@
+/***********************************************************************
+ * Program:
+ *    Benchmark
+ * Summary:
+ *    Time the thread-aware containers against the simplest thing that
+ *    could work: a custom::list behind one std::mutex.
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#include "blockingQueue.h" // for custom::blocking_queue
+#include "indexedList.h"  // for custom::indexed_list
+#include "list.h"         // for custom::list
+#include "lruCache.h"     // for custom::lru_cache
+#include "mappedList.h"   // for custom::mapped_list
+#include "mpscList.h"     // for custom::mpsc_list
+#include "parallel.h"     // for custom::parallel_sort
+#include "serialize.h"    // for custom::serialize, custom::deserialize
+#include "simd.h"         // for custom::find, custom::count
+#include "smallList.h"    // for custom::small_list
+#include "soaList.h"      // for custom::soa_list
+
+#include <atomic>         // for std::atomic
+#include <chrono>         // for std::chrono
+#include <cstdio>         // for std::remove
+#include <functional>     // for std::less
+#include <iostream>       // for std::cout
+#include <mutex>          // for std::mutex
+#include <sstream>        // for std::stringstream
+#include <thread>         // for std::thread
+#include <utility>        // for std::pair
+#include <vector>         // for std::vector
+
+/**********************************************************************
+ * TIME IT
+ * Run a function and report how long it took in milliseconds
+ ***********************************************************************/
+template <class Function>
+double timeIt(Function f)
+{
+   auto begin = std::chrono::steady_clock::now();
+   f();
+   auto end = std::chrono::steady_clock::now();
+   return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+/**********************************************************************
+ * BENCH MPSC
+ * numProducers threads push numEach items while one thread pops them
+ ***********************************************************************/
+void benchMpsc(int numProducers, int numEach)
+{
+   const long total = (long)numProducers * numEach;
+
+   // baseline: one mutex around a custom::list
+   double msMutex = timeIt([&]()
+   {
+      custom::list<long> l;
+      std::mutex lock;
+      std::vector<std::thread> producers;
+      for (int t = 0; t < numProducers; t++)
+         producers.emplace_back([&]()
+         {
+            for (int i = 0; i < numEach; i++)
+            {
+               std::lock_guard<std::mutex> guard(lock);
+               l.push_back(i);
+            }
+         });
+      long numPopped = 0;
+      while (numPopped < total)
+      {
+         std::lock_guard<std::mutex> guard(lock);
+         if (!l.empty())
+         {
+            l.pop_front();
+            numPopped++;
+         }
+      }
+      for (std::thread & producer : producers)
+         producer.join();
+   });
+
+   // the lock-free queue, drained in batches
+   double msMpsc = timeIt([&]()
+   {
+      custom::mpsc_list<long> l;
+      std::vector<std::thread> producers;
+      for (int t = 0; t < numProducers; t++)
+         producers.emplace_back([&]()
+         {
+            for (int i = 0; i < numEach; i++)
+               l.push_back(i);
+         });
+      long numPopped = 0;
+      while (numPopped < total)
+         numPopped += l.drain([](long &&) {});
+      for (std::thread & producer : producers)
+         producer.join();
+   });
+
+   std::cout << "mpsc " << numProducers << "x" << numEach << ":\t"
+             << "mutex list " << msMutex << "ms\t"
+             << "mpsc_list "  << msMpsc  << "ms\n";
+}
+
+/**********************************************************************
+ * BENCH SORT
+ * Sort the same shuffled list serially and on numThreads threads
+ ***********************************************************************/
+void benchSort(int numElements, size_t numThreads)
+{
+   custom::list<int> lSerial;
+   unsigned int seed = 12345;
+   for (int i = 0; i < numElements; i++)
+   {
+      seed = seed * 1103515245 + 12345;
+      lSerial.push_back((int)(seed >> 8));
+   }
+   custom::list<int> lParallel(lSerial);
+
+   double msSerial = timeIt([&]() { lSerial.sort(); });
+   double msParallel = timeIt([&]()
+   {
+      custom::parallel_sort(lParallel, std::less<int>(), numThreads);
+   });
+
+   std::cout << "sort " << numElements << " on " << numThreads << ":\t"
+             << "list::sort " << msSerial << "ms\t"
+             << "parallel_sort " << msParallel << "ms\n";
+}
+
+/**********************************************************************
+ * BENCH QUEUE
+ * numWorkers threads consume numItems items from a blocking_queue,
+ * first one pop per item, then one pop_batch per batch
+ ***********************************************************************/
+void benchQueue(int numWorkers, int numItems)
+{
+   auto run = [&](bool batched)
+   {
+      return timeIt([&]()
+      {
+         custom::blocking_queue<long> q(4096);
+         std::vector<std::thread> workers;
+         std::atomic<long> sum(0);
+         for (int t = 0; t < numWorkers; t++)
+            workers.emplace_back([&]()
+            {
+               long local = 0;
+               long value;
+               custom::list<long> batch;
+               if (batched)
+                  while (q.pop_batch(batch, 256))
+                  {
+                     for (custom::list<long>::iterator it = batch.begin();
+                          it != batch.end(); ++it)
+                        local += *it;
+                     batch.clear();
+                  }
+               else
+                  while (q.pop(value))
+                     local += value;
+               sum += local;
+            });
+         for (int i = 0; i < numItems; i++)
+            q.push(i);
+         q.close();
+         for (std::thread & worker : workers)
+            worker.join();
+      });
+   };
+
+   double msSingle = run(false);
+   double msBatch = run(true);
+
+   std::cout << "queue " << numWorkers << " workers:\t"
+             << "pop " << msSingle << "ms\t"
+             << "pop_batch " << msBatch << "ms\n";
+}
+
+/**********************************************************************
+ * BENCH INDEX
+ * Look up numLookups random positions in a list of numElements by
+ * walking a custom::list and by indexed_list::at
+ ***********************************************************************/
+void benchIndex(int numElements, int numLookups)
+{
+   custom::list<int> l;
+   custom::indexed_list<int> li;
+   for (int i = 0; i < numElements; i++)
+   {
+      l.push_back(i);
+      li.push_back(i);
+   }
+
+   long sumWalk = 0;
+   long sumIndexed = 0;
+   double msWalk = timeIt([&]()
+   {
+      unsigned int seed = 12345;
+      for (int n = 0; n < numLookups; n++)
+      {
+         seed = seed * 1103515245 + 12345;
+         custom::list<int>::iterator it = l.begin();
+         for (int i = (int)((seed >> 8) % numElements); i > 0; i--)
+            ++it;
+         sumWalk += *it;
+      }
+   });
+   double msIndexed = timeIt([&]()
+   {
+      unsigned int seed = 12345;
+      for (int n = 0; n < numLookups; n++)
+      {
+         seed = seed * 1103515245 + 12345;
+         sumIndexed += li.at((seed >> 8) % numElements);
+      }
+   });
+
+   std::cout << "index " << numElements << ":\t"
+             << "list walk " << msWalk << "ms\t"
+             << "indexed_list::at " << msIndexed << "ms"
+             << (sumWalk == sumIndexed ? "" : "\tMISMATCH") << "\n";
+}
+
+/**********************************************************************
+ * BENCH LRU
+ * numHits random hits on a full cache of numKeys entries, touching by
+ * erase and push_front against lru_cache's splice to the front
+ ***********************************************************************/
+void benchLru(int numKeys, int numHits)
+{
+   typedef custom::list<std::pair<int, long>> Recency;
+   Recency l;
+   custom::unordered_map<int, Recency::iterator> index;
+   custom::lru_cache<int, long> c(numKeys);
+   for (int i = 0; i < numKeys; i++)
+   {
+      l.push_front(std::make_pair(i, (long)i));
+      index[i] = l.begin();
+      c.put(i, i);
+   }
+
+   long sumErase = 0;
+   long sumSplice = 0;
+   double msErase = timeIt([&]()
+   {
+      unsigned int seed = 12345;
+      for (int n = 0; n < numHits; n++)
+      {
+         seed = seed * 1103515245 + 12345;
+         Recency::iterator & it = index.find((int)((seed >> 8) % numKeys))->second;
+         std::pair<int, long> hit = *it;
+         l.erase(it);
+         l.push_front(hit);
+         it = l.begin();
+         sumErase += hit.second;
+      }
+   });
+   double msSplice = timeIt([&]()
+   {
+      unsigned int seed = 12345;
+      for (int n = 0; n < numHits; n++)
+      {
+         seed = seed * 1103515245 + 12345;
+         sumSplice += *c.get((int)((seed >> 8) % numKeys));
+      }
+   });
+
+   std::cout << "lru " << numKeys << ":\t"
+             << "erase+push_front " << msErase << "ms\t"
+             << "lru_cache::get " << msSplice << "ms"
+             << (sumErase == sumSplice ? "" : "\tMISMATCH") << "\n";
+}
+
+/**********************************************************************
+ * BENCH SMALL
+ * Build and destroy numLists lists of numEach elements, as a
+ * custom::list and as a small_list holding four nodes inline
+ ***********************************************************************/
+void benchSmall(int numLists, int numEach)
+{
+   long sumList = 0;
+   long sumSmall = 0;
+   double msList = timeIt([&]()
+   {
+      for (int n = 0; n < numLists; n++)
+      {
+         custom::list<int> l;
+         for (int i = 0; i < numEach; i++)
+            l.push_back(n + i);
+         sumList += l.back();
+      }
+   });
+   double msSmall = timeIt([&]()
+   {
+      for (int n = 0; n < numLists; n++)
+      {
+         custom::small_list<int, 4> l;
+         for (int i = 0; i < numEach; i++)
+            l.push_back(n + i);
+         sumSmall += l.back();
+      }
+   });
+
+   std::cout << "small " << numEach << ":\t"
+             << "list " << msList << "ms\t"
+             << "small_list<4> " << msSmall << "ms"
+             << (sumList == sumSmall ? "" : "\tMISMATCH") << "\n";
+}
+
+/**********************************************************************
+ * BENCH SOA
+ * Sum one field of numRecords records numPasses times, walking a
+ * custom::list of structs and scanning one soa_list column
+ ***********************************************************************/
+void benchSoa(int numRecords, int numPasses)
+{
+   struct Record
+   {
+      int id;
+      double price;
+      long quantity;
+      char name[40];
+   };
+   custom::list<Record> l;
+   custom::soa_list<int, double, long> soa;
+   for (int i = 0; i < numRecords; i++)
+   {
+      Record record = { i, i * 0.25, (long)i, "" };
+      l.push_back(record);
+      soa.push_back(i, i * 0.25, (long)i);
+   }
+
+   double sumList = 0.0;
+   double sumColumn = 0.0;
+   double msList = timeIt([&]()
+   {
+      for (int n = 0; n < numPasses; n++)
+         for (custom::list<Record>::iterator it = l.begin(); it != l.end(); ++it)
+            sumList += (*it).price;
+   });
+   double msColumn = timeIt([&]()
+   {
+      const std::vector<double> & prices = soa.column<1>();
+      for (int n = 0; n < numPasses; n++)
+         for (size_t i = 0; i < prices.size(); i++)
+            sumColumn += prices[i];
+   });
+
+   std::cout << "soa " << numRecords << ":\t"
+             << "list<Record> walk " << msList << "ms\t"
+             << "soa_list column " << msColumn << "ms"
+             << (sumList == sumColumn ? "" : "\tMISMATCH") << "\n";
+}
+
+/**********************************************************************
+ * BENCH FIND
+ * numSearches lookups by value in numElements ints: a walk of a
+ * custom::list, a plain loop over an array, and custom::find
+ ***********************************************************************/
+void benchFind(int numElements, int numSearches)
+{
+   custom::list<int> l;
+   std::vector<int> values;
+   for (int i = 0; i < numElements; i++)
+   {
+      l.push_back(i);
+      values.push_back(i);
+   }
+   const int * first = values.data();
+   const int * last = first + values.size();
+
+   long sumList = 0;
+   long sumLoop = 0;
+   long sumFind = 0;
+   double msList = timeIt([&]()
+   {
+      unsigned int seed = 12345;
+      for (int n = 0; n < numSearches; n++)
+      {
+         seed = seed * 1103515245 + 12345;
+         sumList += *custom::find(l, (int)((seed >> 8) % numElements));
+      }
+   });
+   double msLoop = timeIt([&]()
+   {
+      unsigned int seed = 12345;
+      for (int n = 0; n < numSearches; n++)
+      {
+         seed = seed * 1103515245 + 12345;
+         sumLoop += *custom::simd::findScalar(first, last, (int)((seed >> 8) % numElements));
+      }
+   });
+   double msFind = timeIt([&]()
+   {
+      unsigned int seed = 12345;
+      for (int n = 0; n < numSearches; n++)
+      {
+         seed = seed * 1103515245 + 12345;
+         sumFind += *custom::find(first, last, (int)((seed >> 8) % numElements));
+      }
+   });
+
+   std::cout << "find " << numElements << ":\t"
+             << "list walk " << msList << "ms\t"
+             << "array loop " << msLoop << "ms\t"
+             << "custom::find " << msFind << "ms"
+             << (sumList == sumLoop && sumLoop == sumFind ? "" : "\tMISMATCH") << "\n";
+}
+
+/**********************************************************************
+ * BENCH SERIALIZE
+ * Checkpoint a list of doubles as text, one operator<< per element,
+ * and as the buffered binary format, then read each back
+ ***********************************************************************/
+void benchSerialize(int numElements)
+{
+   custom::list<double> l;
+   for (int i = 0; i < numElements; i++)
+      l.push_back(i * 0.125);
+
+   std::stringstream text;
+   std::stringstream binary;
+   custom::list<double> lText;
+   custom::list<double> lBinary;
+   double msText = timeIt([&]()
+   {
+      text.precision(17);
+      for (custom::list<double>::iterator it = l.begin(); it != l.end(); ++it)
+         text << *it << ' ';
+      double value;
+      while (text >> value)
+         lText.push_back(value);
+   });
+   double msBinary = timeIt([&]()
+   {
+      custom::serialize(l, binary);
+      lBinary = custom::deserialize<double>(binary);
+   });
+
+   std::cout << "serialize " << numElements << ":\t"
+             << "operator<< " << msText << "ms\t"
+             << "custom::serialize " << msBinary << "ms"
+             << (lText.size() == l.size() && lBinary.size() == l.size() ? "" : "\tMISMATCH") << "\n";
+}
+
+#ifdef CUSTOM_MAPPED_LIST
+/**********************************************************************
+ * BENCH RESTART
+ * Bring back a list of numElements doubles after a restart: parse a
+ * text dump into a custom::list, or reopen a custom::mapped_list.
+ * Both then walk the list once so the pages are really read.
+ ***********************************************************************/
+void benchRestart(int numElements)
+{
+   const char * path = "benchRestart.mapped";
+   std::remove(path);
+   std::stringstream text;
+   text.precision(17);
+   {
+      custom::mapped_list<double> lMapped(path, numElements);
+      for (int i = 0; i < numElements; i++)
+      {
+         text << i * 0.125 << ' ';
+         lMapped.push_back(i * 0.125);
+      }
+   }
+
+   double sumText = 0.0;
+   double sumMapped = 0.0;
+   double msText = timeIt([&]()
+   {
+      custom::list<double> l;
+      double value;
+      while (text >> value)
+         l.push_back(value);
+      for (custom::list<double>::iterator it = l.begin(); it != l.end(); ++it)
+         sumText += *it;
+   });
+   double msMapped = timeIt([&]()
+   {
+      custom::mapped_list<double> l(path);
+      for (custom::mapped_list<double>::iterator it = l.begin(); it != l.end(); ++it)
+         sumMapped += *it;
+   });
+   std::remove(path);
+
+   std::cout << "restart " << numElements << ":\t"
+             << "parse text dump " << msText << "ms\t"
+             << "reopen mapped_list " << msMapped << "ms"
+             << (sumText == sumMapped ? "" : "\tMISMATCH") << "\n";
+}
+#endif // CUSTOM_MAPPED_LIST
+
+/**********************************************************************
+ * MAIN
+ * Run each benchmark at a few thread counts
+ ***********************************************************************/
+int main()
+{
+   for (int numProducers : { 1, 2, 4, 8 })
+      benchMpsc(numProducers, 200000);
+   for (size_t numThreads : { 2, 4, 8 })
+      benchSort(1000000, numThreads);
+   for (int numWorkers : { 1, 2, 4 })
+      benchQueue(numWorkers, 1000000);
+   for (int numElements : { 1000, 20000 })
+      benchIndex(numElements, 2000);
+   for (int numKeys : { 1000, 100000 })
+      benchLru(numKeys, 1000000);
+   for (int numEach : { 2, 4, 8 })
+      benchSmall(1000000, numEach);
+   benchSoa(1000000, 20);
+   for (int numElements : { 1000, 100000 })
+      benchFind(numElements, 2000);
+   benchSerialize(1000000);
+#ifdef CUSTOM_MAPPED_LIST
+   benchRestart(1000000);
+#endif // CUSTOM_MAPPED_LIST
+
+   return 0;
+}
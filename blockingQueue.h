@@ -0,0 +1,335 @@
+/***********************************************************************
+ * Header:
+ *    BLOCKING QUEUE
+ * Summary:
+ *    A bounded producer/consumer queue on top of custom::list, guarded
+ *    by one mutex and two condition variables. Producers wait while the
+ *    queue is full, consumers wait while it is empty.
+ *
+ *    Taking one item per lock is what makes a busy worker pool spend
+ *    its time on the mutex instead of the work. pop_batch and drain
+ *    instead splice many nodes out in one go, so the consumer pays for
+ *    one lock and then walks its private list with no locking at all.
+ *    No element is copied or moved on the way; only nodes are relinked.
+ *
+ *    close() lets the consumers finish: once the queue is closed and
+ *    empty, every pop returns false instead of waiting.
+ *
+ *    This will contain the class definition of:
+ *        blocking_queue : A bounded, closable, thread-safe queue
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <chrono>              // for std::chrono::duration
+#include <condition_variable>  // for std::condition_variable
+#include <cstddef>             // for size_t
+#include <limits>              // for std::numeric_limits
+#include <mutex>               // for std::mutex, std::unique_lock
+#include <utility>             // for std::move
+#include "list.h"              // for custom::list
+
+class TestBlockingQueue; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * BLOCKING QUEUE
+ * Every method is safe from any thread. A capacity
+ * of 0 could never accept an item, so it is taken
+ * as 1; max_size() reports the capacity in effect.
+ **************************************************/
+template <typename T, typename A = std::allocator<T>>
+class blocking_queue
+{
+   friend class ::TestBlockingQueue; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   // a capacity of 0 becomes 1, see above
+   blocking_queue(size_t capacity = std::numeric_limits<size_t>::max())
+   : capacity(capacity ? capacity : 1), closed(false) {}
+   blocking_queue(const blocking_queue & rhs) = delete;
+   blocking_queue & operator = (const blocking_queue & rhs) = delete;
+
+   //
+   // Insert
+   //
+
+   bool push(const T &  data) { T copy(data); return push(std::move(copy)); }
+   bool push(      T && data);
+   template <class Rep, class Period>
+   bool push_for(T && data, const std::chrono::duration<Rep, Period> & timeout);
+   template <class Rep, class Period>
+   bool push_for(const T & data, const std::chrono::duration<Rep, Period> & timeout)
+   {
+      T copy(data);
+      return push_for(std::move(copy), timeout);
+   }
+
+   //
+   // Remove
+   //
+
+   bool pop(T & data);
+   bool try_pop(T & data);
+   template <class Rep, class Period>
+   bool pop_for(T & data, const std::chrono::duration<Rep, Period> & timeout);
+   size_t pop_batch(list <T, A> & out,
+                    size_t max = std::numeric_limits<size_t>::max());
+   size_t drain(list <T, A> & out);
+
+   //
+   // Status
+   //
+
+   void close();
+   bool is_closed() const;
+   size_t size() const;
+   bool empty() const { return size() == 0; }
+   size_t max_size() const { return capacity; }
+
+private:
+   T takeFront();
+   size_t takeFront(list <T, A> & out, size_t max);
+
+   // member variables
+   size_t capacity;                   // the most items pending at once
+   bool closed;                       // no more pushes accepted
+   list <T, A> pending;               // items waiting for a consumer
+   mutable std::mutex lock;           // guards everything above
+   std::condition_variable notEmpty;  // signaled when items arrive or on close
+   std::condition_variable notFull;   // signaled when room opens or on close
+};
+
+/*********************************************
+ * BLOCKING QUEUE :: PUSH
+ * Wait for room, then add to the back
+ *    INPUT  : the item
+ *    OUTPUT : false if the queue was closed
+ *    COST   : O(1) plus waiting
+ *********************************************/
+template <typename T, typename A>
+bool blocking_queue <T, A> :: push(T && data)
+{
+   std::unique_lock<std::mutex> guard(lock);
+   notFull.wait(guard, [this]() { return closed || pending.size() < capacity; });
+   if (closed)
+      return false;
+   pending.push_back(std::move(data));
+   guard.unlock();
+   notEmpty.notify_one();
+   return true;
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: PUSH FOR
+ * Like push, but give up after timeout
+ *    INPUT  : the item, how long to wait for room
+ *    OUTPUT : false if it timed out or the queue closed
+ *    COST   : O(1) plus waiting
+ *********************************************/
+template <typename T, typename A>
+template <class Rep, class Period>
+bool blocking_queue <T, A> :: push_for(T && data,
+                                       const std::chrono::duration<Rep, Period> & timeout)
+{
+   std::unique_lock<std::mutex> guard(lock);
+   if (!notFull.wait_for(guard, timeout,
+                         [this]() { return closed || pending.size() < capacity; }) ||
+       closed)
+      return false;
+   pending.push_back(std::move(data));
+   guard.unlock();
+   notEmpty.notify_one();
+   return true;
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: POP
+ * Wait for an item and take it off the front
+ *    INPUT  : where to put the item
+ *    OUTPUT : false once the queue is closed and empty
+ *    COST   : O(1) plus waiting
+ *********************************************/
+template <typename T, typename A>
+bool blocking_queue <T, A> :: pop(T & data)
+{
+   std::unique_lock<std::mutex> guard(lock);
+   notEmpty.wait(guard, [this]() { return closed || !pending.empty(); });
+   if (pending.empty())
+      return false;
+   data = takeFront();
+   guard.unlock();
+   notFull.notify_one();
+   return true;
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: TRY POP
+ * Take the front item if there is one, never wait
+ *    INPUT  : where to put the item
+ *    OUTPUT : false if the queue was empty
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+bool blocking_queue <T, A> :: try_pop(T & data)
+{
+   std::unique_lock<std::mutex> guard(lock);
+   if (pending.empty())
+      return false;
+   data = takeFront();
+   guard.unlock();
+   notFull.notify_one();
+   return true;
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: POP FOR
+ * Like pop, but give up after timeout
+ *    INPUT  : where to put the item, how long to wait
+ *    OUTPUT : false if it timed out or the queue is
+ *             closed and empty
+ *    COST   : O(1) plus waiting
+ *********************************************/
+template <typename T, typename A>
+template <class Rep, class Period>
+bool blocking_queue <T, A> :: pop_for(T & data,
+                                      const std::chrono::duration<Rep, Period> & timeout)
+{
+   std::unique_lock<std::mutex> guard(lock);
+   notEmpty.wait_for(guard, timeout, [this]() { return closed || !pending.empty(); });
+   if (pending.empty())
+      return false;
+   data = takeFront();
+   guard.unlock();
+   notFull.notify_one();
+   return true;
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: POP BATCH
+ * Wait for at least one item, then splice up to
+ * max of them onto the back of out under a single
+ * lock. Nothing is copied.
+ *    INPUT  : where the items go, how many at most
+ *    OUTPUT : how many were taken, 0 once the queue
+ *             is closed and empty
+ *    COST   : O(1) when taking everything, else O(max)
+ *********************************************/
+template <typename T, typename A>
+size_t blocking_queue <T, A> :: pop_batch(list <T, A> & out, size_t max)
+{
+   if (max == 0)
+      return 0;
+   std::unique_lock<std::mutex> guard(lock);
+   notEmpty.wait(guard, [this]() { return closed || !pending.empty(); });
+   size_t count = takeFront(out, max);
+   guard.unlock();
+   if (count)
+      notFull.notify_all();
+   return count;
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: DRAIN
+ * Take everything pending without waiting
+ *    INPUT  : where the items go
+ *    OUTPUT : how many were taken
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+size_t blocking_queue <T, A> :: drain(list <T, A> & out)
+{
+   std::unique_lock<std::mutex> guard(lock);
+   size_t count = takeFront(out, std::numeric_limits<size_t>::max());
+   guard.unlock();
+   if (count)
+      notFull.notify_all();
+   return count;
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: CLOSE
+ * Refuse further pushes and wake every waiter.
+ * Items already pending can still be popped.
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+void blocking_queue <T, A> :: close()
+{
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      closed = true;
+   }
+   notEmpty.notify_all();
+   notFull.notify_all();
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: IS CLOSED
+ *********************************************/
+template <typename T, typename A>
+bool blocking_queue <T, A> :: is_closed() const
+{
+   std::lock_guard<std::mutex> guard(lock);
+   return closed;
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: SIZE
+ * How many items are pending right now
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+size_t blocking_queue <T, A> :: size() const
+{
+   std::lock_guard<std::mutex> guard(lock);
+   return pending.size();
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: TAKE FRONT
+ * Remove and return the front item. The caller
+ * holds the lock and has checked it is not empty.
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+T blocking_queue <T, A> :: takeFront()
+{
+   T data(std::move(pending.front()));
+   pending.pop_front();
+   return data;
+}
+
+/*********************************************
+ * BLOCKING QUEUE :: TAKE FRONT
+ * Splice up to max items onto the back of out.
+ * The caller holds the lock. A partial batch is
+ * walked once, to find its end; the splice is
+ * handed the count instead of walking it again.
+ *    COST   : O(1) when taking everything, else O(max)
+ *********************************************/
+template <typename T, typename A>
+size_t blocking_queue <T, A> :: takeFront(list <T, A> & out, size_t max)
+{
+   size_t count = pending.size();
+   if (count <= max)
+   {
+      out.splice(out.end(), pending);
+      return count;
+   }
+
+   typename list <T, A> :: iterator last = pending.begin();
+   for (size_t i = 0; i < max; i++)
+      ++last;
+   out.splice(out.end(), pending, pending.begin(), last, max);
+   return max;
+}
+
+}; // namespace custom
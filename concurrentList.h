@@ -0,0 +1,726 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT LIST
+ * Summary:
+ *    A doubly linked list that many threads can modify at once.
+ *    Rather than one mutex around the whole list, every node carries
+ *    its own lock and threads walk the list hand-over-hand: a thread
+ *    always holds the lock of a node before it takes the lock of the
+ *    node that follows it. Two threads working on different parts of
+ *    the list therefore never wait on each other.
+ *
+ *    Locks are always acquired front-to-back. The one operation that
+ *    naturally wants the opposite order, push_back, takes the tail
+ *    sentinel and then only *tries* the node before it, backing off
+ *    and retrying if that fails. A new node is locked only once
+ *    nothing that will follow it is held. This keeps the lock order
+ *    acyclic, so the suite runs clean under ThreadSanitizer's deadlock
+ *    detector.
+ *
+ *    Threads that only want to look can use a hazard_iterator, which
+ *    takes no locks at all. It publishes the node it stands on as a
+ *    hazard pointer, and erase() defers freeing any node that a hazard
+ *    pointer can still reach. An erased node keeps its pNext, so a
+ *    reader standing on one simply carries on to whatever followed it.
+ *
+ *    This will contain the class definition of:
+ *        concurrent_list                  : A list safe for concurrent use
+ *        concurrent_list::iterator        : A locked cursor through the list
+ *        concurrent_list::hazard_iterator : A lock-free read-only cursor
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <atomic>      // for std::atomic
+#include <algorithm>   // for std::sort, std::lower_bound
+#include <mutex>       // for std::mutex, std::unique_lock
+#include <thread>      // for std::this_thread::yield
+#include <utility>     // for std::move
+#include <vector>      // for std::vector
+
+class TestConcurrentList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * CONCURRENT LIST
+ * A list supporting concurrent push_front, push_back,
+ * insert and erase through per-node locking.
+ *
+ * Iterators are locked cursors: an iterator holds the
+ * locks of its node and of the node before it, so the
+ * element it refers to cannot be erased or have a new
+ * neighbor slipped in front of it by another thread.
+ * Consequently iterators can be moved but not copied,
+ * and a thread should hold at most one iterator into a
+ * given list at a time. An iterator that reaches end()
+ * releases everything it holds.
+ *
+ * A hazard_iterator holds no locks and may be kept
+ * alongside anything else. It sees every element that
+ * stays in the list while it walks, may or may not
+ * see elements added or erased meanwhile, and reads
+ * elements without their lock, so do not assign
+ * through a locked iterator while anyone reads this way.
+ **************************************************/
+template <typename T>
+class concurrent_list
+{
+   friend class ::TestConcurrentList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   concurrent_list() : numElements(0), pHazards(nullptr), numReaders(0),
+                       reclaimAt(RECLAIM_MIN)
+   {
+      pHead = new Link();
+      pTail = new Link();
+      pHead->pNext = pTail;
+      pTail->pPrev = pHead;
+   }
+   concurrent_list(const concurrent_list & rhs) = delete;
+   concurrent_list & operator = (const concurrent_list & rhs) = delete;
+   ~concurrent_list();
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin();
+   iterator end() { return iterator(this); }
+   class hazard_iterator;
+   hazard_iterator hazard_begin() { return hazard_iterator(this); }
+
+   //
+   // Insert
+   //
+
+   void push_front(const T &  data) { linkFront(new Node(data));            }
+   void push_front(      T && data) { linkFront(new Node(std::move(data))); }
+   void push_back (const T &  data) { linkBack (new Node(data));            }
+   void push_back (      T && data) { linkBack (new Node(std::move(data))); }
+   iterator insert(iterator & it, const T &  data);
+   iterator insert(iterator & it,       T && data);
+
+   //
+   // Remove
+   //
+
+   bool pop_front(T & data);
+   iterator erase(iterator & it);
+   void collect();
+
+   //
+   // Traverse
+   //
+
+   template <class Function>
+   void for_each(Function f);
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return numElements.load() == 0; }
+   size_t size() const { return numElements.load();      }
+
+private:
+   // nested linked list classes
+   class Link;
+   class Node;
+   class Hazard;
+
+   iterator linkBack(Node * pNew);
+   void linkFront(Node * pNew);
+   iterator link(iterator & it, Node * pNew);
+   Hazard * acquireHazard();
+   void retire(Node * p);
+   void reclaim();
+
+   // retired nodes allowed to pile up before the first reclaim
+   static constexpr size_t RECLAIM_MIN = 64;
+
+   // member variables
+   std::atomic<size_t> numElements; // kept separately so size() needs no lock
+   Link * pHead;                    // sentinel before the first node
+   Link * pTail;                    // sentinel after the last node
+   std::atomic<Hazard *> pHazards;  // every hazard record ever made
+   std::atomic<size_t> numReaders;  // hazard iterators alive right now
+   std::mutex retireLock;           // guards retired and reclaimAt
+   std::vector<Node *> retired;     // erased but maybe still being read
+   size_t reclaimAt;                // size of retired that triggers a reclaim
+};
+
+/*************************************************
+ * LINK
+ * The part of a node that takes part in the
+ * structure of the list. The head and tail
+ * sentinels are bare links with no user data.
+ *************************************************/
+template <typename T>
+class concurrent_list <T> :: Link
+{
+public:
+   Link() : pNext(nullptr), pPrev(nullptr) {}
+
+   std::atomic<Link *> pNext; // pointer to next node, frozen once erased
+   Link * pPrev;              // pointer to previous node
+   std::mutex lock;           // guards pNext, pPrev, and the node's membership
+};
+
+/*************************************************
+ * NODE
+ * A link that carries user data
+ *************************************************/
+template <typename T>
+class concurrent_list <T> :: Node : public concurrent_list <T> :: Link
+{
+public:
+   Node(const T &  data) : data(data)            {}
+   Node(      T && data) : data(std::move(data)) {}
+
+   T data;             // user data
+};
+
+/*************************************************
+ * HAZARD
+ * One reader's pair of hazard pointers. While the
+ * reader moves from one node to the next both are
+ * published at once; version is odd during the
+ * move so a reclaimer never catches it half done.
+ * Records are recycled, never freed until the list is.
+ *************************************************/
+template <typename T>
+class concurrent_list <T> :: Hazard
+{
+public:
+   Hazard() : version(0), inUse(true), pNext(nullptr)
+   {
+      p[0].store(nullptr);
+      p[1].store(nullptr);
+   }
+
+   std::atomic<const Link *> p[2];  // nodes that must not be freed
+   std::atomic<unsigned> version;   // odd while p is changing
+   std::atomic<bool> inUse;         // owned by a hazard_iterator
+   Hazard * pNext;                  // next record, immutable once published
+};
+
+/*************************************************
+ * CONCURRENT LIST ITERATOR
+ * A cursor that owns the locks on the node it
+ * refers to (pCurr) and the one before it (pPrev)
+ ************************************************/
+template <typename T>
+class concurrent_list <T> :: iterator
+{
+   friend class ::TestConcurrentList; // give unit tests access to the privates
+   friend class custom::concurrent_list <T>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : pList(nullptr), pPrev(nullptr), pCurr(nullptr) {}
+   iterator(const iterator & rhs) = delete;
+   iterator(iterator && rhs) noexcept
+      : pList(rhs.pList), pPrev(rhs.pPrev), pCurr(rhs.pCurr),
+        lockPrev(std::move(rhs.lockPrev)), lockCurr(std::move(rhs.lockCurr))
+   {
+      rhs.pPrev = rhs.pCurr = nullptr;
+   }
+   iterator & operator = (const iterator & rhs) = delete;
+   iterator & operator = (iterator && rhs) noexcept
+   {
+      if (this != &rhs)
+      {
+         release();
+         pList    = rhs.pList;
+         pPrev    = rhs.pPrev;
+         pCurr    = rhs.pCurr;
+         lockPrev = std::move(rhs.lockPrev);
+         lockCurr = std::move(rhs.lockCurr);
+         rhs.pPrev = rhs.pCurr = nullptr;
+      }
+      return *this;
+   }
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return pCurr == rhs.pCurr; }
+   bool operator != (const iterator & rhs) const { return pCurr != rhs.pCurr; }
+
+   // dereference operator, fetch a node
+   T & operator * () { return static_cast <Node *> (pCurr)->data; }
+
+   // prefix increment: hand-over-hand to the next node
+   iterator & operator ++ ()
+   {
+      assert(pCurr != nullptr && pCurr != pList->pTail);
+      Link * pNext = pCurr->pNext;
+      std::unique_lock<std::mutex> lockNext(pNext->lock);
+      lockPrev = std::move(lockCurr);
+      lockCurr = std::move(lockNext);
+      pPrev = pCurr;
+      pCurr = pNext;
+      if (pCurr == pList->pTail)
+         release();
+      return *this;
+   }
+
+   // drop both locks, leaving the iterator at end()
+   void release()
+   {
+      if (lockCurr.owns_lock())
+         lockCurr.unlock();
+      if (lockPrev.owns_lock())
+         lockPrev.unlock();
+      if (pList)
+         pCurr = pList->pTail;
+      pPrev = nullptr;
+   }
+
+private:
+   // the end() iterator holds nothing
+   iterator(concurrent_list <T> * pList)
+      : pList(pList), pPrev(nullptr), pCurr(pList->pTail) {}
+
+   concurrent_list <T> * pList;           // the list we are walking
+   Link * pPrev;                          // the node before, locked
+   Link * pCurr;                          // the current node, locked
+   std::unique_lock<std::mutex> lockPrev; // ownership of pPrev->lock
+   std::unique_lock<std::mutex> lockCurr; // ownership of pCurr->lock
+};
+
+/*************************************************
+ * CONCURRENT LIST HAZARD ITERATOR
+ * A read-only cursor that holds no locks
+ ************************************************/
+template <typename T>
+class concurrent_list <T> :: hazard_iterator
+{
+   friend class ::TestConcurrentList; // give unit tests access to the privates
+   friend class custom::concurrent_list <T>;
+
+public:
+   hazard_iterator(const hazard_iterator & rhs) = delete;
+   hazard_iterator & operator = (const hazard_iterator & rhs) = delete;
+   ~hazard_iterator()
+   {
+      pHazard->p[0].store(nullptr);
+      pHazard->p[1].store(nullptr);
+      pHazard->inUse.store(false);
+      pList->numReaders--;
+   }
+
+   // compare against end()
+   bool operator == (const iterator & rhs) const { return pCurr == rhs.pCurr; }
+   bool operator != (const iterator & rhs) const { return pCurr != rhs.pCurr; }
+
+   // dereference operator, fetch a node
+   const T & operator * () const { return static_cast <const Node *> (pCurr)->data; }
+
+   // prefix increment: protect the next node before letting go of this one
+   hazard_iterator & operator ++ ()
+   {
+      assert(pCurr != pList->pTail);
+      pCurr = protect(pCurr->pNext);
+      return *this;
+   }
+
+private:
+   // the first node, protected
+   hazard_iterator(concurrent_list <T> * pList)
+   : pList(pList), iCurr(0), pCurr(nullptr)
+   {
+      pList->numReaders++;
+      pHazard = pList->acquireHazard();
+      pCurr = protect(pList->pHead->pNext);
+   }
+
+   // publish whatever src points to, then make sure src still points
+   // there; only then is it safe to drop the old hazard
+   const Link * protect(const std::atomic<Link *> & src)
+   {
+      const Link * p;
+      pHazard->version++;
+      do
+      {
+         p = src.load();
+         pHazard->p[1 - iCurr].store(p);
+      }
+      while (src.load() != p);
+      pHazard->p[iCurr].store(nullptr);
+      pHazard->version++;
+      iCurr = 1 - iCurr;
+      return p;
+   }
+
+   concurrent_list <T> * pList;   // the list we are walking
+   Hazard * pHazard;              // where we publish our hazards
+   int iCurr;                     // which of pHazard->p holds pCurr
+   const Link * pCurr;            // the current node, protected
+};
+
+/*****************************************
+ * CONCURRENT LIST :: DESTRUCTOR
+ * No other thread may be using the list
+ ****************************************/
+template <typename T>
+concurrent_list <T> :: ~concurrent_list()
+{
+   Link * p = pHead->pNext;
+   while (p != pTail)
+   {
+      Link * pDelete = p;
+      p = p->pNext;
+      delete static_cast <Node *> (pDelete);
+   }
+   delete pHead;
+   delete pTail;
+
+   for (Node * pDelete : retired)
+      delete pDelete;
+
+   Hazard * pHazard = pHazards.load();
+   while (pHazard)
+   {
+      Hazard * pDelete = pHazard;
+      pHazard = pHazard->pNext;
+      delete pDelete;
+   }
+}
+
+/*********************************************
+ * CONCURRENT LIST :: BEGIN
+ * Lock the head sentinel and the first node
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+typename concurrent_list <T> :: iterator concurrent_list <T> :: begin()
+{
+   iterator it(this);
+   it.lockPrev = std::unique_lock<std::mutex>(pHead->lock);
+   it.pPrev = pHead;
+   it.pCurr = pHead->pNext;
+   it.lockCurr = std::unique_lock<std::mutex>(it.pCurr->lock);
+   if (it.pCurr == pTail)
+      it.release();
+   return it;
+}
+
+/*********************************************
+ * CONCURRENT LIST :: LINK FRONT
+ * Add a node after the head sentinel
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+void concurrent_list <T> :: linkFront(Node * pNew)
+{
+   std::unique_lock<std::mutex> lockHead(pHead->lock);
+   Link * pFirst = pHead->pNext;
+   std::unique_lock<std::mutex> lockFirst(pFirst->lock);
+
+   pNew->pPrev = pHead;
+   pNew->pNext = pFirst;
+   pHead->pNext = pNew;
+   pFirst->pPrev = pNew;
+   numElements++;
+}
+
+/*********************************************
+ * CONCURRENT LIST :: LINK BACK
+ * Add a node before the tail sentinel. The
+ * returned iterator refers to the new node.
+ *    COST   : O(1) when uncontended
+ *********************************************/
+template <typename T>
+typename concurrent_list <T> :: iterator concurrent_list <T> :: linkBack(Node * pNew)
+{
+   // pNew will sit before pTail, so its lock comes first; nobody else
+   // can reach it yet, so holding it while we retry costs nothing
+   iterator it(this);
+   std::unique_lock<std::mutex> lockNew(pNew->lock);
+   for (;;)
+   {
+      std::unique_lock<std::mutex> lockTail(pTail->lock);
+      Link * pLast = pTail->pPrev;
+
+      // taking pLast after pTail is against the lock order, so only try
+      std::unique_lock<std::mutex> lockLast(pLast->lock, std::try_to_lock);
+      if (lockLast.owns_lock())
+      {
+         pNew->pPrev = pLast;
+         pNew->pNext = pTail;
+         pLast->pNext = pNew;
+         pTail->pPrev = pNew;
+         numElements++;
+
+         it.lockCurr = std::move(lockNew);
+         it.lockPrev = std::move(lockLast);
+         it.pPrev = pLast;
+         it.pCurr = pNew;
+         return it;
+      }
+
+      lockTail.unlock();
+      std::this_thread::yield();
+   }
+}
+
+/*********************************************
+ * CONCURRENT LIST :: LINK
+ * Put a node in front of the iterator. The
+ * iterator's locks move to the returned one.
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+typename concurrent_list <T> :: iterator
+   concurrent_list <T> :: link(iterator & it, Node * pNew)
+{
+   assert(it.pList == this);
+   if (it.pCurr == pTail)
+      return linkBack(pNew);
+
+   Link * pPrev = it.pPrev;
+   Link * pNext = it.pCurr;
+   pNew->pPrev = pPrev;
+   pNew->pNext = pNext;
+   pPrev->pNext = pNew;
+   pNext->pPrev = pNew;
+   numElements++;
+
+   // pNew comes before pNext in the lock order, so let go of pNext
+   // before taking pNew; pNew can only be reached through pPrev,
+   // which we keep
+   iterator itNew(this);
+   itNew.lockPrev = std::move(it.lockPrev);
+   it.release();
+   itNew.lockCurr = std::unique_lock<std::mutex>(pNew->lock);
+   itNew.pPrev = pPrev;
+   itNew.pCurr = pNew;
+   return itNew;
+}
+
+/******************************************
+ * CONCURRENT LIST :: INSERT
+ * add an item before the iterator
+ *     INPUT  : a locked iterator, consumed by the call
+ *              data to be added to the list
+ *     OUTPUT : locked iterator to the new item
+ *     COST   : O(1)
+ ******************************************/
+template <typename T>
+typename concurrent_list <T> :: iterator
+   concurrent_list <T> :: insert(iterator & it, const T & data)
+{
+   return link(it, new Node(data));
+}
+
+template <typename T>
+typename concurrent_list <T> :: iterator
+   concurrent_list <T> :: insert(iterator & it, T && data)
+{
+   return link(it, new Node(std::move(data)));
+}
+
+/******************************************
+ * CONCURRENT LIST :: ERASE
+ * remove the item the iterator refers to
+ *     INPUT  : a locked iterator, consumed by the call
+ *     OUTPUT : locked iterator to the following item
+ *     COST   : O(1)
+ ******************************************/
+template <typename T>
+typename concurrent_list <T> :: iterator
+   concurrent_list <T> :: erase(iterator & it)
+{
+   assert(it.pList == this);
+   if (it.pCurr == pTail)
+      return end();
+
+   Node * pDelete = static_cast <Node *> (it.pCurr);
+   Link * pNext = pDelete->pNext;
+   std::unique_lock<std::mutex> lockNext(pNext->lock);
+
+   it.pPrev->pNext = pNext;
+   pNext->pPrev = it.pPrev;
+   numElements--;
+
+   iterator itNext(this);
+   itNext.lockPrev = std::move(it.lockPrev);
+   itNext.lockCurr = std::move(lockNext);
+   itNext.pPrev = it.pPrev;
+   itNext.pCurr = pNext;
+
+   // every path to pDelete runs through a lock we hold, so nobody waits on
+   // it, but a hazard_iterator may still be reading it
+   it.lockCurr.unlock();
+   it.release();
+   retire(pDelete);
+
+   if (itNext.pCurr == pTail)
+      itNext.release();
+   return itNext;
+}
+
+/*********************************************
+ * CONCURRENT LIST :: POP FRONT
+ * remove an item from the front of the list
+ *    INPUT  : where to put the removed item
+ *    OUTPUT : false if the list was empty
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+bool concurrent_list <T> :: pop_front(T & data)
+{
+   iterator it = begin();
+   if (it == end())
+      return false;
+   data = *it; // copied, not moved: a hazard_iterator may be reading it
+   erase(it);
+   return true;
+}
+
+/*********************************************
+ * CONCURRENT LIST :: FOR EACH
+ * Visit every element while holding its lock
+ *    INPUT  : function taking a T &
+ *    COST   : O(n)
+ *********************************************/
+template <typename T>
+template <class Function>
+void concurrent_list <T> :: for_each(Function f)
+{
+   for (iterator it = begin(); it != end(); ++it)
+      f(*it);
+}
+
+/*********************************************
+ * CONCURRENT LIST :: ACQUIRE HAZARD
+ * Reuse a record a finished reader left behind
+ * or publish a new one
+ *    COST   : O(number of records)
+ *********************************************/
+template <typename T>
+typename concurrent_list <T> :: Hazard * concurrent_list <T> :: acquireHazard()
+{
+   for (Hazard * p = pHazards.load(); p; p = p->pNext)
+   {
+      bool expected = false;
+      if (p->inUse.compare_exchange_strong(expected, true))
+         return p;
+   }
+
+   Hazard * pNew = new Hazard();
+   pNew->pNext = pHazards.load();
+   while (!pHazards.compare_exchange_weak(pNew->pNext, pNew))
+      ;
+   return pNew;
+}
+
+/*********************************************
+ * CONCURRENT LIST :: RETIRE
+ * Free an unlinked node, or hold on to it if a
+ * hazard_iterator might still reach it. A reclaim
+ * waits until the retired nodes number twice what
+ * the last one kept, so nodes a slow reader pins
+ * are not re-examined on every erase.
+ *    COST   : O(log r) amortized
+ *********************************************/
+template <typename T>
+void concurrent_list <T> :: retire(Node * p)
+{
+   // with no readers, nobody can reach a node that is no longer linked
+   if (numReaders.load() == 0)
+   {
+      delete p;
+      return;
+   }
+
+   std::lock_guard<std::mutex> guard(retireLock);
+   retired.push_back(p);
+   if (retired.size() >= reclaimAt)
+      reclaim();
+}
+
+/*********************************************
+ * CONCURRENT LIST :: COLLECT
+ * Free every erased node no reader can reach now
+ *    COST   : O(r log r + number of records)
+ *********************************************/
+template <typename T>
+void concurrent_list <T> :: collect()
+{
+   std::lock_guard<std::mutex> guard(retireLock);
+   reclaim();
+}
+
+/*********************************************
+ * CONCURRENT LIST :: RECLAIM
+ * A retired node must be kept if a hazard points
+ * at it, or if it follows a kept retired node:
+ * a reader standing on an erased node will step
+ * to that node's frozen pNext. Only retired nodes
+ * are ever dereferenced here; hazard values are
+ * just compared. The caller holds retireLock.
+ *    COST   : O(r log r + number of records)
+ *********************************************/
+template <typename T>
+void concurrent_list <T> :: reclaim()
+{
+   if (retired.empty())
+      return;
+
+   // take a consistent snapshot of every reader's hazards
+   std::vector<const Link *> hazards;
+   for (Hazard * h = pHazards.load(); h; h = h->pNext)
+      for (;;)
+      {
+         unsigned version = h->version.load();
+         if (version % 2)
+         {
+            std::this_thread::yield();
+            continue;
+         }
+         const Link * p0 = h->p[0].load();
+         const Link * p1 = h->p[1].load();
+         if (h->version.load() != version)
+            continue;
+         if (p0)
+            hazards.push_back(p0);
+         if (p1)
+            hazards.push_back(p1);
+         break;
+      }
+
+   // mark everything reachable from a hazard through retired nodes
+   std::sort(retired.begin(), retired.end());
+   std::vector<bool> keep(retired.size(), false);
+   auto find = [this](const Link * p) -> size_t
+   {
+      typename std::vector<Node *>::iterator it =
+         std::lower_bound(retired.begin(), retired.end(), p,
+                          [](Node * lhs, const Link * rhs) { return lhs < rhs; });
+      return (it != retired.end() && *it == p) ? it - retired.begin() : retired.size();
+   };
+   for (const Link * p : hazards)
+      for (size_t i = find(p); i < retired.size() && !keep[i];
+           i = find(retired[i]->pNext.load()))
+         keep[i] = true;
+
+   size_t kept = 0;
+   for (size_t i = 0; i < retired.size(); i++)
+      if (keep[i])
+         retired[kept++] = retired[i];
+      else
+         delete retired[i];
+   retired.resize(kept);
+   reclaimAt = std::max(RECLAIM_MIN, 2 * kept);
+}
+
+}; // namespace custom
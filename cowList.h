@@ -0,0 +1,206 @@
+/***********************************************************************
+ * Header:
+ *    COW LIST
+ * Summary:
+ *    A copy-on-write wrapper around custom::list for handing out
+ *    read-only snapshots. Copies share one list through a reference
+ *    count, so taking a snapshot is O(1) no matter how long the list
+ *    is. The first mutation through a copy that is still shared clones
+ *    the list, and only that copy sees the change.
+ *
+ *    Each cow_list object belongs to one thread at a time, like any
+ *    other value, and only that thread writes through it. Different
+ *    threads may freely read, copy, and drop their own snapshots of the
+ *    same list; the shared list is never written while more than one
+ *    snapshot refers to it.
+ *
+ *    This will contain the class definition of:
+ *        cow_list                 : A list with O(1) copies
+ *        cow_list::const_iterator : A read-only walk through a snapshot
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <atomic>      // for std::atomic_thread_fence
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <memory>      // for std::shared_ptr
+#include <utility>     // for std::move
+#include "list.h"      // for custom::list
+
+class TestCowList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * COW LIST
+ * Reads never copy; writes copy at most once per
+ * snapshot. An empty cow_list owns nothing at all.
+ **************************************************/
+template <typename T, typename A = std::allocator<T>>
+class cow_list
+{
+   friend class ::TestCowList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   cow_list() {}
+   cow_list(const std::initializer_list<T> & il)
+   : pList(il.size() ? std::make_shared<list <T, A>>(il) : nullptr) {}
+   cow_list(list <T, A> && rhs)
+   : pList(rhs.empty() ? nullptr : std::make_shared<list <T, A>>(std::move(rhs))) {}
+   cow_list(const cow_list & rhs) = default;
+   cow_list(cow_list && rhs) = default;
+   cow_list & operator = (const cow_list & rhs) = default;
+   cow_list & operator = (cow_list && rhs) = default;
+
+   //
+   // Iterator
+   //
+
+   class const_iterator;
+   const_iterator begin()  const;
+   const_iterator end()    const { return const_iterator(); }
+   const_iterator cbegin() const { return begin(); }
+   const_iterator cend()   const { return end();   }
+
+   //
+   // Access
+   //
+
+   const T & front() const { assert(!empty()); return pList->front(); }
+   const T & back()  const { assert(!empty()); return pList->back();  }
+   template <class Function>
+   void for_each(Function f) const;
+
+   //
+   // Insert
+   //
+
+   void push_front(const T &  data) { write().push_front(data);            }
+   void push_front(      T && data) { write().push_front(std::move(data)); }
+   void push_back (const T &  data) { write().push_back(data);             }
+   void push_back (      T && data) { write().push_back(std::move(data));  }
+
+   //
+   // Remove
+   //
+
+   void pop_front() { if (!empty()) write().pop_front(); }
+   void pop_back()  { if (!empty()) write().pop_back();  }
+   void clear()     { pList.reset(); }
+
+   //
+   // Mutate
+   //
+
+   list <T, A> & write();
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return !pList || pList->empty(); }
+   size_t size() const { return pList ? pList->size() : 0; }
+   bool shared() const { return pList && pList.use_count() > 1; }
+
+private:
+   // member variables
+   std::shared_ptr<list <T, A>> pList; // the shared list, null when empty
+};
+
+/*************************************************
+ * COW LIST CONST ITERATOR
+ * A list const_iterator over the shared snapshot
+ ************************************************/
+template <typename T, typename A>
+class cow_list <T, A> :: const_iterator
+{
+   friend class ::TestCowList; // give unit tests access to the privates
+   friend class custom::cow_list <T, A>;
+
+public:
+   // constructors, destructors, and assignment operator
+   const_iterator() {}
+
+   // equals, not equals operator
+   bool operator == (const const_iterator & rhs) const { return it == rhs.it; }
+   bool operator != (const const_iterator & rhs) const { return it != rhs.it; }
+
+   // dereference operator, fetch a node
+   const T & operator * () const { return *it; }
+
+   // prefix increment
+   const_iterator & operator ++ () { ++it; return *this; }
+
+   // postfix increment
+   const_iterator operator ++ (int) { const_iterator tmp = *this; ++it; return tmp; }
+
+private:
+   const_iterator(typename list <T, A> :: const_iterator it) : it(it) {}
+
+   typename list <T, A> :: const_iterator it; // where we are in the shared list
+};
+
+/*********************************************
+ * COW LIST :: BEGIN
+ * The first element of the snapshot
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+typename cow_list <T, A> :: const_iterator cow_list <T, A> :: begin() const
+{
+   return pList ? const_iterator(pList->cbegin()) : const_iterator();
+}
+
+/*********************************************
+ * COW LIST :: FOR EACH
+ * Visit every element in order
+ *    INPUT  : function taking a const T &
+ *    COST   : O(n)
+ *********************************************/
+template <typename T, typename A>
+template <class Function>
+void cow_list <T, A> :: for_each(Function f) const
+{
+   if (pList)
+      for (typename list <T, A> :: const_iterator it = pList->cbegin();
+           it != pList->cend(); ++it)
+         f(*it);
+}
+
+/*********************************************
+ * COW LIST :: WRITE
+ * Make sure this snapshot owns its list alone,
+ * cloning it if anybody else can still see it,
+ * and hand it out for modification. Iterators
+ * taken before a write may point into the old
+ * list. A cow_list has a single writer: only the
+ * thread that owns this object may call write(),
+ * though other snapshots may be read or dropped on
+ * other threads meanwhile.
+ *    OUTPUT : the list, ours alone
+ *    COST   : O(n) the first time on a shared list,
+ *             otherwise O(1)
+ *********************************************/
+template <typename T, typename A>
+list <T, A> & cow_list <T, A> :: write()
+{
+   if (!pList)
+      pList = std::make_shared<list <T, A>>();
+   else if (pList.use_count() > 1)
+      pList = std::make_shared<list <T, A>>(*pList);
+   else
+      // use_count() is only a relaxed load. When it reads 1, this fence
+      // pairs with the release in the last other snapshot's decrement,
+      // so that thread's reads of the list happen before our writes.
+      std::atomic_thread_fence(std::memory_order_acquire);
+   return *pList;
+}
+
+}; // namespace custom
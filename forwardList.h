@@ -0,0 +1,348 @@
+/***********************************************************************
+ * Header:
+ *    FORWARD LIST
+ * Summary:
+ *    A singly linked list for queues that are only ever appended at
+ *    the back and consumed from the front. Each node carries just
+ *    pNext, one pointer less than a custom::list node: for an int or
+ *    a pointer that is 16 bytes a node instead of 24. A tail pointer
+ *    keeps push_back O(1).
+ *
+ *    Without pPrev nothing can be removed from the back, and removal
+ *    in the middle names the node in front: erase_after, insert_after.
+ *
+ *    This will contain the class definition of:
+ *        forward_list           : A singly linked list with a tail
+ *        forward_list::iterator : A forward-only walk through it
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>          // for ASSERT
+#include <cstddef>          // for size_t
+#include <initializer_list> // for std::initializer_list
+#include <memory>           // for std::allocator
+#include <utility>          // for std::move
+
+class TestForwardList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * FORWARD LIST
+ * A queue-shaped list: push at either end, pop
+ * from the front
+ **************************************************/
+template <typename T, typename A = std::allocator<T>>
+class forward_list
+{
+   friend class ::TestForwardList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   forward_list(const A & a = A())
+   : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr) {}
+   forward_list(const std::initializer_list<T> & il, const A & a = A());
+   forward_list(const forward_list & rhs);
+   forward_list(forward_list && rhs)
+   : alloc(rhs.alloc), numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
+   {
+      rhs.numElements = 0;
+      rhs.pHead = rhs.pTail = nullptr;
+   }
+   ~forward_list() { clear(); }
+
+   //
+   // Assign
+   //
+
+   forward_list & operator = (forward_list rhs) { swap(rhs); return *this; }
+   void swap(forward_list & rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() { return iterator(pHead);   }
+   iterator end()   { return iterator(nullptr); }
+
+   //
+   // Access
+   //
+
+   T & front() { assert(pHead); return pHead->data; }
+   T & back()  { assert(pTail); return pTail->data; }
+
+   //
+   // Insert
+   //
+
+   void push_front(const T &  data) { linkFront(new Node(data));            }
+   void push_front(      T && data) { linkFront(new Node(std::move(data))); }
+   void push_back (const T &  data) { linkBack(new Node(data));             }
+   void push_back (      T && data) { linkBack(new Node(std::move(data)));  }
+   iterator insert_after(iterator it, const T &  data);
+   iterator insert_after(iterator it,       T && data);
+
+   //
+   // Remove
+   //
+
+   void pop_front();
+   iterator erase_after(iterator it);
+   void clear();
+
+   //
+   // Splice
+   //
+
+   void splice_back(forward_list & rhs);
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return pHead == nullptr; }
+   size_t size() const { return numElements;      }
+
+private:
+   // nested linked list class
+   class Node;
+
+   void linkFront(Node * pNew);
+   void linkBack(Node * pNew);
+   iterator linkAfter(iterator it, Node * pNew);
+
+   // member variables
+   A    alloc;         // use allocator for memory allocation
+   size_t numElements; // though we could count, it is faster to keep a variable
+   Node * pHead;       // pointer to the beginning of the list
+   Node * pTail;       // pointer to the ending of the list
+};
+
+/*************************************************
+ * NODE
+ * One link only
+ *************************************************/
+template <typename T, typename A>
+class forward_list <T, A> :: Node
+{
+public:
+   Node(const T &  data) : pNext(nullptr), data(data) {}
+   Node(      T && data) : pNext(nullptr), data(std::move(data)) {}
+
+   Node * pNext;       // pointer to next node
+   T data;             // user data
+};
+
+/*************************************************
+ * FORWARD LIST ITERATOR
+ * Iterate front to back
+ ************************************************/
+template <typename T, typename A>
+class forward_list <T, A> :: iterator
+{
+   friend class ::TestForwardList; // give unit tests access to the privates
+   friend class custom::forward_list <T, A>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator, fetch a node
+   T & operator * () { return p->data; }
+
+   // prefix increment
+   iterator & operator ++ () { p = p->pNext; return *this; }
+
+   // postfix increment
+   iterator operator ++ (int) { iterator tmp = *this; p = p->pNext; return tmp; }
+
+private:
+   iterator(Node * p) : p(p) {}
+
+   Node * p;   // the current node
+};
+
+/*****************************************
+ * FORWARD LIST :: CONSTRUCTORS
+ ****************************************/
+template <typename T, typename A>
+forward_list <T, A> :: forward_list(const std::initializer_list<T> & il, const A & a)
+: alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+{
+   for (const T & item : il)
+      push_back(item);
+}
+
+template <typename T, typename A>
+forward_list <T, A> :: forward_list(const forward_list & rhs)
+: alloc(rhs.alloc), numElements(0), pHead(nullptr), pTail(nullptr)
+{
+   for (Node * p = rhs.pHead; p; p = p->pNext)
+      push_back(p->data);
+}
+
+/*****************************************
+ * FORWARD LIST :: SWAP
+ *    COST   : O(1)
+ ****************************************/
+template <typename T, typename A>
+void forward_list <T, A> :: swap(forward_list & rhs)
+{
+   std::swap(alloc, rhs.alloc);
+   std::swap(numElements, rhs.numElements);
+   std::swap(pHead, rhs.pHead);
+   std::swap(pTail, rhs.pTail);
+}
+
+/*********************************************
+ * FORWARD LIST :: LINK FRONT / LINK BACK
+ * Hang a new node off either end
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+void forward_list <T, A> :: linkFront(Node * pNew)
+{
+   pNew->pNext = pHead;
+   pHead = pNew;
+   if (pTail == nullptr)
+      pTail = pNew;
+   numElements++;
+}
+
+template <typename T, typename A>
+void forward_list <T, A> :: linkBack(Node * pNew)
+{
+   if (pTail)
+      pTail->pNext = pNew;
+   else
+      pHead = pNew;
+   pTail = pNew;
+   numElements++;
+}
+
+/*********************************************
+ * FORWARD LIST :: INSERT AFTER
+ * Put data just behind it
+ *    INPUT  : an element of this list
+ *    OUTPUT : the new element
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+typename forward_list <T, A> :: iterator
+forward_list <T, A> :: insert_after(iterator it, const T & data)
+{
+   return linkAfter(it, new Node(data));
+}
+
+template <typename T, typename A>
+typename forward_list <T, A> :: iterator
+forward_list <T, A> :: insert_after(iterator it, T && data)
+{
+   return linkAfter(it, new Node(std::move(data)));
+}
+
+template <typename T, typename A>
+typename forward_list <T, A> :: iterator
+forward_list <T, A> :: linkAfter(iterator it, Node * pNew)
+{
+   assert(it.p);
+   pNew->pNext = it.p->pNext;
+   it.p->pNext = pNew;
+   if (pTail == it.p)
+      pTail = pNew;
+   numElements++;
+   return iterator(pNew);
+}
+
+/*********************************************
+ * FORWARD LIST :: POP FRONT
+ * Remove the first element, if any
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+void forward_list <T, A> :: pop_front()
+{
+   if (pHead == nullptr)
+      return;
+   Node * pDelete = pHead;
+   pHead = pHead->pNext;
+   if (pHead == nullptr)
+      pTail = nullptr;
+   delete pDelete;
+   numElements--;
+}
+
+/*********************************************
+ * FORWARD LIST :: ERASE AFTER
+ * Remove the element just behind it
+ *    INPUT  : an element of this list
+ *    OUTPUT : the element that now follows it
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+typename forward_list <T, A> :: iterator
+forward_list <T, A> :: erase_after(iterator it)
+{
+   assert(it.p);
+   Node * pDelete = it.p->pNext;
+   if (pDelete == nullptr)
+      return end();
+
+   it.p->pNext = pDelete->pNext;
+   if (pTail == pDelete)
+      pTail = it.p;
+   delete pDelete;
+   numElements--;
+   return iterator(it.p->pNext);
+}
+
+/*********************************************
+ * FORWARD LIST :: CLEAR
+ *    COST   : O(n)
+ *********************************************/
+template <typename T, typename A>
+void forward_list <T, A> :: clear()
+{
+   while (pHead)
+   {
+      Node * pDelete = pHead;
+      pHead = pHead->pNext;
+      delete pDelete;
+   }
+   pTail = nullptr;
+   numElements = 0;
+}
+
+/*********************************************
+ * FORWARD LIST :: SPLICE BACK
+ * Move every node of rhs onto the end of this
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+void forward_list <T, A> :: splice_back(forward_list & rhs)
+{
+   if (&rhs == this || rhs.empty())
+      return;
+   if (pTail)
+      pTail->pNext = rhs.pHead;
+   else
+      pHead = rhs.pHead;
+   pTail = rhs.pTail;
+   numElements += rhs.numElements;
+   rhs.pHead = rhs.pTail = nullptr;
+   rhs.numElements = 0;
+}
+
+}; // namespace custom
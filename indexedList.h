@@ -0,0 +1,628 @@
+/***********************************************************************
+ * Header:
+ *    INDEXED LIST
+ * Summary:
+ *    A doubly linked list with an indexable skip list laid over its
+ *    nodes, so "the i-th element" and "the position of this node" take
+ *    O(log n) expected time instead of a walk.
+ *
+ *    Every node gets a random height. At each level it points forward
+ *    to the next node at least as tall and remembers how many positions
+ *    that jump covers. For each level the list also keeps the first and
+ *    last node and their positions. Those positions are stored relative
+ *    to a shift counter, so push_front can move every position up by
+ *    one by bumping the counter. With that, push_front and push_back
+ *    only touch the levels of the new node: expected O(1).
+ *
+ *    This will contain the class definition of:
+ *        indexed_list           : A list with O(log n) positional access
+ *        indexed_list::iterator : An iterator through the list
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t
+#include <utility>     // for std::move, std::swap
+
+class TestIndexedList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * INDEXED LIST
+ * Like custom::list, plus at, index_of, insert_at,
+ * and iterator_at in O(log n) expected time
+ **************************************************/
+template <typename T>
+class indexed_list
+{
+   friend class ::TestIndexedList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   indexed_list();
+   indexed_list(const indexed_list & rhs);
+   indexed_list(indexed_list && rhs);
+   ~indexed_list() { clear(); }
+
+   //
+   // Assign
+   //
+
+   indexed_list & operator = (indexed_list rhs) { swap(rhs); return *this; }
+   void swap(indexed_list & rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() { return iterator(first[0]); }
+   iterator end()   { return iterator(nullptr);  }
+   iterator iterator_at(size_t i) { return iterator(nodeAt(i)); }
+
+   //
+   // Access
+   //
+
+   T & front() { assert(numElements); return first[0]->data; }
+   T & back()  { assert(numElements); return tail[0]->data;  }
+   T & at(size_t i)          { return nodeAt(i)->data; }
+   T & operator [] (size_t i) { return nodeAt(i)->data; }
+   size_t index_of(const iterator & it) const;
+
+   //
+   // Insert
+   //
+
+   void push_front(const T &  data) { linkFront(new Node(data, randomHeight()));            }
+   void push_front(      T && data) { linkFront(new Node(std::move(data), randomHeight())); }
+   void push_back (const T &  data) { linkBack(new Node(data, randomHeight()));             }
+   void push_back (      T && data) { linkBack(new Node(std::move(data), randomHeight()));  }
+   iterator insert_at(size_t i, const T &  data);
+   iterator insert_at(size_t i,       T && data);
+
+   //
+   // Remove
+   //
+
+   iterator erase(const iterator & it);
+   void pop_front() { if (numElements) erase(begin());          }
+   void pop_back()  { if (numElements) erase(iterator(tail[0])); }
+   void clear();
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return numElements == 0; }
+   size_t size() const { return numElements;      }
+
+private:
+   // nested linked list classes
+   enum { MAX_LEVELS = 16 };   // a quarter of the nodes reach each next level
+   struct Skip;
+   class Node;
+
+   unsigned randomHeight();
+   void linkFront(Node * pNew);
+   void linkBack(Node * pNew);
+   iterator link(size_t i, Node * pNew);
+   Node * nodeAt(size_t i) const;
+   void findPreds(size_t i, Node ** preds, size_t * predPos) const;
+
+   // positions are kept relative to shift so push_front is O(1)
+   size_t real(size_t stored) const { return stored + shift; }
+   size_t stored(size_t real) const { return real - shift;   }
+
+   // member variables
+   size_t numElements;             // number of nodes
+   unsigned numLevels;             // no level at or above this has nodes
+   size_t shift;                   // added to every stored position
+   uint32_t seed;                  // state of the height generator
+   Node * first[MAX_LEVELS];       // first node at each level
+   Node * tail[MAX_LEVELS];        // last node at each level
+   size_t firstPos[MAX_LEVELS];    // stored position of first[L]
+   size_t tailPos[MAX_LEVELS];     // stored position of tail[L]
+};
+
+/*************************************************
+ * SKIP
+ * One forward jump: the next node at this level and
+ * how many positions ahead of us it is
+ *************************************************/
+template <typename T>
+struct indexed_list <T> :: Skip
+{
+   Node * pNext;   // next node at this level, nullptr at the tail
+   size_t width;   // its position minus ours
+};
+
+/*************************************************
+ * NODE
+ * skips[0] is the plain next pointer (width 1);
+ * higher levels exist up to height
+ *************************************************/
+template <typename T>
+class indexed_list <T> :: Node
+{
+public:
+   Node(const T & data, unsigned height)
+   : pPrev(nullptr), skips(new Skip[height]()), height(height), data(data) {}
+   Node(T && data, unsigned height)
+   : pPrev(nullptr), skips(new Skip[height]()), height(height), data(std::move(data)) {}
+   Node(const Node & rhs) = delete;
+   Node & operator = (const Node & rhs) = delete;
+   ~Node() { delete [] skips; }
+
+   Node * pPrev;       // pointer to previous node
+   Skip * skips;       // forward jumps, one per level
+   unsigned height;    // how many levels this node is on
+   T data;             // user data
+};
+
+/*************************************************
+ * INDEXED LIST ITERATOR
+ * Walks level 0, exactly like list::iterator
+ ************************************************/
+template <typename T>
+class indexed_list <T> :: iterator
+{
+   friend class ::TestIndexedList; // give unit tests access to the privates
+   friend class custom::indexed_list <T>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr) {}
+   iterator(Node * p) : p(p) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator, fetch a node
+   T & operator * () { return p->data; }
+
+   // prefix increment and decrement
+   iterator & operator ++ () { p = p->skips[0].pNext; return *this; }
+   iterator & operator -- () { p = p->pPrev;          return *this; }
+
+   // postfix increment and decrement
+   iterator operator ++ (int) { iterator tmp = *this; ++(*this); return tmp; }
+   iterator operator -- (int) { iterator tmp = *this; --(*this); return tmp; }
+
+private:
+   Node * p;   // the current node
+};
+
+/*****************************************
+ * INDEXED LIST :: CONSTRUCTORS
+ ****************************************/
+template <typename T>
+indexed_list <T> :: indexed_list()
+: numElements(0), numLevels(0), shift(0), seed(2463534242u)
+{
+   for (unsigned L = 0; L < MAX_LEVELS; L++)
+   {
+      first[L] = tail[L] = nullptr;
+      firstPos[L] = tailPos[L] = 0;
+   }
+}
+
+template <typename T>
+indexed_list <T> :: indexed_list(const indexed_list & rhs) : indexed_list()
+{
+   for (Node * p = rhs.first[0]; p; p = p->skips[0].pNext)
+      push_back(p->data);
+}
+
+template <typename T>
+indexed_list <T> :: indexed_list(indexed_list && rhs) : indexed_list()
+{
+   swap(rhs);
+}
+
+/*****************************************
+ * INDEXED LIST :: SWAP
+ *    COST   : O(MAX_LEVELS)
+ ****************************************/
+template <typename T>
+void indexed_list <T> :: swap(indexed_list & rhs)
+{
+   std::swap(numElements, rhs.numElements);
+   std::swap(numLevels, rhs.numLevels);
+   std::swap(shift, rhs.shift);
+   std::swap(seed, rhs.seed);
+   for (unsigned L = 0; L < MAX_LEVELS; L++)
+   {
+      std::swap(first[L], rhs.first[L]);
+      std::swap(tail[L], rhs.tail[L]);
+      std::swap(firstPos[L], rhs.firstPos[L]);
+      std::swap(tailPos[L], rhs.tailPos[L]);
+   }
+}
+
+/*********************************************
+ * INDEXED LIST :: RANDOM HEIGHT
+ * 1 with probability 3/4, 2 with 3/16, and so on
+ *    COST   : O(1) expected
+ *********************************************/
+template <typename T>
+unsigned indexed_list <T> :: randomHeight()
+{
+   // xorshift32
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+
+   unsigned height = 1;
+   for (uint32_t bits = seed; (bits & 3) == 0 && height < MAX_LEVELS; bits >>= 2)
+      height++;
+   return height;
+}
+
+/*********************************************
+ * INDEXED LIST :: INDEX OF
+ * Walk forward, always on the highest level the
+ * current node reaches, until we hit the tail of
+ * a level. Its position is known, so ours is that
+ * minus the distance covered.
+ *    COST   : O(log n) expected
+ *********************************************/
+template <typename T>
+size_t indexed_list <T> :: index_of(const iterator & it) const
+{
+   assert(it.p);
+   size_t distance = 0;
+   Node * p = it.p;
+   for (;;)
+   {
+      unsigned L = p->height - 1;
+      if (p->skips[L].pNext == nullptr)
+         return real(tailPos[L]) - distance;
+      distance += p->skips[L].width;
+      p = p->skips[L].pNext;
+   }
+}
+
+/*********************************************
+ * INDEXED LIST :: INSERT AT
+ * Put data so that it ends up at index i
+ *    INPUT  : the index, 0 through size()
+ *    OUTPUT : an iterator to the new element
+ *    COST   : O(1) expected at either end,
+ *             otherwise O(log n) expected
+ *********************************************/
+template <typename T>
+typename indexed_list <T> :: iterator
+indexed_list <T> :: insert_at(size_t i, const T & data)
+{
+   return link(i, new Node(data, randomHeight()));
+}
+
+template <typename T>
+typename indexed_list <T> :: iterator
+indexed_list <T> :: insert_at(size_t i, T && data)
+{
+   return link(i, new Node(std::move(data), randomHeight()));
+}
+
+/*********************************************
+ * INDEXED LIST :: LINK FRONT
+ * Everything moves up one position, which the
+ * shift takes care of. Only the new node's own
+ * levels need relinking.
+ *    COST   : O(height of the new node)
+ *********************************************/
+template <typename T>
+void indexed_list <T> :: linkFront(Node * pNew)
+{
+   shift++;
+   for (unsigned L = 0; L < pNew->height; L++)
+   {
+      if (first[L])
+      {
+         pNew->skips[L].pNext = first[L];
+         pNew->skips[L].width = real(firstPos[L]);
+      }
+      else
+      {
+         tail[L] = pNew;
+         tailPos[L] = stored(0);
+      }
+      first[L] = pNew;
+      firstPos[L] = stored(0);
+   }
+
+   if (pNew->skips[0].pNext)
+      pNew->skips[0].pNext->pPrev = pNew;
+   if (numLevels < pNew->height)
+      numLevels = pNew->height;
+   numElements++;
+}
+
+/*********************************************
+ * INDEXED LIST :: LINK BACK
+ * Hang the new node off the tail of each of its
+ * levels. Taller levels end before it and do not
+ * change.
+ *    COST   : O(height of the new node)
+ *********************************************/
+template <typename T>
+void indexed_list <T> :: linkBack(Node * pNew)
+{
+   size_t pos = numElements;
+   pNew->pPrev = tail[0];
+   for (unsigned L = 0; L < pNew->height; L++)
+   {
+      if (tail[L])
+      {
+         tail[L]->skips[L].pNext = pNew;
+         tail[L]->skips[L].width = pos - real(tailPos[L]);
+      }
+      else
+      {
+         first[L] = pNew;
+         firstPos[L] = stored(pos);
+      }
+      tail[L] = pNew;
+      tailPos[L] = stored(pos);
+   }
+
+   if (numLevels < pNew->height)
+      numLevels = pNew->height;
+   numElements++;
+}
+
+/*********************************************
+ * INDEXED LIST :: LINK
+ * Put pNew at index i
+ *    COST   : O(log n) expected
+ *********************************************/
+template <typename T>
+typename indexed_list <T> :: iterator
+indexed_list <T> :: link(size_t i, Node * pNew)
+{
+   assert(i <= numElements);
+   if (i == 0)
+   {
+      linkFront(pNew);
+      return iterator(pNew);
+   }
+   if (i == numElements)
+   {
+      linkBack(pNew);
+      return iterator(pNew);
+   }
+
+   Node * preds[MAX_LEVELS];
+   size_t predPos[MAX_LEVELS];
+   findPreds(i, preds, predPos);
+
+   // everything at or after i moves up one
+   for (unsigned L = 0; L < numLevels; L++)
+   {
+      if (first[L] && real(firstPos[L]) >= i)
+         firstPos[L]++;
+      if (tail[L] && real(tailPos[L]) >= i)
+         tailPos[L]++;
+   }
+
+   unsigned levels = numLevels > pNew->height ? numLevels : pNew->height;
+   for (unsigned L = 0; L < levels; L++)
+   {
+      Node * pPred = (L < numLevels) ? preds[L] : nullptr;
+      if (L >= pNew->height)
+      {
+         // a jump over i just got one longer
+         if (pPred && pPred->skips[L].pNext)
+            pPred->skips[L].width++;
+      }
+      else if (pPred)
+      {
+         Node * pNext = pPred->skips[L].pNext;
+         if (pNext)
+         {
+            pNew->skips[L].pNext = pNext;
+            pNew->skips[L].width = predPos[L] + pPred->skips[L].width + 1 - i;
+         }
+         else
+         {
+            tail[L] = pNew;
+            tailPos[L] = stored(i);
+         }
+         pPred->skips[L].pNext = pNew;
+         pPred->skips[L].width = i - predPos[L];
+      }
+      else
+      {
+         if (first[L])
+         {
+            pNew->skips[L].pNext = first[L];
+            pNew->skips[L].width = real(firstPos[L]) - i;
+         }
+         else
+         {
+            tail[L] = pNew;
+            tailPos[L] = stored(i);
+         }
+         first[L] = pNew;
+         firstPos[L] = stored(i);
+      }
+   }
+
+   pNew->pPrev = preds[0];
+   pNew->skips[0].pNext->pPrev = pNew;
+   numLevels = levels;
+   numElements++;
+   return iterator(pNew);
+}
+
+/*********************************************
+ * INDEXED LIST :: ERASE
+ * Unlink the node from every level it is on and
+ * shorten the jumps that pass over it
+ *    INPUT  : the element to remove
+ *    OUTPUT : the element after it
+ *    COST   : O(log n) expected
+ *********************************************/
+template <typename T>
+typename indexed_list <T> :: iterator
+indexed_list <T> :: erase(const iterator & it)
+{
+   Node * pDelete = it.p;
+   assert(pDelete);
+   size_t i = index_of(it);
+
+   Node * preds[MAX_LEVELS];
+   size_t predPos[MAX_LEVELS];
+   findPreds(i, preds, predPos);
+
+   // everything after i moves down one
+   for (unsigned L = 0; L < numLevels; L++)
+   {
+      if (first[L] && real(firstPos[L]) > i)
+         firstPos[L]--;
+      if (tail[L] && real(tailPos[L]) > i)
+         tailPos[L]--;
+   }
+
+   for (unsigned L = 0; L < numLevels; L++)
+   {
+      Node * pPred = preds[L];
+      if (L >= pDelete->height)
+      {
+         if (pPred && pPred->skips[L].pNext)
+            pPred->skips[L].width--;
+         continue;
+      }
+
+      Node * pNext = pDelete->skips[L].pNext;
+      if (pPred)
+      {
+         pPred->skips[L].pNext = pNext;
+         if (pNext)
+            pPred->skips[L].width += pDelete->skips[L].width - 1;
+         else
+         {
+            pPred->skips[L].width = 0;
+            tail[L] = pPred;
+            tailPos[L] = stored(predPos[L]);
+         }
+      }
+      else
+      {
+         first[L] = pNext;
+         if (pNext)
+            firstPos[L] = stored(i + pDelete->skips[L].width - 1);
+         else
+            tail[L] = nullptr;
+      }
+   }
+
+   Node * pNext = pDelete->skips[0].pNext;
+   if (pNext)
+      pNext->pPrev = pDelete->pPrev;
+   while (numLevels > 0 && first[numLevels - 1] == nullptr)
+      numLevels--;
+   numElements--;
+   delete pDelete;
+   return iterator(pNext);
+}
+
+/*********************************************
+ * INDEXED LIST :: CLEAR
+ *    COST   : O(n)
+ *********************************************/
+template <typename T>
+void indexed_list <T> :: clear()
+{
+   Node * p = first[0];
+   while (p)
+   {
+      Node * pDelete = p;
+      p = p->skips[0].pNext;
+      delete pDelete;
+   }
+   for (unsigned L = 0; L < MAX_LEVELS; L++)
+   {
+      first[L] = tail[L] = nullptr;
+      firstPos[L] = tailPos[L] = 0;
+   }
+   numElements = 0;
+   numLevels = 0;
+   shift = 0;
+}
+
+/*********************************************
+ * INDEXED LIST :: NODE AT
+ * Start on the highest level whose first node is
+ * not past i, take every jump that does not
+ * overshoot, then drop a level
+ *    COST   : O(log n) expected, O(1) at the ends
+ *********************************************/
+template <typename T>
+typename indexed_list <T> :: Node * indexed_list <T> :: nodeAt(size_t i) const
+{
+   assert(i < numElements);
+   if (i == numElements - 1)
+      return tail[0];
+
+   Node * p = nullptr;
+   size_t pos = 0;
+   for (unsigned L = numLevels; L-- > 0; )
+   {
+      if (!p && first[L] && real(firstPos[L]) <= i)
+      {
+         p = first[L];
+         pos = real(firstPos[L]);
+      }
+      if (p)
+         while (p->skips[L].pNext && pos + p->skips[L].width <= i)
+         {
+            pos += p->skips[L].width;
+            p = p->skips[L].pNext;
+         }
+   }
+   assert(p && pos == i);
+   return p;
+}
+
+/*********************************************
+ * INDEXED LIST :: FIND PREDS
+ * For every level, the last node before index i
+ * and its position. nullptr means no node on that
+ * level comes before i.
+ *    COST   : O(log n) expected
+ *********************************************/
+template <typename T>
+void indexed_list <T> :: findPreds(size_t i, Node ** preds, size_t * predPos) const
+{
+   Node * p = nullptr;
+   size_t pos = 0;
+   for (unsigned L = numLevels; L-- > 0; )
+   {
+      if (!p && first[L] && real(firstPos[L]) < i)
+      {
+         p = first[L];
+         pos = real(firstPos[L]);
+      }
+      if (p)
+         while (p->skips[L].pNext && pos + p->skips[L].width < i)
+         {
+            pos += p->skips[L].width;
+            p = p->skips[L].pNext;
+         }
+      preds[L] = p;
+      predPos[L] = pos;
+   }
+}
+
+}; // namespace custom
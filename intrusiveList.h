@@ -0,0 +1,325 @@
+/***********************************************************************
+ * Header:
+ *    INTRUSIVE LIST
+ * Summary:
+ *    A doubly linked list whose links live inside the elements. The
+ *    user's type embeds one list_hook per list it may join, the same
+ *    pNext and pPrev a list Node carries, and the list just threads
+ *    through those hooks. Joining or leaving a list never allocates,
+ *    the elements are reached without an extra dereference, and one
+ *    object can sit in as many lists as it has hooks.
+ *
+ *    The list does not own its elements. They must outlive their time
+ *    in the list, and must not be in two lists through the same hook.
+ *    A hook does not record which list it is in, so erase and remove
+ *    must only be given elements of this list; debug builds check this
+ *    at the ends of the list. Destroying or clearing the list unlinks
+ *    every element.
+ *
+ *    This will contain the class definition of:
+ *        list_hook                : The links embedded in an element
+ *        intrusive_list           : A list through one hook
+ *        intrusive_list::iterator : An iterator through it
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+
+class TestIntrusiveList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * LIST HOOK
+ * Embed one of these in T for every intrusive_list
+ * a T may belong to. Copying a T never copies its
+ * membership: a copy's hooks start unlinked.
+ **************************************************/
+template <typename T>
+class list_hook
+{
+public:
+   list_hook() : pNext(nullptr), pPrev(nullptr), linked(false) {}
+   list_hook(const list_hook &) : pNext(nullptr), pPrev(nullptr), linked(false) {}
+   list_hook & operator = (const list_hook &) { return *this; }
+
+   bool is_linked() const { return linked; }
+
+   T * pNext;      // next element in the list, nullptr at the tail
+   T * pPrev;      // previous element in the list, nullptr at the head
+   bool linked;    // in a list right now
+};
+
+/**************************************************
+ * INTRUSIVE LIST
+ * Hook names the member of T that holds the links,
+ * as in intrusive_list<Connection, &Connection::hook>
+ **************************************************/
+template <typename T, list_hook<T> T::* Hook>
+class intrusive_list
+{
+   friend class ::TestIntrusiveList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   intrusive_list() : numElements(0), pHead(nullptr), pTail(nullptr) {}
+   intrusive_list(intrusive_list && rhs)
+   : numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
+   {
+      rhs.numElements = 0;
+      rhs.pHead = rhs.pTail = nullptr;
+   }
+   intrusive_list(const intrusive_list & rhs) = delete;
+   intrusive_list & operator = (const intrusive_list & rhs) = delete;
+   intrusive_list & operator = (intrusive_list && rhs);
+   ~intrusive_list() { clear(); }
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin()  { return iterator(pHead);   }
+   iterator rbegin() { return iterator(pTail);   }
+   iterator end()    { return iterator(nullptr); }
+   static iterator iterator_to(T & element) { return iterator(&element); }
+
+   //
+   // Access
+   //
+
+   T & front() { assert(pHead); return *pHead; }
+   T & back()  { assert(pTail); return *pTail; }
+
+   //
+   // Insert
+   //
+
+   void push_front(T & element) { insert(begin(), element); }
+   void push_back (T & element) { insert(end(),   element); }
+   iterator insert(iterator it, T & element);
+
+   //
+   // Remove
+   //
+
+   void pop_front() { if (pHead) erase(begin());   }
+   void pop_back()  { if (pTail) erase(rbegin());  }
+   iterator erase(iterator it);
+   void remove(T & element) { erase(iterator_to(element)); } // element is in this list
+   void clear();
+
+   //
+   // Splice
+   //
+
+   void splice(iterator it, intrusive_list & rhs);
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return pHead == nullptr; }
+   size_t size() const { return numElements;      }
+
+private:
+   static list_hook<T> & hook(T * p) { return p->*Hook; }
+
+   // member variables
+   size_t numElements;  // kept so size() need not walk the list
+   T * pHead;           // first element
+   T * pTail;           // last element
+};
+
+/*************************************************
+ * INTRUSIVE LIST ITERATOR
+ * Walks the hooks; dereferences to the element
+ ************************************************/
+template <typename T, list_hook<T> T::* Hook>
+class intrusive_list <T, Hook> :: iterator
+{
+   friend class ::TestIntrusiveList; // give unit tests access to the privates
+   friend class custom::intrusive_list <T, Hook>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator, fetch an element
+   T & operator * ()  { return *p; }
+   T * operator -> () { return p;  }
+
+   // prefix increment
+   iterator & operator ++ () { p = (p->*Hook).pNext; return *this; }
+
+   // postfix increment
+   iterator operator ++ (int) { iterator tmp = *this; ++*this; return tmp; }
+
+   // prefix decrement
+   iterator & operator -- () { p = (p->*Hook).pPrev; return *this; }
+
+   // postfix decrement
+   iterator operator -- (int) { iterator tmp = *this; --*this; return tmp; }
+
+private:
+   iterator(T * p) : p(p) {}
+
+   T * p;   // the current element
+};
+
+/*********************************************
+ * INTRUSIVE LIST :: ASSIGNMENT - MOVE
+ * Unlink our own elements, then take over rhs's
+ *    INPUT  : the list to take the elements from
+ *    OUTPUT : *this
+ *    COST   : O(n) to unlink what we held
+ *********************************************/
+template <typename T, list_hook<T> T::* Hook>
+intrusive_list <T, Hook> & intrusive_list <T, Hook> :: operator = (intrusive_list && rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+      numElements = rhs.numElements;
+      pHead = rhs.pHead;
+      pTail = rhs.pTail;
+      rhs.numElements = 0;
+      rhs.pHead = rhs.pTail = nullptr;
+   }
+   return *this;
+}
+
+/*********************************************
+ * INTRUSIVE LIST :: INSERT
+ * Link element in front of it
+ *    INPUT  : where it goes, end() for the back
+ *             an element not yet in a list
+ *             through this hook
+ *    OUTPUT : an iterator to the element
+ *    COST   : O(1), no allocation
+ *********************************************/
+template <typename T, list_hook<T> T::* Hook>
+typename intrusive_list <T, Hook> :: iterator
+intrusive_list <T, Hook> :: insert(iterator it, T & element)
+{
+   list_hook<T> & h = hook(&element);
+   assert(!h.linked);
+
+   T * pNext = it.p;
+   T * pPrev = pNext ? hook(pNext).pPrev : pTail;
+   h.pNext = pNext;
+   h.pPrev = pPrev;
+   h.linked = true;
+
+   if (pPrev)
+      hook(pPrev).pNext = &element;
+   else
+      pHead = &element;
+   if (pNext)
+      hook(pNext).pPrev = &element;
+   else
+      pTail = &element;
+
+   numElements++;
+   return iterator(&element);
+}
+
+/*********************************************
+ * INTRUSIVE LIST :: ERASE
+ * Unlink an element; it is not destroyed. The
+ * element must be in this list, not merely linked:
+ * unlinking another list's head or tail would leave
+ * that list's ends dangling.
+ *    INPUT  : the element, which is in this list
+ *    OUTPUT : the element that followed it
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, list_hook<T> T::* Hook>
+typename intrusive_list <T, Hook> :: iterator
+intrusive_list <T, Hook> :: erase(iterator it)
+{
+   assert(it.p && hook(it.p).linked);
+   list_hook<T> & h = hook(it.p);
+   assert(h.pPrev || pHead == it.p);   // a first element must be our head
+   assert(h.pNext || pTail == it.p);   // a last element must be our tail
+   T * pNext = h.pNext;
+
+   if (h.pPrev)
+      hook(h.pPrev).pNext = h.pNext;
+   else
+      pHead = h.pNext;
+   if (h.pNext)
+      hook(h.pNext).pPrev = h.pPrev;
+   else
+      pTail = h.pPrev;
+
+   h.pNext = h.pPrev = nullptr;
+   h.linked = false;
+   numElements--;
+   return iterator(pNext);
+}
+
+/*********************************************
+ * INTRUSIVE LIST :: CLEAR
+ * Unlink every element so each may join another
+ * list; nothing is destroyed
+ *    COST   : O(n)
+ *********************************************/
+template <typename T, list_hook<T> T::* Hook>
+void intrusive_list <T, Hook> :: clear()
+{
+   T * p = pHead;
+   while (p)
+   {
+      list_hook<T> & h = hook(p);
+      p = h.pNext;
+      h.pNext = h.pPrev = nullptr;
+      h.linked = false;
+   }
+   pHead = pTail = nullptr;
+   numElements = 0;
+}
+
+/*********************************************
+ * INTRUSIVE LIST :: SPLICE
+ * Move every element of rhs in front of it
+ *    INPUT  : where they go
+ *             the list to take them from
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, list_hook<T> T::* Hook>
+void intrusive_list <T, Hook> :: splice(iterator it, intrusive_list & rhs)
+{
+   if (&rhs == this || rhs.empty())
+      return;
+
+   T * pNext = it.p;
+   T * pPrev = pNext ? hook(pNext).pPrev : pTail;
+   hook(rhs.pHead).pPrev = pPrev;
+   hook(rhs.pTail).pNext = pNext;
+   if (pPrev)
+      hook(pPrev).pNext = rhs.pHead;
+   else
+      pHead = rhs.pHead;
+   if (pNext)
+      hook(pNext).pPrev = rhs.pTail;
+   else
+      pTail = rhs.pTail;
+
+   numElements += rhs.numElements;
+   rhs.numElements = 0;
+   rhs.pHead = rhs.pTail = nullptr;
+}
+
+}; // namespace custom
@@ -10,9 +10,19 @@
  *     _| |_   _| |_  | \____) |  / / (_)
  *    |_____| |_____|  \______.' /_/
  *
+ *    Positional access (at, position, insert_at, erase_at) walks from
+ *    whichever is nearer of the head or the tail. A list<T, A, true>
+ *    also keeps a "finger": the node and index of the last positional
+ *    access, and walks from it when it is nearer still. Sequential and
+ *    nearby positional work then costs O(distance) per operation
+ *    instead of O(n). Operations that cannot cheaply tell where they
+ *    happened relative to the finger simply drop it. The default list
+ *    keeps no finger and pays nothing for it.
+ *
  *    This will contain the class definition of:
- *        List         : A class that represents a List
- *        ListIterator : An iterator through List
+ *        List              : A class that represents a List
+ *        ListIterator      : An iterator through List
+ *        ListConstIterator : A read-only iterator through List
  * Authors
  *    Daniel Carr, Jarom Anderson, Arlo Jolly
  ************************************************************************/
@@ -23,6 +33,8 @@
 #include <new>              // std::bad_alloc
 #include <memory>           // for std::allocator
 #include <initializer_list> // for std::initializer_list
+#include <functional>       // for std::less
+#include <stdexcept>        // for std::out_of_range
 
 class TestList; // forward declaration for unit tests
 class TestHash; // forward declaration for hash used later
@@ -30,24 +42,70 @@ class TestHash; // forward declaration for hash used later
 namespace custom
 {
 
+/**************************************************
+ * NODE LAYOUT
+ * Layout policy for the nodes of a list of T. By
+ * default a node is aligned no more than its links
+ * and T need. Specialize to give every node a cache
+ * line of its own, so that a large T whose first
+ * members are compared shares that line with the
+ * links and no two nodes share a line. The
+ * alignment must be a power of two no smaller
+ * than alignof(void *):
+ *    template <>
+ *    struct custom::node_layout<Record>
+ *    { static const size_t alignment = 64; };
+ **************************************************/
+template <typename T>
+struct node_layout
+{
+   static const size_t alignment = alignof(void *);
+};
+
+/**************************************************
+ * LIST FINGER
+ * The node and index of the last positional access.
+ * Only a list<T, A, true> keeps one; every other
+ * list gets the empty specialization and pays
+ * nothing for it. The node is untyped because
+ * list::Node is not declared yet; list casts it back.
+ **************************************************/
+template <bool Finger>
+struct list_finger
+{
+   list_finger() : pFinger(nullptr), iFinger(0) {}
+
+   void * pFinger;     // node of the last positional access, nullptr if unknown
+   size_t iFinger;     // index of pFinger
+};
+
+template <>
+struct list_finger <false>
+{
+};
+
 /**************************************************
  * LIST
- * Just like std::list
+ * Just like std::list. A list<T, A, true> also
+ * keeps a finger for positional access.
  **************************************************/
-template <typename T, typename A = std::allocator<T>>
-class list
+template <typename T, typename A = std::allocator<T>, bool Finger = false>
+class list : private list_finger <Finger>
 {
    friend class ::TestList; // give unit tests access to the privates
    friend class ::TestHash;
    friend void swap(list& lhs, list& rhs);
+   static_assert(node_layout<T>::alignment >= alignof(void *),
+                 "node_layout alignment must cover the links");
 public:
 
    //
    // Construct
    //
 
-   list(const A& a = A()) : numElements(0), pHead(nullptr), pTail(nullptr) {}
-   list(list <T, A>& rhs, const A& a = A())
+   list(const A& a = A())
+   : numElements(0), pHead(nullptr), pTail(nullptr) {}
+   list(list <T, A, Finger>& rhs, const A& a = A())
    : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
    {
       if (rhs.pHead != nullptr)
@@ -60,7 +118,7 @@ public:
          }
       }
    }
-   list(list <T, A>&& rhs, const A& a = A());
+   list(list <T, A, Finger>&& rhs, const A& a = A());
    list(size_t num, const T & t, const A& a = A());
    list(size_t num, const A& a = A());
    list(const std::initializer_list<T>& il, const A& a = A())
@@ -85,10 +143,11 @@ public:
    // Assign
    //
 
-   list <T, A> & operator = (list <T, A> &  rhs);
-   list <T, A> & operator = (list <T, A> && rhs);
-   list <T, A> & operator = (const std::initializer_list<T>& il);
-   void swap(list <T, A>& rhs)
+   list <T, A, Finger> & operator = (list <T, A, Finger> &  rhs);
+   list <T, A, Finger> & operator = (list <T, A, Finger> && rhs);
+   list <T, A, Finger> & operator = (const std::initializer_list<T>& il);
+   void assign_from(const T * in, size_t n);
+   void swap(list <T, A, Finger>& rhs)
    {
       Node * tempHead = rhs.pHead;
       rhs.pHead = pHead;
@@ -101,6 +160,10 @@ public:
       size_t tempElements = rhs.numElements;
       rhs.numElements = numElements;
       numElements = tempElements;
+
+      list_finger <Finger> tempFinger = rhs;
+      static_cast <list_finger <Finger> &> (rhs) = *this;
+      static_cast <list_finger <Finger> &> (*this) = tempFinger;
    }
 
    //
@@ -111,6 +174,10 @@ public:
    iterator begin()  { return iterator (pHead);   }
    iterator rbegin() { return iterator (pTail);   }
    iterator end()    { return iterator (nullptr); }
+   iterator position(size_t i) { return iterator (i < numElements ? nodeAt(i) : nullptr); }
+   class const_iterator;
+   const_iterator cbegin() const { return const_iterator (pHead);   }
+   const_iterator cend()   const { return const_iterator (nullptr); }
 
    //
    // Access
@@ -118,6 +185,8 @@ public:
 
    T & front();
    T & back();
+   T & at(size_t i);
+   size_t copy_to(T * out, size_t n) const;
 
    //
    // Insert
@@ -129,6 +198,8 @@ public:
    void push_back (      T && data);
    iterator insert(iterator it, const T &  data);
    iterator insert(iterator it,       T && data);
+   iterator insert_at(size_t i, const T &  data);
+   iterator insert_at(size_t i,       T && data);
 
    //
    // Remove
@@ -138,6 +209,28 @@ public:
    void pop_front();
    void clear();
    iterator erase(const iterator & it);
+   iterator erase_at(size_t i);
+
+   //
+   // Splice
+   //
+
+   void splice(iterator it, list <T, A, Finger> & rhs);
+   void splice(iterator it, list <T, A, Finger> & rhs, iterator itRHS);
+   void splice(iterator it, list <T, A, Finger> & rhs, iterator first, iterator last);
+   void splice(iterator it, list <T, A, Finger> & rhs, iterator first, iterator last,
+               size_t count);
+
+   //
+   // Sort
+   //
+
+   template <class Compare>
+   void merge(list <T, A, Finger> & rhs, Compare cmp);
+   void merge(list <T, A, Finger> & rhs) { merge(rhs, std::less<T>()); }
+   template <class Compare>
+   void sort(Compare cmp);
+   void sort() { sort(std::less<T>()); }
 
    //
    // Status
@@ -150,6 +243,37 @@ private:
    // nested linked list class
    class Node;
 
+   // relinking helpers shared by splice, merge, and sort
+   void unlinkRange(Node * pFirst, Node * pLast);
+   void linkRange(Node * pPos, Node * pFirst, Node * pLast);
+   void relinkPrev();
+   void relinkNext();
+   template <class Compare>
+   static Node * mergeChains(Node * pLeft, Node * pRight, Compare & cmp);
+
+   // positional walks from the nearest of head, tail, and finger
+   Node * nodeAt(size_t i);
+
+   // the finger; each of these does nothing unless Finger is true
+   Node * finger() const
+   {
+      if constexpr (Finger)
+         return static_cast <Node *> (this->pFinger);
+      else
+         return nullptr;
+   }
+   void setFinger(Node * p, size_t i)
+   {
+      if constexpr (Finger)
+      {
+         this->pFinger = p;
+         this->iFinger = i;
+      }
+   }
+   void dropFinger() { setFinger(nullptr, 0); }
+   void fingerBeforeInsert(Node * pPos);
+   void fingerBeforeErase(Node * pDelete);
+
    // member variables
    A    alloc;         // use alloacator for memory allocation
    size_t numElements; // though we could count, it is faster to keep a variable
@@ -162,10 +286,15 @@ private:
  * the node class.  Since we do not validate any
  * of the setters, there is no point in making them
  * private.  This is the case because only the
- * List class can make validation decisions
+ * List class can make validation decisions.
+ * The links come before the data so that a walk
+ * reads them and the front of T from the same
+ * cache line, and node_layout can widen the
+ * alignment of the whole node.
  *************************************************/
-template <typename T, typename A>
-class list <T, A> :: Node
+template <typename T, typename A, bool Finger>
+class alignas(node_layout<T>::alignment > alignof(T) ? node_layout<T>::alignment : alignof(T))
+   list <T, A, Finger> :: Node
 {
 public:
    //
@@ -179,21 +308,21 @@ public:
    // Member Variables
    //
 
-   T data;             // user data
    Node * pNext;       // pointer to next node
    Node * pPrev;       // pointer to previous node
+   T data;             // user data
 };
 
 /*************************************************
  * LIST ITERATOR
  * Iterate through a List, non-constant version
  ************************************************/
-template <typename T, typename A>
-class list <T, A> :: iterator
+template <typename T, typename A, bool Finger>
+class list <T, A, Finger> :: iterator
 {
    friend class ::TestList; // give unit tests access to the privates
    friend class ::TestHash;
-   template <typename TT, typename AA>
+   template <typename TT, typename AA, bool FF>
    friend class custom::list;
 
 public:
@@ -231,21 +360,62 @@ public:
    { p = p->pPrev; return *this; }
 
    // two friends who need to access p directly
-   friend iterator list <T, A> :: insert(iterator it, const T &  data);
-   friend iterator list <T, A> :: insert(iterator it,       T && data);
-   friend iterator list <T, A> :: erase(const iterator & it);
+   friend iterator list <T, A, Finger> :: insert(iterator it, const T &  data);
+   friend iterator list <T, A, Finger> :: insert(iterator it,       T && data);
+   friend iterator list <T, A, Finger> :: erase(const iterator & it);
+
+private:
+
+   typename list <T, A, Finger> :: Node * p;
+};
+
+/*************************************************
+ * LIST CONST ITERATOR
+ * Iterate through a List, constant version, so a
+ * const list can be read without a copy
+ ************************************************/
+template <typename T, typename A, bool Finger>
+class list <T, A, Finger> :: const_iterator
+{
+   friend class ::TestList; // give unit tests access to the privates
+
+public:
+   // constructors, destructors, and assignment operator
+   const_iterator() : p(nullptr) {}
+   const_iterator(const Node * pRHS) : p(pRHS) {}
+
+   // equals, not equals operator
+   bool operator == (const const_iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const const_iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator, read a node
+   const T & operator * () const { return p->data; }
+
+   // postfix increment
+   const_iterator operator ++ (int)
+   { const_iterator tmp = *this; p = p->pNext; return tmp; }
+
+   // prefix increment
+   const_iterator & operator ++ () { p = p->pNext; return *this; }
+
+   // postfix decrement
+   const_iterator operator -- (int)
+   { const_iterator tmp = *this; p = p->pPrev; return tmp; }
+
+   // prefix decrement
+   const_iterator & operator -- () { p = p->pPrev; return *this; }
 
 private:
 
-   typename list <T, A> :: Node * p;
+   const typename list <T, A, Finger> :: Node * p;
 };
 
 /*****************************************
  * LIST :: NON-DEFAULT constructors
  * Create a list initialized to a value
  ****************************************/
-template <typename T, typename A>
-list <T, A> ::list(size_t num, const T & t, const A& a)
+template <typename T, typename A, bool Finger>
+list <T, A, Finger> ::list(size_t num, const T & t, const A& a)
 : alloc(a), numElements(0), pHead(0), pTail(0)
 {
    if (num > 0)
@@ -268,19 +438,19 @@ list <T, A> ::list(size_t num, const T & t, const A& a)
  * LIST :: NON-DEFAULT constructors
  * Create a list initialized to a value
  ****************************************/
-template <typename T, typename A>
-list <T, A> ::list(size_t num, const A& a)
+template <typename T, typename A, bool Finger>
+list <T, A, Finger> ::list(size_t num, const A& a)
 : alloc(a), numElements(0), pHead(0), pTail(0)
 {
    if (num)
    {
-      list <T, A> ::Node * pPrevious;
-      list <T, A> ::Node * pNew;
-      pHead = pPrevious = pNew = new list <T, A> ::Node();
+      list <T, A, Finger> ::Node * pPrevious;
+      list <T, A, Finger> ::Node * pNew;
+      pHead = pPrevious = pNew = new list <T, A, Finger> ::Node();
       pHead->pPrev = nullptr;
       for (size_t i = 1; i < num; i++)
       {
-         pNew = new list <T, A> ::Node();
+         pNew = new list <T, A, Finger> ::Node();
          pNew->pPrev = pPrevious;
          pNew->pPrev->pNext = pNew;
          pPrevious = pNew;
@@ -295,12 +465,14 @@ list <T, A> ::list(size_t num, const A& a)
  * LIST :: MOVE constructors
  * Steal the values from the RHS
  ****************************************/
-template <typename T, typename A>
-list <T, A> ::list(list <T, A>&& rhs, const A& a) :
-   numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail), alloc(a)
+template <typename T, typename A, bool Finger>
+list <T, A, Finger> ::list(list <T, A, Finger>&& rhs, const A& a) :
+   list_finger <Finger> (rhs), alloc(a),
+   numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
 {
    rhs.pHead = rhs.pTail = nullptr;
    rhs.numElements = 0;
+   rhs.dropFinger();
 }
 
 /**********************************************
@@ -310,8 +482,8 @@ list <T, A> ::list(list <T, A>&& rhs, const A& a) :
  *     OUTPUT :
  *     COST   : O(n) with respect to the size of the LHS
  *********************************************/
-template <typename T, typename A>
-list <T, A>& list <T, A> :: operator = (list <T, A> && rhs)
+template <typename T, typename A, bool Finger>
+list <T, A, Finger>& list <T, A, Finger> :: operator = (list <T, A, Finger> && rhs)
 {
    clear();
    swap(rhs);
@@ -325,9 +497,10 @@ list <T, A>& list <T, A> :: operator = (list <T, A> && rhs)
  *     OUTPUT :
  *     COST   : O(n) with respect to the number of nodes
  *********************************************/
-template <typename T, typename A>
-list <T, A> & list <T, A> :: operator = (list <T, A> & rhs)
+template <typename T, typename A, bool Finger>
+list <T, A, Finger> & list <T, A, Finger> :: operator = (list <T, A, Finger> & rhs)
 {
+   dropFinger();
    iterator itRHS = rhs.begin();
    iterator itLHS = begin();
    while (itRHS != rhs.end() && itLHS != end())
@@ -374,10 +547,11 @@ list <T, A> & list <T, A> :: operator = (list <T, A> & rhs)
  *     OUTPUT :
  *     COST   : O(n) with respect to the number of nodes
  *********************************************/
- template <typename T, typename A>
-     list <T, A>& list <T, A> :: operator =
+ template <typename T, typename A, bool Finger>
+     list <T, A, Finger>& list <T, A, Finger> :: operator =
      (const std::initializer_list<T>& rhs)
      {
+        dropFinger();
         typename std::initializer_list<T>::const_iterator itRHS = rhs.begin();
         iterator itLHS = begin();
         while (itRHS != rhs.end() && itLHS != end())
@@ -414,6 +588,43 @@ list <T, A> & list <T, A> :: operator = (list <T, A> & rhs)
         return *this;
      }
 
+/**********************************************
+ * LIST :: ASSIGN FROM
+ * Replace the contents with the n values of a
+ * flat array. Like copy assignment, the nodes we
+ * already have are overwritten in place, so only
+ * a longer array allocates and a shorter one frees.
+ *     INPUT  : the array and how many values it holds
+ *     OUTPUT :
+ *     COST   : O(n + size())
+ *********************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: assign_from(const T * in, size_t n)
+{
+   dropFinger();
+   Node * p = pHead;
+   size_t i = 0;
+   for (; i < n && p; i++, p = p->pNext)
+      p->data = in[i];
+
+   if (i < n)
+   {
+      for (; i < n; i++)
+         push_back(in[i]);
+   }
+   else if (p)
+   {
+      unlinkRange(p, pTail);
+      while (p)
+      {
+         Node * pDelete = p;
+         p = p->pNext;
+         delete pDelete;
+      }
+      numElements = n;
+   }
+}
+
 /**********************************************
  * LIST :: CLEAR
  * Remove all the items currently in the linked list
@@ -421,8 +632,8 @@ list <T, A> & list <T, A> :: operator = (list <T, A> & rhs)
  *     OUTPUT :
  *     COST   : O(n) with respect to the number of nodes
  *********************************************/
-template <typename T, typename A>
-void list <T, A> :: clear()
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: clear()
 {
    while (pHead != nullptr)
    {
@@ -431,6 +642,7 @@ void list <T, A> :: clear()
       delete pDelete;
    }
    pTail = nullptr;
+   dropFinger();
    numElements = 0;
 }
 
@@ -441,8 +653,8 @@ void list <T, A> :: clear()
  *    OUTPUT :
  *    COST   : O(1)
  *********************************************/
-template <typename T, typename A>
-void list <T, A> :: push_back(const T & data)
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: push_back(const T & data)
 {
    Node* pNew = new Node(data);
    if (pTail != nullptr)
@@ -456,8 +668,8 @@ void list <T, A> :: push_back(const T & data)
    numElements++;
 }
 
-template <typename T, typename A>
-void list <T, A> ::push_back(T && data)
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> ::push_back(T && data)
 {
    Node* pNew = new Node(std::move(data));
    if (pTail != nullptr)
@@ -479,10 +691,11 @@ void list <T, A> ::push_back(T && data)
  *     OUTPUT :
  *     COST   : O(1)
  *********************************************/
-template <typename T, typename A>
-void list <T, A> :: push_front(const T & data)
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: push_front(const T & data)
 {
    Node* pNew = new Node(data);
+   fingerBeforeInsert(pHead);
    if (pHead != nullptr)
    {
       pHead->pPrev = pNew;
@@ -494,10 +707,11 @@ void list <T, A> :: push_front(const T & data)
    numElements++;
 }
 
-template <typename T, typename A>
-void list <T, A> ::push_front(T && data)
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> ::push_front(T && data)
 {
    Node* pNew = new Node(std::move(data));
+   fingerBeforeInsert(pHead);
    if (pHead != nullptr)
    {
       pHead->pPrev = pNew;
@@ -517,12 +731,13 @@ void list <T, A> ::push_front(T && data)
  *    OUTPUT :
  *    COST   : O(1)
  *********************************************/
-template <typename T, typename A>
-void list <T, A> ::pop_back()
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> ::pop_back()
 {
    if (pTail != nullptr)
    {
       Node* pDelete = pTail;
+      fingerBeforeErase(pDelete);
       pTail = pTail->pPrev;
       if (pTail != nullptr)
          pTail->pNext = nullptr;
@@ -540,12 +755,13 @@ void list <T, A> ::pop_back()
  *    OUTPUT :
  *    COST   : O(1)
  *********************************************/
-template <typename T, typename A>
-void list <T, A> ::pop_front()
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> ::pop_front()
 {
    if (pHead != nullptr)
    {
       Node* pDelete = pHead;
+      fingerBeforeErase(pDelete);
       pHead = pHead->pNext;
       if (pHead != nullptr)
          pHead->pPrev = nullptr;
@@ -563,8 +779,8 @@ void list <T, A> ::pop_front()
  *     OUTPUT : data to be displayed
  *     COST   : O(1)
  *********************************************/
-template <typename T, typename A>
-T & list <T, A> :: front()
+template <typename T, typename A, bool Finger>
+T & list <T, A, Finger> :: front()
 {
    if (numElements != 0)
    {
@@ -581,8 +797,8 @@ T & list <T, A> :: front()
  *     OUTPUT : data to be displayed
  *     COST   : O(1)
  *********************************************/
-template <typename T, typename A>
-T & list <T, A> :: back()
+template <typename T, typename A, bool Finger>
+T & list <T, A, Finger> :: back()
 {
    if (numElements != 0)
    {
@@ -593,6 +809,122 @@ T & list <T, A> :: back()
 }
 
 
+/*********************************************
+ * LIST :: AT
+ * retrieves the element at index i
+ *     INPUT  : the index
+ *     OUTPUT : the element there
+ *     COST   : O(distance from the nearest of head, tail, finger)
+ *********************************************/
+template <typename T, typename A, bool Finger>
+T & list <T, A, Finger> :: at(size_t i)
+{
+   if (i >= numElements)
+      throw std::out_of_range("list::at");
+   return nodeAt(i)->data;
+}
+
+/*********************************************
+ * LIST :: COPY TO
+ * Copy the front of the list into a flat array,
+ * walking the nodes once from the head
+ *     INPUT  : the array and how many values fit in it
+ *     OUTPUT : how many values were copied, the smaller
+ *              of n and size()
+ *     COST   : O(min(n, size()))
+ *********************************************/
+template <typename T, typename A, bool Finger>
+size_t list <T, A, Finger> :: copy_to(T * out, size_t n) const
+{
+   size_t i = 0;
+   for (const Node * p = pHead; i < n && p; i++, p = p->pNext)
+      out[i] = p->data;
+   return i;
+}
+
+/*********************************************
+ * LIST :: NODE AT
+ * find the node at index i, starting from whichever
+ * of the head, the tail, or the finger is closest,
+ * and leave the finger there
+ *     INPUT  : the index, less than size()
+ *     OUTPUT : the node
+ *     COST   : O(distance from the nearest of head, tail, finger)
+ *********************************************/
+template <typename T, typename A, bool Finger>
+typename list <T, A, Finger> :: Node * list <T, A, Finger> :: nodeAt(size_t i)
+{
+   assert(i < numElements);
+   Node * p = pHead;
+   size_t iFrom = 0;
+   size_t distance = i;
+   if (numElements - 1 - i < distance)
+   {
+      p = pTail;
+      iFrom = numElements - 1;
+      distance = numElements - 1 - i;
+   }
+   if constexpr (Finger)
+   {
+      if (finger() && (i > this->iFinger ? i - this->iFinger : this->iFinger - i) < distance)
+      {
+         p = finger();
+         iFrom = this->iFinger;
+      }
+   }
+
+   for (; iFrom < i; iFrom++)
+      p = p->pNext;
+   for (; iFrom > i; iFrom--)
+      p = p->pPrev;
+
+   setFinger(p, i);
+   return p;
+}
+
+/*********************************************
+ * LIST :: FINGER BEFORE INSERT
+ * A node is about to go in front of pPos. The
+ * finger survives if we can tell which side of
+ * it that is. Nothing happens without a finger.
+ *    INPUT  : the node the new one goes before,
+ *             nullptr for the end
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: fingerBeforeInsert(Node * pPos)
+{
+   if constexpr (Finger)
+   {
+      if (pPos == finger() || pPos == pHead)
+         this->iFinger++;  // the finger is at or after pPos
+      else if (pPos != nullptr)
+         dropFinger();
+   }
+}
+
+/*********************************************
+ * LIST :: FINGER BEFORE ERASE
+ * pDelete is about to be unlinked. The finger
+ * survives if we can tell which side of it that
+ * is. Nothing happens without a finger.
+ *    INPUT  : the node being removed
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: fingerBeforeErase(Node * pDelete)
+{
+   if constexpr (Finger)
+   {
+      if (pDelete == finger())
+         this->pFinger = pDelete->pNext;
+      else if (pDelete == pHead)
+         this->iFinger--;  // the finger is after pDelete
+      else if (pDelete != pTail)
+         dropFinger();
+   }
+}
+
 /******************************************
  * LIST :: REMOVE
  * remove an item from the middle of the list
@@ -600,14 +932,16 @@ T & list <T, A> :: back()
  *     OUTPUT : iterator to the new location
  *     COST   : O(1)
  ******************************************/
-template <typename T, typename A>
-typename list <T, A> :: iterator  list <T, A> ::
-   erase(const list <T, A> :: iterator & it)
+template <typename T, typename A, bool Finger>
+typename list <T, A, Finger> :: iterator  list <T, A, Finger> ::
+   erase(const list <T, A, Finger> :: iterator & it)
 {
    Node* pDelete = it.p;
    if (pDelete == nullptr)
       return end();
 
+   fingerBeforeErase(pDelete);
+
    if (pDelete->pPrev != nullptr)
       pDelete->pPrev->pNext = pDelete->pNext;
    else
@@ -632,9 +966,9 @@ typename list <T, A> :: iterator  list <T, A> ::
  *     OUTPUT : iterator to the new item
  *     COST   : O(1)
  ******************************************/
-template <typename T, typename A>
-typename list <T, A> :: iterator list <T, A> ::
-   insert(list <T, A> :: iterator it,
+template <typename T, typename A, bool Finger>
+typename list <T, A, Finger> :: iterator list <T, A, Finger> ::
+   insert(list <T, A, Finger> :: iterator it,
                                                  const T & data)
 {
    Node* pNew = new Node(data);
@@ -654,6 +988,7 @@ typename list <T, A> :: iterator list <T, A> ::
    }
    else if (it != end())
    {
+      fingerBeforeInsert(it.p);
       pNew->pPrev = it.p->pPrev;
       pNew->pNext = it.p;
 
@@ -683,9 +1018,9 @@ typename list <T, A> :: iterator list <T, A> ::
  *     OUTPUT : iterator to the new item
  *     COST   : O(1)
  ******************************************/
-template <typename T, typename A>
-typename list <T, A> ::iterator list <T, A> ::
-   insert(list <T, A> ::iterator it,
+template <typename T, typename A, bool Finger>
+typename list <T, A, Finger> ::iterator list <T, A, Finger> ::
+   insert(list <T, A, Finger> ::iterator it,
    T && data)
 {
    Node* pNew = new Node(std::move(data));
@@ -705,6 +1040,7 @@ typename list <T, A> ::iterator list <T, A> ::
    }
    else if (it != end())
    {
+      fingerBeforeInsert(it.p);
       pNew->pPrev = it.p->pPrev;
       pNew->pNext = it.p;
 
@@ -725,6 +1061,359 @@ typename list <T, A> ::iterator list <T, A> ::
       return end();
 }
 
+/******************************************
+ * LIST :: INSERT AT
+ * add an item so that it ends up at index i,
+ * leaving the finger on it
+ *     INPUT  : the index, 0 through size()
+ *              data to be added to the list
+ *     OUTPUT : iterator to the new item
+ *     COST   : O(distance from the nearest of head, tail, finger)
+ ******************************************/
+template <typename T, typename A, bool Finger>
+typename list <T, A, Finger> :: iterator list <T, A, Finger> ::
+   insert_at(size_t i, const T & data)
+{
+   assert(i <= numElements);
+   iterator it = insert(position(i), data);
+   setFinger(it.p, i);
+   return it;
+}
+
+template <typename T, typename A, bool Finger>
+typename list <T, A, Finger> :: iterator list <T, A, Finger> ::
+   insert_at(size_t i, T && data)
+{
+   assert(i <= numElements);
+   iterator it = insert(position(i), std::move(data));
+   setFinger(it.p, i);
+   return it;
+}
+
+/******************************************
+ * LIST :: ERASE AT
+ * remove the item at index i, leaving the finger
+ * on the item that takes its place
+ *     INPUT  : the index, less than size()
+ *     OUTPUT : iterator to the item after it
+ *     COST   : O(distance from the nearest of head, tail, finger)
+ ******************************************/
+template <typename T, typename A, bool Finger>
+typename list <T, A, Finger> :: iterator list <T, A, Finger> :: erase_at(size_t i)
+{
+   assert(i < numElements);
+   return erase(position(i));
+}
+
+/******************************************
+ * LIST :: UNLINK RANGE
+ * detach the nodes pFirst through pLast, inclusive,
+ * leaving them as a chain that belongs to no list
+ *     INPUT  : the first and last node of the range
+ *     OUTPUT :
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: unlinkRange(Node * pFirst, Node * pLast)
+{
+   dropFinger();
+   if (pFirst->pPrev)
+      pFirst->pPrev->pNext = pLast->pNext;
+   else
+      pHead = pLast->pNext;
+
+   if (pLast->pNext)
+      pLast->pNext->pPrev = pFirst->pPrev;
+   else
+      pTail = pFirst->pPrev;
+
+   pFirst->pPrev = nullptr;
+   pLast->pNext = nullptr;
+}
+
+/******************************************
+ * LIST :: LINK RANGE
+ * attach the chain pFirst through pLast in front of pPos
+ *     INPUT  : where the chain goes, nullptr for the end
+ *              the first and last node of the chain
+ *     OUTPUT :
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: linkRange(Node * pPos, Node * pFirst, Node * pLast)
+{
+   dropFinger();
+   Node * pBefore = pPos ? pPos->pPrev : pTail;
+   pFirst->pPrev = pBefore;
+   pLast->pNext = pPos;
+
+   if (pBefore)
+      pBefore->pNext = pFirst;
+   else
+      pHead = pFirst;
+
+   if (pPos)
+      pPos->pPrev = pLast;
+   else
+      pTail = pLast;
+}
+
+/******************************************
+ * LIST :: SPLICE
+ * move every node of rhs in front of it
+ *     INPUT  : where the nodes go
+ *              the list to take them from
+ *     OUTPUT :
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: splice(iterator it, list <T, A, Finger> & rhs)
+{
+   if (&rhs == this || rhs.empty())
+      return;
+
+   Node * pFirst = rhs.pHead;
+   Node * pLast  = rhs.pTail;
+   numElements += rhs.numElements;
+   rhs.pHead = rhs.pTail = nullptr;
+   rhs.numElements = 0;
+   rhs.dropFinger();
+   linkRange(it.p, pFirst, pLast);
+}
+
+/******************************************
+ * LIST :: SPLICE
+ * move one node of rhs in front of it
+ *     INPUT  : where the node goes
+ *              the list to take it from, which may be this one
+ *              the node to move
+ *     OUTPUT :
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: splice(iterator it, list <T, A, Finger> & rhs, iterator itRHS)
+{
+   Node * pMove = itRHS.p;
+   if (pMove == nullptr || pMove == it.p || (&rhs == this && pMove->pNext == it.p))
+      return;
+
+   rhs.unlinkRange(pMove, pMove);
+   rhs.numElements--;
+   linkRange(it.p, pMove, pMove);
+   numElements++;
+}
+
+/******************************************
+ * LIST :: SPLICE
+ * move the nodes [first, last) of rhs in front of it
+ *     INPUT  : where the nodes go
+ *              the list to take them from, which may be this one
+ *              the range to move, not containing it
+ *     OUTPUT :
+ *     COST   : O(1) within a list, otherwise O(distance)
+ *              to keep both sizes up to date
+ ******************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: splice(iterator it, list <T, A, Finger> & rhs,
+                           iterator first, iterator last)
+{
+   size_t count = 0;
+   if (&rhs != this)
+      for (Node * p = first.p; p != last.p; p = p->pNext)
+         count++;
+   splice(it, rhs, first, last, count);
+}
+
+/******************************************
+ * LIST :: SPLICE
+ * move the nodes [first, last) of rhs in front of
+ * it, when the caller already knows how many there are
+ *     INPUT  : where the nodes go
+ *              the list to take them from, which may be this one
+ *              the range to move, not containing it
+ *              the number of nodes in the range
+ *     OUTPUT :
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: splice(iterator it, list <T, A, Finger> & rhs,
+                           iterator first, iterator last, size_t count)
+{
+   if (first == last)
+      return;
+
+   Node * pFirst = first.p;
+   Node * pLast  = last.p ? last.p->pPrev : rhs.pTail;
+   if (&rhs == this)
+      count = 0;   // moving within a list leaves its size alone
+
+   rhs.unlinkRange(pFirst, pLast);
+   rhs.numElements -= count;
+   linkRange(it.p, pFirst, pLast);
+   numElements += count;
+}
+
+/******************************************
+ * LIST :: RELINK NEXT
+ * rebuild pNext from pPrev after a merge threw part
+ * way. Merging only rewires pNext, so pHead, pTail,
+ * and every pPrev still hold the order from before.
+ *     INPUT  :
+ *     OUTPUT :
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: relinkNext()
+{
+   Node * pFollowing = nullptr;
+   for (Node * p = pTail; p; p = p->pPrev)
+   {
+      p->pNext = pFollowing;
+      pFollowing = p;
+   }
+}
+
+/******************************************
+ * LIST :: MERGE CHAINS
+ * merge two sorted, nullptr-terminated chains linked
+ * through pNext only. Ties go to the left chain so
+ * the merge is stable.
+ *     INPUT  : the earlier chain, the later chain
+ *     OUTPUT : the head of the merged chain
+ *     COST   : O(n + m)
+ ******************************************/
+template <typename T, typename A, bool Finger>
+template <class Compare>
+typename list <T, A, Finger> :: Node * list <T, A, Finger> ::
+   mergeChains(Node * pLeft, Node * pRight, Compare & cmp)
+{
+   Node * pResult = nullptr;
+   Node ** ppLink = &pResult;
+   while (pLeft && pRight)
+   {
+      if (cmp(pRight->data, pLeft->data))
+      {
+         *ppLink = pRight;
+         pRight = pRight->pNext;
+      }
+      else
+      {
+         *ppLink = pLeft;
+         pLeft = pLeft->pNext;
+      }
+      ppLink = &(*ppLink)->pNext;
+   }
+   *ppLink = pLeft ? pLeft : pRight;
+   return pResult;
+}
+
+/******************************************
+ * LIST :: RELINK PREV
+ * rebuild pPrev and pTail after pNext has been rewired
+ *     INPUT  :
+ *     OUTPUT :
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, typename A, bool Finger>
+void list <T, A, Finger> :: relinkPrev()
+{
+   dropFinger();
+   Node * pPrevious = nullptr;
+   for (Node * p = pHead; p; p = p->pNext)
+   {
+      p->pPrev = pPrevious;
+      pPrevious = p;
+   }
+   pTail = pPrevious;
+}
+
+/******************************************
+ * LIST :: MERGE
+ * move every node of sorted rhs into this sorted list.
+ * If cmp throws, both lists are left as they were.
+ *     INPUT  : the list to take the nodes from
+ *              the ordering both lists are sorted by
+ *     OUTPUT :
+ *     COST   : O(n + m), no allocations
+ ******************************************/
+template <typename T, typename A, bool Finger>
+template <class Compare>
+void list <T, A, Finger> :: merge(list <T, A, Finger> & rhs, Compare cmp)
+{
+   if (&rhs == this || rhs.empty())
+      return;
+
+   try
+   {
+      pHead = mergeChains(pHead, rhs.pHead, cmp);
+   }
+   catch (...)
+   {
+      // cmp threw: put both lists back as they were
+      relinkNext();
+      rhs.relinkNext();
+      throw;
+   }
+   relinkPrev();
+   numElements += rhs.numElements;
+   rhs.pHead = rhs.pTail = nullptr;
+   rhs.numElements = 0;
+   rhs.dropFinger();
+}
+
+/******************************************
+ * LIST :: SORT
+ * stable bottom-up merge sort by relinking nodes.
+ * bins[i] holds a sorted run of 2^i nodes, so each
+ * node is merged O(log n) times and no data is copied.
+ * If cmp throws, the list is left in its old order.
+ *     INPUT  : the ordering to sort by
+ *     OUTPUT :
+ *     COST   : O(n log n), no allocations
+ ******************************************/
+template <typename T, typename A, bool Finger>
+template <class Compare>
+void list <T, A, Finger> :: sort(Compare cmp)
+{
+   if (numElements < 2)
+      return;
+
+   Node * bins[64] = {};
+   Node * pResult = nullptr;
+   try
+   {
+      Node * p = pHead;
+      while (p)
+      {
+         Node * pCarry = p;
+         p = p->pNext;
+         pCarry->pNext = nullptr;
+
+         size_t i = 0;
+         for (; bins[i]; i++)
+         {
+            pCarry = mergeChains(bins[i], pCarry, cmp);
+            bins[i] = nullptr;
+         }
+         bins[i] = pCarry;
+      }
+
+      // the higher bins hold the earlier nodes
+      for (size_t i = 0; i < 64; i++)
+         if (bins[i])
+            pResult = mergeChains(bins[i], pResult, cmp);
+   }
+   catch (...)
+   {
+      // cmp threw: the pPrev links still hold the original order
+      relinkNext();
+      throw;
+   }
+
+   pHead = pResult;
+   relinkPrev();
+}
+
 /**********************************************
  * LIST :: assignment operator - MOVE
  * Copy one list onto another
@@ -732,10 +1421,10 @@ typename list <T, A> ::iterator list <T, A> ::
  *     OUTPUT :
  *     COST   : O(n) with respect to the size of the LHS
  *********************************************/
-template <typename T, typename A>
-void swap(list <T, A> & lhs, list <T, A> & rhs)
+template <typename T, typename A, bool Finger>
+void swap(list <T, A, Finger> & lhs, list <T, A, Finger> & rhs)
 {
-   list <T, A> * pTemp = lhs;
+   list <T, A, Finger> * pTemp = lhs;
    lhs = rhs;
    rhs = pTemp;
 }
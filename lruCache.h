@@ -0,0 +1,295 @@
+/***********************************************************************
+ * Header:
+ *    LRU CACHE
+ * Summary:
+ *    A least-recently-used cache: a custom::list keeps the entries in
+ *    recency order, most recent at the front, and a custom::unordered_map
+ *    finds the list node for a key. A hit splices its node to the front,
+ *    which relinks four pointers and never frees or allocates, instead of
+ *    the erase followed by push_front that costs a free and a malloc on
+ *    every hit.
+ *
+ *    The cache is bounded by entry count, by bytes, or both. Bytes are
+ *    whatever the sizer says an entry weighs. When an insert pushes the
+ *    cache over either bound the victims are spliced off the tail into a
+ *    list of their own and handed to the eviction callback in one call.
+ *
+ *    This will contain the class definition of:
+ *        lru_cache        : A bounded key-value cache
+ *        lru_cache::entry : One cached key and value
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>       // for ASSERT
+#include <cstddef>       // for size_t
+#include <functional>    // for std::function, std::hash
+#include <limits>        // for std::numeric_limits
+#include <utility>       // for std::move
+#include "list.h"        // for custom::list
+#include "unorderedMap.h" // for custom::unordered_map
+
+class TestLruCache; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * LRU SIZEOF
+ * The default sizer: every entry weighs what its
+ * key and value take up inline
+ **************************************************/
+template <typename K, typename V>
+struct lru_sizeof
+{
+   size_t operator () (const K &, const V &) const { return sizeof(K) + sizeof(V); }
+};
+
+/**************************************************
+ * LRU CACHE
+ * get() and put() are O(1) on average; neither
+ * allocates when the key is already cached
+ **************************************************/
+template <typename K, typename V,
+          typename Sizer = lru_sizeof<K, V>,
+          typename Hash = std::hash<K>>
+class lru_cache
+{
+   friend class ::TestLruCache; // give unit tests access to the privates
+public:
+   // one cached element, as handed to the eviction callback
+   struct entry
+   {
+      entry(const K & key, const V & value, size_t bytes)
+      : key(key), value(value), bytes(bytes) {}
+      entry(const K & key, V && value, size_t bytes)
+      : key(key), value(std::move(value)), bytes(bytes) {}
+
+      K key;
+      V value;
+      size_t bytes;   // what the sizer said when it was stored
+   };
+   typedef std::function<void(list <entry> &)> evict_callback;
+
+   //
+   // Construct
+   //
+
+   lru_cache(size_t maxCount,
+             size_t maxBytes = std::numeric_limits<size_t>::max(),
+             const Sizer & sizer = Sizer())
+   : maxCount(maxCount), maxBytes(maxBytes), numBytes(0), sizer(sizer) {}
+   lru_cache(const lru_cache & rhs) = delete;
+   lru_cache & operator = (const lru_cache & rhs) = delete;
+
+   //
+   // Access
+   //
+
+   V * get(const K & key);
+   V * peek(const K & key);
+   bool contains(const K & key) { return index.contains(key); }
+
+   //
+   // Insert
+   //
+
+   void put(const K & key, const V &  value);
+   void put(const K & key,       V && value);
+
+   //
+   // Remove
+   //
+
+   bool erase(const K & key);
+   void clear();
+   void on_evict(const evict_callback & callback) { onEvict = callback; }
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return entries.empty(); }
+   size_t size() const { return entries.size();  }
+   size_t bytes() const { return numBytes; }
+   size_t max_count() const { return maxCount; }
+   size_t max_bytes() const { return maxBytes; }
+   void resize(size_t maxCount, size_t maxBytes = std::numeric_limits<size_t>::max());
+
+private:
+   typedef typename list <entry> :: iterator EntryIt;
+
+   void touch(EntryIt it) { entries.splice(entries.begin(), entries, it); }
+   template <typename U>
+   void store(const K & key, U && value);
+   void trim();
+
+   // member variables
+   list <entry> entries;                      // most recently used first
+   unordered_map <K, EntryIt, Hash> index;    // key to its node in entries
+   size_t maxCount;                           // most entries allowed
+   size_t maxBytes;                           // most bytes allowed
+   size_t numBytes;                           // bytes of every entry held
+   Sizer sizer;                               // weighs an entry
+   evict_callback onEvict;                    // told about victims, may be empty
+};
+
+/*********************************************
+ * LRU CACHE :: GET
+ * Look up key and mark it most recently used
+ *    INPUT  : the key
+ *    OUTPUT : its value, or nullptr on a miss. The
+ *             pointer lasts until the entry is evicted.
+ *    COST   : O(1) average
+ *********************************************/
+template <typename K, typename V, typename Sizer, typename Hash>
+V * lru_cache <K, V, Sizer, Hash> :: get(const K & key)
+{
+   typename unordered_map <K, EntryIt, Hash> :: iterator it = index.find(key);
+   if (it == index.end())
+      return nullptr;
+   touch(it->second);
+   return &(*it->second).value;
+}
+
+/*********************************************
+ * LRU CACHE :: PEEK
+ * Look up key without changing its recency
+ *    COST   : O(1) average
+ *********************************************/
+template <typename K, typename V, typename Sizer, typename Hash>
+V * lru_cache <K, V, Sizer, Hash> :: peek(const K & key)
+{
+   typename unordered_map <K, EntryIt, Hash> :: iterator it = index.find(key);
+   return it == index.end() ? nullptr : &(*it->second).value;
+}
+
+/*********************************************
+ * LRU CACHE :: PUT
+ * Store value under key as the most recently
+ * used entry, then evict whatever no longer fits.
+ * A value heavier than max_bytes() is evicted
+ * straight away.
+ *    COST   : O(1) average, plus the evictions
+ *********************************************/
+template <typename K, typename V, typename Sizer, typename Hash>
+void lru_cache <K, V, Sizer, Hash> :: put(const K & key, const V & value)
+{
+   store(key, value);
+   trim();
+}
+
+template <typename K, typename V, typename Sizer, typename Hash>
+void lru_cache <K, V, Sizer, Hash> :: put(const K & key, V && value)
+{
+   store(key, std::move(value));
+   trim();
+}
+
+/*********************************************
+ * LRU CACHE :: STORE
+ * Overwrite and touch an existing entry, or push
+ * a new one on the front
+ *    COST   : O(1) average
+ *********************************************/
+template <typename K, typename V, typename Sizer, typename Hash>
+template <typename U>
+void lru_cache <K, V, Sizer, Hash> :: store(const K & key, U && value)
+{
+   size_t weight = sizer(key, value);
+   typename unordered_map <K, EntryIt, Hash> :: iterator it = index.find(key);
+   if (it != index.end())
+   {
+      entry & e = *it->second;
+      numBytes = numBytes - e.bytes + weight;
+      e.value = std::forward<U>(value);
+      e.bytes = weight;
+      touch(it->second);
+      return;
+   }
+
+   entries.push_front(entry(key, std::forward<U>(value), weight));
+   index[key] = entries.begin();
+   numBytes += weight;
+}
+
+/*********************************************
+ * LRU CACHE :: ERASE
+ * Drop key without telling the eviction callback
+ *    OUTPUT : whether it was cached
+ *    COST   : O(1) average
+ *********************************************/
+template <typename K, typename V, typename Sizer, typename Hash>
+bool lru_cache <K, V, Sizer, Hash> :: erase(const K & key)
+{
+   typename unordered_map <K, EntryIt, Hash> :: iterator it = index.find(key);
+   if (it == index.end())
+      return false;
+   numBytes -= (*it->second).bytes;
+   entries.erase(it->second);
+   index.erase(it);
+   return true;
+}
+
+/*********************************************
+ * LRU CACHE :: CLEAR
+ * Drop everything without telling the callback
+ *    COST   : O(n)
+ *********************************************/
+template <typename K, typename V, typename Sizer, typename Hash>
+void lru_cache <K, V, Sizer, Hash> :: clear()
+{
+   entries.clear();
+   index.clear();
+   numBytes = 0;
+}
+
+/*********************************************
+ * LRU CACHE :: RESIZE
+ * Change the bounds, evicting if they shrank
+ *    COST   : O(evictions)
+ *********************************************/
+template <typename K, typename V, typename Sizer, typename Hash>
+void lru_cache <K, V, Sizer, Hash> :: resize(size_t maxCount, size_t maxBytes)
+{
+   this->maxCount = maxCount;
+   this->maxBytes = maxBytes;
+   trim();
+}
+
+/*********************************************
+ * LRU CACHE :: TRIM
+ * Walk back from the least recently used entry
+ * until the rest fits, unhook those keys from the
+ * index, and splice the whole run off in one go.
+ * The callback then sees every victim at once and
+ * may keep them by splicing them elsewhere.
+ *    COST   : O(evictions)
+ *********************************************/
+template <typename K, typename V, typename Sizer, typename Hash>
+void lru_cache <K, V, Sizer, Hash> :: trim()
+{
+   size_t numKeep = entries.size();
+   size_t bytesKeep = numBytes;
+   EntryIt itFirst = entries.end();
+   for (EntryIt it = entries.rbegin();
+        it != entries.end() && (numKeep > maxCount || bytesKeep > maxBytes);
+        --it)
+   {
+      bytesKeep -= (*it).bytes;
+      numKeep--;
+      index.erase((*it).key);
+      itFirst = it;
+   }
+   if (itFirst == entries.end())
+      return;
+
+   list <entry> victims;
+   victims.splice(victims.end(), entries, itFirst, entries.end());
+   numBytes = bytesKeep;
+   if (onEvict)
+      onEvict(victims);
+}
+
+}; // namespace custom
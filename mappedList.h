@@ -0,0 +1,536 @@
+/***********************************************************************
+ * Header:
+ *    MAPPED LIST
+ * Summary:
+ *    A doubly linked list whose nodes live in a memory-mapped file.
+ *    Reopening the file maps the list back in as it was: there is no
+ *    parse and no rebuild, so a list of millions of elements is ready
+ *    as soon as mmap returns.
+ *
+ *    The file may land at a different address every time it is mapped,
+ *    so nothing in it holds a raw pointer. Every link is an offset_ptr:
+ *    the distance from the link itself to its target. Two links in the
+ *    same mapping keep their distance wherever the mapping goes.
+ *
+ *        +--------+------+------+------+-- ... --+
+ *        | header | node | node | node |  spare  |
+ *        +--------+------+------+------+-- ... --+
+ *
+ *    The header records the element size, the count, the ends, a chain
+ *    of freed nodes, and how much of the file is in use. When the file
+ *    is full it doubles with ftruncate and is mapped again; that move
+ *    invalidates iterators, though the links stay valid. Elements are
+ *    copied as bytes, so T must be trivially copyable and must not hold
+ *    pointers of its own.
+ *
+ *    POSIX only: on Windows CUSTOM_MAPPED_LIST is not defined and this
+ *    header declares nothing.
+ *
+ *    This will contain the class definition of:
+ *        offset_ptr            : A pointer stored as a self-relative offset
+ *        mapped_list           : A list in a memory-mapped file
+ *        mapped_list::iterator : An iterator through it
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+#define CUSTOM_MAPPED_LIST
+#endif
+
+#ifdef CUSTOM_MAPPED_LIST
+
+#include <cassert>        // for ASSERT
+#include <cerrno>         // for errno
+#include <cstddef>        // for size_t
+#include <cstdint>        // for int64_t, uint64_t
+#include <new>            // for placement new
+#include <stdexcept>      // for std::runtime_error
+#include <string>         // for std::string
+#include <system_error>   // for std::system_error
+#include <type_traits>    // for std::is_trivially_copyable
+
+#include <fcntl.h>        // for open
+#include <sys/mman.h>     // for mmap, munmap, msync
+#include <sys/stat.h>     // for fstat
+#include <unistd.h>       // for ftruncate, close
+
+class TestMappedList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * OFFSET PTR
+ * The distance in bytes from this object to its
+ * target, 0 for nullptr. Copying re-aims the offset
+ * so the copy points at the same target.
+ **************************************************/
+template <typename T>
+class offset_ptr
+{
+   friend class ::TestMappedList; // give unit tests access to the privates
+public:
+   offset_ptr()                         : offset(0) {}
+   offset_ptr(T * p)                    { set(p); }
+   offset_ptr(const offset_ptr & rhs)   { set(rhs.get()); }
+   offset_ptr & operator = (const offset_ptr & rhs) { set(rhs.get()); return *this; }
+   offset_ptr & operator = (T * p)                  { set(p);         return *this; }
+
+   T * get() const
+   {
+      return offset ? reinterpret_cast <T *> (address() + offset) : nullptr;
+   }
+   T * operator -> () const { return get(); }
+   T & operator * () const  { return *get(); }
+   explicit operator bool () const { return offset != 0; }
+
+private:
+   intptr_t address() const { return reinterpret_cast <intptr_t> (this); }
+   void set(T * p) { offset = p ? reinterpret_cast <intptr_t> (p) - address() : 0; }
+
+   int64_t offset;   // target minus this, in bytes
+};
+
+/**************************************************
+ * MAPPED LIST
+ * The ends and iterators of custom::list, stored
+ * in the file at path
+ **************************************************/
+template <typename T>
+class mapped_list
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "mapped_list stores T as raw bytes in a file");
+   friend class ::TestMappedList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   mapped_list(const std::string & path, size_t numNodes = 1024);
+   mapped_list(const mapped_list &) = delete;
+   mapped_list & operator = (const mapped_list &) = delete;
+   ~mapped_list();
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin()  { return iterator(header()->pHead.get()); }
+   iterator rbegin() { return iterator(header()->pTail.get()); }
+   iterator end()    { return iterator(nullptr); }
+
+   //
+   // Access
+   //
+
+   T & front() { assert(!empty()); return header()->pHead->data; }
+   T & back()  { assert(!empty()); return header()->pTail->data; }
+
+   //
+   // Insert
+   //
+
+   void push_front(const T & data) { insert(begin(), data); }
+   void push_back (const T & data) { insert(end(),   data); }
+   iterator insert(iterator it, const T & data);
+
+   //
+   // Remove
+   //
+
+   void pop_front() { if (!empty()) erase(begin());  }
+   void pop_back()  { if (!empty()) erase(rbegin()); }
+   iterator erase(iterator it);
+   void clear();
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return header()->numElements == 0; }
+   size_t size() const { return (size_t)header()->numElements; }
+   size_t capacity() const;
+   void sync();
+
+private:
+   class Node;
+   struct Header;
+
+   static const uint64_t MAGIC = 0x5453494c50414d43;   // "CMAPLIST" in little-endian order
+   static const uint32_t VERSION = 1;
+
+   Header * header() const { return reinterpret_cast <Header *> (pBase); }
+   static size_t firstNode();
+   Node * allocNode();
+   void grow();
+   char * map(size_t numBytesNew);
+   void release();
+
+   // member variables
+   int fd;              // the open file
+   char * pBase;        // where the file is mapped
+   size_t numBytes;     // size of the file and of the mapping
+};
+
+/*************************************************
+ * NODE
+ * Links first, as in custom::list, but as offsets
+ *************************************************/
+template <typename T>
+class mapped_list <T> :: Node
+{
+public:
+   offset_ptr<Node> pNext;   // next node in list order
+   offset_ptr<Node> pPrev;   // previous node in list order
+   T data;                   // user data
+};
+
+/*************************************************
+ * HEADER
+ * The first bytes of the file
+ *************************************************/
+template <typename T>
+struct mapped_list <T> :: Header
+{
+   uint64_t magic;           // MAGIC, or this is not our file
+   uint32_t version;         // VERSION of the layout
+   uint32_t elementSize;     // sizeof(T) of the list that made the file
+   uint64_t numElements;     // how many nodes are linked
+   uint64_t used;            // bytes from the start of the file to the unused tail
+   offset_ptr<Node> pHead;   // first node in list order
+   offset_ptr<Node> pTail;   // last node in list order
+   offset_ptr<Node> pFree;   // chain of erased nodes through pNext
+};
+
+/*************************************************
+ * MAPPED LIST ITERATOR
+ * Valid until the next insert that grows the file
+ ************************************************/
+template <typename T>
+class mapped_list <T> :: iterator
+{
+   friend class ::TestMappedList; // give unit tests access to the privates
+   friend class custom::mapped_list <T>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator, fetch a node
+   T & operator * () { return p->data; }
+
+   // prefix increment
+   iterator & operator ++ () { p = p->pNext.get(); return *this; }
+
+   // postfix increment
+   iterator operator ++ (int) { iterator tmp = *this; ++*this; return tmp; }
+
+   // prefix decrement
+   iterator & operator -- () { p = p->pPrev.get(); return *this; }
+
+   // postfix decrement
+   iterator operator -- (int) { iterator tmp = *this; --*this; return tmp; }
+
+private:
+   iterator(Node * p) : p(p) {}
+
+   Node * p;   // the current node
+};
+
+/*****************************************
+ * MAPPED LIST :: CONSTRUCTOR
+ * Open the list stored at path, or create the
+ * file with room for numNodes if it is new or empty
+ *    INPUT  : the file and the starting capacity
+ *    COST   : O(1), no matter how long the list is
+ ****************************************/
+template <typename T>
+mapped_list <T> :: mapped_list(const std::string & path, size_t numNodes)
+: fd(-1), pBase(nullptr), numBytes(0)
+{
+   fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+   if (fd < 0)
+      throw std::system_error(errno, std::generic_category(), "mapped_list: open " + path);
+
+   // the destructor will not run if we throw, so give everything back here
+   try
+   {
+      struct stat status;
+      if (::fstat(fd, &status) != 0)
+         throw std::system_error(errno, std::generic_category(), "mapped_list: fstat");
+
+      if (status.st_size == 0)
+      {
+         // a new file: size it, then lay down an empty header
+         size_t numBytesNew = firstNode() + (numNodes ? numNodes : 1) * sizeof(Node);
+         if (::ftruncate(fd, (off_t)numBytesNew) != 0)
+            throw std::system_error(errno, std::generic_category(), "mapped_list: ftruncate");
+         pBase = map(numBytesNew);
+         numBytes = numBytesNew;
+         Header * pHeader = new (pBase) Header;
+         pHeader->magic = MAGIC;
+         pHeader->version = VERSION;
+         pHeader->elementSize = sizeof(T);
+         pHeader->numElements = 0;
+         pHeader->used = firstNode();
+      }
+      else
+      {
+         // an existing file: map it and check it holds a list of T
+         if ((size_t)status.st_size < firstNode())
+            throw std::runtime_error("mapped_list: file is too small to hold a list");
+         pBase = map((size_t)status.st_size);
+         numBytes = (size_t)status.st_size;
+         const Header * pHeader = header();
+         if (pHeader->magic != MAGIC || pHeader->version != VERSION)
+            throw std::runtime_error("mapped_list: not a mapped list file");
+         if (pHeader->elementSize != sizeof(T))
+            throw std::runtime_error("mapped_list: element size does not match");
+         if (pHeader->used < firstNode() || pHeader->used > numBytes)
+            throw std::runtime_error("mapped_list: header is corrupt");
+      }
+   }
+   catch (...)
+   {
+      release();
+      throw;
+   }
+}
+
+/*****************************************
+ * MAPPED LIST :: DESTRUCTOR
+ * Unmap and close; the kernel writes back the
+ * pages. Call sync() first to wait for the disk.
+ ****************************************/
+template <typename T>
+mapped_list <T> :: ~mapped_list()
+{
+   release();
+}
+
+/*********************************************
+ * MAPPED LIST :: INSERT
+ * Take a node from the free chain or the spare
+ * tail of the file and link it in front of it
+ *    INPUT  : where it goes and the value
+ *    OUTPUT : the new element
+ *    COST   : O(1), amortized over the doublings
+ *********************************************/
+template <typename T>
+typename mapped_list <T> :: iterator
+mapped_list <T> :: insert(iterator it, const T & data)
+{
+   // the file may move, so hold on to offsets rather than addresses
+   T copy = data;
+   size_t offsetNext = it.p ? reinterpret_cast <char *> (it.p) - pBase : 0;
+
+   Node * pNew = allocNode();
+   Header * pHeader = header();
+   Node * pNext = offsetNext ? reinterpret_cast <Node *> (pBase + offsetNext) : nullptr;
+   Node * pPrev = pNext ? pNext->pPrev.get() : pHeader->pTail.get();
+
+   pNew->data = copy;
+   pNew->pNext = pNext;
+   pNew->pPrev = pPrev;
+   if (pPrev)
+      pPrev->pNext = pNew;
+   else
+      pHeader->pHead = pNew;
+   if (pNext)
+      pNext->pPrev = pNew;
+   else
+      pHeader->pTail = pNew;
+   pHeader->numElements++;
+   return iterator(pNew);
+}
+
+/*********************************************
+ * MAPPED LIST :: ERASE
+ * Unlink a node and put it on the free chain
+ *    INPUT  : the element to remove
+ *    OUTPUT : the element that followed it
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+typename mapped_list <T> :: iterator
+mapped_list <T> :: erase(iterator it)
+{
+   Node * pErase = it.p;
+   assert(pErase);
+   Header * pHeader = header();
+   Node * pNext = pErase->pNext.get();
+   Node * pPrev = pErase->pPrev.get();
+   if (pPrev)
+      pPrev->pNext = pNext;
+   else
+      pHeader->pHead = pNext;
+   if (pNext)
+      pNext->pPrev = pPrev;
+   else
+      pHeader->pTail = pPrev;
+
+   pErase->pPrev = nullptr;
+   pErase->pNext = pHeader->pFree.get();
+   pHeader->pFree = pErase;
+   pHeader->numElements--;
+   return iterator(pNext);
+}
+
+/*********************************************
+ * MAPPED LIST :: CLEAR
+ * Forget every node at once; the file keeps its
+ * size for the nodes to come
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+void mapped_list <T> :: clear()
+{
+   Header * pHeader = header();
+   pHeader->pHead = nullptr;
+   pHeader->pTail = nullptr;
+   pHeader->pFree = nullptr;
+   pHeader->numElements = 0;
+   pHeader->used = firstNode();
+}
+
+/*********************************************
+ * MAPPED LIST :: CAPACITY
+ * How many nodes fit before the file grows
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+size_t mapped_list <T> :: capacity() const
+{
+   return (numBytes - firstNode()) / sizeof(Node);
+}
+
+/*********************************************
+ * MAPPED LIST :: SYNC
+ * Wait until every change is on the disk
+ *    COST   : O(dirty pages)
+ *********************************************/
+template <typename T>
+void mapped_list <T> :: sync()
+{
+   if (::msync(pBase, numBytes, MS_SYNC) != 0)
+      throw std::system_error(errno, std::generic_category(), "mapped_list: msync");
+}
+
+/*********************************************
+ * MAPPED LIST :: FIRST NODE
+ * The header rounded up to the node alignment
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+size_t mapped_list <T> :: firstNode()
+{
+   return (sizeof(Header) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+}
+
+/*********************************************
+ * MAPPED LIST :: ALLOCATE NODE
+ * A freed node if there is one, else the next
+ * unused one, doubling the file when none is left
+ *    OUTPUT : an unlinked node; every earlier
+ *             address may have moved
+ *    COST   : O(1), O(n) when the file doubles
+ *********************************************/
+template <typename T>
+typename mapped_list <T> :: Node * mapped_list <T> :: allocNode()
+{
+   Header * pHeader = header();
+   if (pHeader->pFree)
+   {
+      Node * pNode = pHeader->pFree.get();
+      pHeader->pFree = pNode->pNext.get();
+      return pNode;
+   }
+
+   if (pHeader->used + sizeof(Node) > numBytes)
+   {
+      grow();
+      pHeader = header();
+   }
+   Node * pNode = new (pBase + pHeader->used) Node;
+   pHeader->used += sizeof(Node);
+   return pNode;
+}
+
+/*********************************************
+ * MAPPED LIST :: GROW
+ * Double the file and map it again. The links
+ * are offsets, so nothing inside needs fixing.
+ * If mmap fails the old mapping is kept.
+ *    COST   : O(1) system calls, the new pages
+ *             are only touched as they are used
+ *********************************************/
+template <typename T>
+void mapped_list <T> :: grow()
+{
+   size_t numBytesNew = firstNode() + (capacity() ? 2 * capacity() : 1) * sizeof(Node);
+   if (::ftruncate(fd, (off_t)numBytesNew) != 0)
+      throw std::system_error(errno, std::generic_category(), "mapped_list: ftruncate");
+
+   // map the bigger file before letting go of the old mapping, so a
+   // failed mmap leaves the list exactly as it was
+   char * pBaseNew;
+   try
+   {
+      pBaseNew = map(numBytesNew);
+   }
+   catch (...)
+   {
+      // best effort: a longer file is only spare room on the next open
+      int ignored = ::ftruncate(fd, (off_t)numBytes);
+      (void)ignored;
+      throw;
+   }
+   ::munmap(pBase, numBytes);
+   pBase = pBaseNew;
+   numBytes = numBytesNew;
+}
+
+/*********************************************
+ * MAPPED LIST :: MAP
+ * Map the first numBytesNew bytes of the file
+ *    OUTPUT : where they were mapped
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+char * mapped_list <T> :: map(size_t numBytesNew)
+{
+   void * p = ::mmap(nullptr, numBytesNew, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (p == MAP_FAILED)
+      throw std::system_error(errno, std::generic_category(), "mapped_list: mmap");
+   return static_cast <char *> (p);
+}
+
+/*********************************************
+ * MAPPED LIST :: RELEASE
+ * Give back the mapping and the file
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+void mapped_list <T> :: release()
+{
+   if (pBase)
+      ::munmap(pBase, numBytes);
+   if (fd >= 0)
+      ::close(fd);
+   pBase = nullptr;
+   fd = -1;
+}
+
+}; // namespace custom
+
+#endif // CUSTOM_MAPPED_LIST
@@ -0,0 +1,213 @@
+/***********************************************************************
+ * Header:
+ *    MPSC LIST
+ * Summary:
+ *    A singly linked queue for many producers and one consumer.
+ *    Producers append with a single atomic exchange on the tail, so
+ *    push_back is wait-free no matter how many threads are pushing.
+ *    The consumer owns the head outright and needs no atomic
+ *    read-modify-write at all: drain() walks the published items and
+ *    hands each to a callback in place.
+ *
+ *    The list always holds one dummy node at the head. Popping moves
+ *    the data out of the node after the dummy, frees the dummy, and
+ *    lets the popped node become the new dummy.
+ *
+ *    This will contain the class definition of:
+ *        mpsc_list : A multi-producer, single-consumer queue
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <atomic>      // for std::atomic
+#include <cstddef>     // for size_t
+#include <limits>      // for std::numeric_limits
+#include <utility>     // for std::move
+#include "list.h"      // for custom::list
+
+class TestMpscList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * MPSC LIST
+ * push_back may be called from any thread. The
+ * remaining methods belong to the single consumer.
+ **************************************************/
+template <typename T>
+class mpsc_list
+{
+   friend class ::TestMpscList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   mpsc_list() : pHead(&stub), pTail(&stub) {}
+   mpsc_list(const mpsc_list & rhs) = delete;
+   mpsc_list & operator = (const mpsc_list & rhs) = delete;
+   ~mpsc_list();
+
+   //
+   // Insert (any thread)
+   //
+
+   void push_back(const T &  data) { link(new Node(data));            }
+   void push_back(      T && data) { link(new Node(std::move(data))); }
+
+   //
+   // Remove (consumer only)
+   //
+
+   bool pop_front(T & data);
+   size_t pop_batch(list <T> & out,
+                    size_t max = std::numeric_limits<size_t>::max());
+   template <class Function>
+   size_t drain(Function f, size_t max = std::numeric_limits<size_t>::max());
+
+   //
+   // Status (consumer only)
+   //
+
+   bool empty() const { return pHead->pNext.load(std::memory_order_acquire) == nullptr; }
+
+private:
+   // nested linked list classes: a Link is a Node without data so
+   // the very first dummy does not need a default-constructed T
+   class Link
+   {
+   public:
+      Link() : pNext(nullptr) {}
+      std::atomic<Link *> pNext; // pointer to next node
+   };
+   class Node;
+
+   void link(Link * pNew);
+   void unlinkHead(Link * pNext);
+
+   // member variables
+   Link stub;                 // dummy head before anything was popped
+   Link * pHead;              // dummy node, owned by the consumer
+   alignas(64) std::atomic<Link *> pTail; // last node, shared by producers
+};
+
+/*************************************************
+ * NODE
+ * A link that carries user data, laid out like
+ * list::Node minus the back pointer
+ *************************************************/
+template <typename T>
+class mpsc_list <T> :: Node : public mpsc_list <T> :: Link
+{
+public:
+   Node(const T &  data) : data(data)            {}
+   Node(      T && data) : data(std::move(data)) {}
+
+   T data;             // user data
+};
+
+/*****************************************
+ * MPSC LIST :: DESTRUCTOR
+ * No producer may be pushing any more
+ ****************************************/
+template <typename T>
+mpsc_list <T> :: ~mpsc_list()
+{
+   while (pHead->pNext.load(std::memory_order_relaxed) != nullptr)
+      unlinkHead(pHead->pNext.load(std::memory_order_relaxed));
+   if (pHead != &stub)
+      delete static_cast <Node *> (pHead);
+}
+
+/*********************************************
+ * MPSC LIST :: LINK
+ * Append a node: one exchange and one store
+ *    COST   : O(1), wait-free
+ *********************************************/
+template <typename T>
+void mpsc_list <T> :: link(Link * pNew)
+{
+   Link * pPrev = pTail.exchange(pNew, std::memory_order_acq_rel);
+   // between the exchange and this store the chain is briefly broken;
+   // the consumer simply sees the queue end at pPrev until it lands
+   pPrev->pNext.store(pNew, std::memory_order_release);
+}
+
+/*********************************************
+ * MPSC LIST :: UNLINK HEAD
+ * Retire the dummy so pNext becomes the dummy
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+void mpsc_list <T> :: unlinkHead(Link * pNext)
+{
+   if (pHead != &stub)
+      delete static_cast <Node *> (pHead);
+   pHead = pNext;
+}
+
+/*********************************************
+ * MPSC LIST :: POP FRONT
+ * remove an item from the front of the list
+ *    INPUT  : where to put the removed item
+ *    OUTPUT : false if nothing has been published
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+bool mpsc_list <T> :: pop_front(T & data)
+{
+   Link * pNext = pHead->pNext.load(std::memory_order_acquire);
+   if (pNext == nullptr)
+      return false;
+   data = std::move(static_cast <Node *> (pNext)->data);
+   unlinkHead(pNext);
+   return true;
+}
+
+/*********************************************
+ * MPSC LIST :: DRAIN
+ * Hand every published item to f, oldest first
+ *    INPUT  : function taking a T &&
+ *             maximum number of items to take
+ *    OUTPUT : number of items taken
+ *    COST   : O(n)
+ *********************************************/
+template <typename T>
+template <class Function>
+size_t mpsc_list <T> :: drain(Function f, size_t max)
+{
+   size_t count = 0;
+   Link * pNext;
+   while (count < max &&
+          (pNext = pHead->pNext.load(std::memory_order_acquire)) != nullptr)
+   {
+      f(std::move(static_cast <Node *> (pNext)->data));
+      unlinkHead(pNext);
+      count++;
+   }
+   return count;
+}
+
+/*********************************************
+ * MPSC LIST :: POP BATCH
+ * Move every published item onto the back of out.
+ * The queue nodes cannot be relinked into a list,
+ * whose nodes have a back pointer and a plain next,
+ * so each item is moved into a new node of out and
+ * its queue node is freed: an allocation and a free
+ * per item. Use drain() to avoid both.
+ *    INPUT  : list to receive the items
+ *             maximum number of items to take
+ *    OUTPUT : number of items taken
+ *    COST   : O(n) allocations
+ *********************************************/
+template <typename T>
+size_t mpsc_list <T> :: pop_batch(list <T> & out, size_t max)
+{
+   return drain([&out](T && data) { out.push_back(std::move(data)); }, max);
+}
+
+}; // namespace custom
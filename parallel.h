@@ -0,0 +1,281 @@
+/***********************************************************************
+ * Header:
+ *    PARALLEL
+ * Summary:
+ *    Algorithms that spread the work of visiting a custom::list over
+ *    several threads. A linked list cannot be split by index, so each
+ *    algorithm walks the list once to find where every segment begins
+ *    and then hands one segment to each thread.
+ *
+ *    This will contain the definition of:
+ *        parallel_for_each  : call a function on every element
+ *        parallel_transform : replace every element with f(element)
+ *        parallel_sort      : merge sort chunks on several threads
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cstddef>     // for size_t
+#include <exception>   // for std::exception_ptr
+#include <thread>      // for std::thread
+#include <vector>      // for std::vector
+#include "list.h"      // for custom::list
+
+namespace custom
+{
+
+/**************************************************
+ * SEGMENT
+ * A run of count elements starting at it
+ **************************************************/
+template <typename T, typename A, bool Finger = false>
+struct segment
+{
+   typename list <T, A, Finger> :: iterator it;
+   size_t count;
+};
+
+/*********************************************
+ * PARTITION SEGMENTS
+ * Cut a list into at most numSegments runs of
+ * nearly equal length with one walk of the list
+ *    INPUT  : the list and the desired number of segments
+ *    OUTPUT : the segments in list order
+ *    COST   : O(n)
+ *********************************************/
+template <typename T, typename A, bool Finger>
+std::vector<segment<T, A, Finger>> partition_segments(list <T, A, Finger> & l,
+                                                      size_t numSegments)
+{
+   std::vector<segment<T, A, Finger>> segments;
+   if (l.empty() || numSegments == 0)
+      return segments;
+   if (numSegments > l.size())
+      numSegments = l.size();
+
+   // the first (size % numSegments) segments get one extra element
+   size_t base  = l.size() / numSegments;
+   size_t extra = l.size() % numSegments;
+   typename list <T, A, Finger> :: iterator it = l.begin();
+   for (size_t i = 0; i < numSegments; i++)
+   {
+      size_t count = base + (i < extra ? 1 : 0);
+      segments.push_back(segment<T, A, Finger>{ it, count });
+      for (size_t j = 0; j < count; j++)
+         ++it;
+   }
+   return segments;
+}
+
+/*********************************************
+ * DEFAULT NUM THREADS
+ * One thread per core, or one if that is unknown
+ *********************************************/
+inline size_t defaultNumThreads()
+{
+   size_t num = std::thread::hardware_concurrency();
+   return num ? num : 1;
+}
+
+/*********************************************
+ * JOIN ALL
+ * Wait for every thread that is still running
+ *********************************************/
+inline void join_all(std::vector<std::thread> & threads)
+{
+   for (std::thread & thread : threads)
+      if (thread.joinable())
+         thread.join();
+}
+
+/*********************************************
+ * FOR EACH SEGMENT
+ * Run visit(segment) on its own thread for every
+ * segment, the last on the calling thread. The
+ * first exception thrown by any thread is
+ * rethrown once all of them have finished. If a
+ * thread cannot be started, the ones that were
+ * are joined and the std::system_error rethrown.
+ *********************************************/
+template <typename T, typename A, bool Finger, class Visit>
+void for_each_segment(list <T, A, Finger> & l, size_t numThreads, Visit visit)
+{
+   std::vector<segment<T, A, Finger>> segments = partition_segments(l, numThreads);
+   if (segments.empty())
+      return;
+
+   std::vector<std::exception_ptr> errors(segments.size());
+   auto work = [&segments, &errors, &visit](size_t i)
+   {
+      try
+      {
+         visit(segments[i]);
+      }
+      catch (...)
+      {
+         errors[i] = std::current_exception();
+      }
+   };
+
+   std::vector<std::thread> threads;
+   try
+   {
+      for (size_t i = 0; i + 1 < segments.size(); i++)
+         threads.emplace_back(work, i);
+   }
+   catch (...)
+   {
+      // destroying a joinable thread would terminate
+      join_all(threads);
+      throw;
+   }
+   work(segments.size() - 1);
+   join_all(threads);
+
+   for (std::exception_ptr & error : errors)
+      if (error)
+         std::rethrow_exception(error);
+}
+
+/*********************************************
+ * PARALLEL FOR EACH
+ * Call f on every element of the list. f must be
+ * safe to call from several threads at once.
+ *    INPUT  : the list, the function, the number of threads
+ *    COST   : O(n) walk plus O(n / numThreads) calls per thread
+ *********************************************/
+template <typename T, typename A, bool Finger, class Function>
+void parallel_for_each(list <T, A, Finger> & l, Function f,
+                       size_t numThreads = defaultNumThreads())
+{
+   for_each_segment(l, numThreads, [&f](segment<T, A, Finger> & seg)
+   {
+      typename list <T, A, Finger> :: iterator it = seg.it;
+      for (size_t i = 0; i < seg.count; i++, ++it)
+         f(*it);
+   });
+}
+
+/*********************************************
+ * PARALLEL TRANSFORM
+ * Replace every element with f(element)
+ *    INPUT  : the list, the function, the number of threads
+ *    COST   : O(n) walk plus O(n / numThreads) calls per thread
+ *********************************************/
+template <typename T, typename A, bool Finger, class Function>
+void parallel_transform(list <T, A, Finger> & l, Function f,
+                        size_t numThreads = defaultNumThreads())
+{
+   for_each_segment(l, numThreads, [&f](segment<T, A, Finger> & seg)
+   {
+      typename list <T, A, Finger> :: iterator it = seg.it;
+      for (size_t i = 0; i < seg.count; i++, ++it)
+         *it = f(*it);
+   });
+}
+
+/*********************************************
+ * FAILED
+ * Whether any thread has stored an exception
+ *********************************************/
+inline bool failed(const std::vector<std::exception_ptr> & errors)
+{
+   for (const std::exception_ptr & error : errors)
+      if (error)
+         return true;
+   return false;
+}
+
+/*********************************************
+ * PARALLEL SORT
+ * Cut the list into one chunk per thread, sort the
+ * chunks at the same time, then merge neighboring
+ * chunks pairwise in rounds until one remains. Every
+ * step relinks nodes; no element is copied or moved.
+ * The result is stable. If cmp throws, or a thread
+ * cannot be started, the first exception is
+ * rethrown after every thread has joined, with
+ * every element still in the list.
+ *    INPUT  : the list, the ordering, the number of threads
+ *    COST   : O(n log(n / numThreads) / numThreads + n)
+ *********************************************/
+template <typename T, typename A, bool Finger, class Compare>
+void parallel_sort(list <T, A, Finger> & l, Compare cmp,
+                   size_t numThreads = defaultNumThreads())
+{
+   // below this a thread costs more than it saves
+   const size_t minChunk = 4096;
+   if (numThreads > l.size() / minChunk)
+      numThreads = l.size() / minChunk;
+   if (numThreads < 2)
+   {
+      l.sort(cmp);
+      return;
+   }
+
+   // splice every segment into a chunk of its own, back to front so
+   // that the end of each segment is the end of what is left of l
+   std::vector<segment<T, A, Finger>> segments = partition_segments(l, numThreads);
+   std::vector<list <T, A, Finger>> chunks(segments.size());
+   for (size_t i = segments.size(); i-- > 0; )
+      chunks[i].splice(chunks[i].end(), l, segments[i].it, l.end());
+
+   // as in for_each_segment, a worker's exception waits for every join
+   std::vector<std::exception_ptr> errors(chunks.size());
+   auto guard = [&errors](size_t i, auto work)
+   {
+      try
+      {
+         work();
+      }
+      catch (...)
+      {
+         errors[i] = std::current_exception();
+      }
+   };
+   auto sortChunk = [&chunks, &cmp, &guard](size_t i)
+   {
+      guard(i, [&chunks, &cmp, i]() { chunks[i].sort(cmp); });
+   };
+   std::vector<std::thread> threads;
+   std::exception_ptr spawnError;
+   try
+   {
+      for (size_t i = 0; i + 1 < chunks.size(); i++)
+         threads.emplace_back(sortChunk, i);
+      sortChunk(chunks.size() - 1);
+      join_all(threads);
+
+      // each round merges chunk i + step into chunk i
+      for (size_t step = 1; step < chunks.size() && !failed(errors); step *= 2)
+      {
+         threads.clear();
+         for (size_t i = 0; i + step < chunks.size(); i += 2 * step)
+            threads.emplace_back([&chunks, &cmp, &guard, i, step]()
+            {
+               guard(i, [&chunks, &cmp, i, step]() { chunks[i].merge(chunks[i + step], cmp); });
+            });
+         join_all(threads);
+      }
+   }
+   catch (...)
+   {
+      // a thread could not be started; destroying the others joinable
+      // would terminate, so wait for them before giving up
+      join_all(threads);
+      spawnError = std::current_exception();
+   }
+
+   // sort and merge leave a chunk whole when cmp throws, so every
+   // element goes back to l before the first exception is rethrown
+   for (list <T, A, Finger> & chunk : chunks)
+      l.splice(l.end(), chunk);
+   if (spawnError)
+      std::rethrow_exception(spawnError);
+   for (std::exception_ptr & error : errors)
+      if (error)
+         std::rethrow_exception(error);
+}
+
+}; // namespace custom
@@ -0,0 +1,347 @@
+/***********************************************************************
+ * Header:
+ *    PERSISTENT LIST
+ * Summary:
+ *    An immutable singly linked list. Every "modification" returns a
+ *    new version and leaves the old one exactly as it was, so keeping
+ *    a history of versions costs only the nodes that actually differ.
+ *
+ *    Versions share structure: push_front and pop_front are O(1) and
+ *    share the whole of the old list, while insert and erase at index
+ *    i copy just the i nodes in front of the change and share the rest.
+ *    Each node counts how many versions and nodes point at it and is
+ *    freed when the last of them lets go. The counts are atomic, so
+ *    versions may be handed to other threads.
+ *
+ *    This will contain the class definition of:
+ *        persistent_list                 : An immutable, shareable list
+ *        persistent_list::const_iterator : A walk through one version
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <atomic>      // for std::atomic
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <initializer_list> // for std::initializer_list
+#include <utility>     // for std::move, std::swap
+
+class TestPersistentList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * PERSISTENT LIST
+ * A value: cheap to copy, never changes. Methods
+ * that would change it return the new version.
+ **************************************************/
+template <typename T>
+class persistent_list
+{
+   friend class ::TestPersistentList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   persistent_list() : numElements(0), pHead(nullptr) {}
+   persistent_list(const std::initializer_list<T> & il);
+   persistent_list(const persistent_list & rhs)
+   : numElements(rhs.numElements), pHead(acquire(rhs.pHead)) {}
+   persistent_list(persistent_list && rhs)
+   : numElements(rhs.numElements), pHead(rhs.pHead)
+   {
+      rhs.numElements = 0;
+      rhs.pHead = nullptr;
+   }
+   ~persistent_list() { release(pHead); }
+
+   //
+   // Assign
+   //
+
+   persistent_list & operator = (persistent_list rhs)
+   {
+      std::swap(numElements, rhs.numElements);
+      std::swap(pHead, rhs.pHead);
+      return *this;
+   }
+
+   //
+   // Iterator
+   //
+
+   class const_iterator;
+   const_iterator begin() const { return const_iterator(pHead);   }
+   const_iterator end()   const { return const_iterator(nullptr); }
+
+   //
+   // Access
+   //
+
+   const T & front() const { assert(pHead); return pHead->data; }
+   const T & at(size_t i) const;
+
+   //
+   // New versions
+   //
+
+   persistent_list push_front(const T &  data) const;
+   persistent_list push_front(      T && data) const;
+   persistent_list pop_front() const;
+   persistent_list insert(size_t i, const T & data) const;
+   persistent_list erase(size_t i) const;
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return pHead == nullptr; }
+   size_t size() const { return numElements;      }
+
+private:
+   // nested linked list class
+   class Node;
+
+   persistent_list(Node * pHead, size_t numElements)
+   : numElements(numElements), pHead(pHead) {}
+
+   static Node * acquire(Node * p);
+   static void release(Node * p);
+   Node * copyPrefix(size_t count, Node * pRest) const;
+
+   // member variables
+   size_t numElements;  // kept so size() need not walk the chain
+   Node * pHead;        // first node, shared with other versions
+};
+
+/*************************************************
+ * NODE
+ * Never changed once another version can see it
+ *************************************************/
+template <typename T>
+class persistent_list <T> :: Node
+{
+public:
+   Node(const T & data, Node * pNext) : data(data), refs(1), pNext(pNext) {}
+   Node(T && data, Node * pNext) : data(std::move(data)), refs(1), pNext(pNext) {}
+
+   const T data;                // user data
+   std::atomic<size_t> refs;    // versions and nodes pointing here
+   Node * pNext;                // pointer to next node, holds a reference
+};
+
+/*************************************************
+ * PERSISTENT LIST CONST ITERATOR
+ * Walk one version front to back
+ ************************************************/
+template <typename T>
+class persistent_list <T> :: const_iterator
+{
+   friend class ::TestPersistentList; // give unit tests access to the privates
+   friend class custom::persistent_list <T>;
+
+public:
+   // constructors, destructors, and assignment operator
+   const_iterator() : p(nullptr) {}
+
+   // equals, not equals operator
+   bool operator == (const const_iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const const_iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator, fetch a node
+   const T & operator * () const { return p->data; }
+
+   // prefix increment
+   const_iterator & operator ++ () { p = p->pNext; return *this; }
+
+   // postfix increment
+   const_iterator operator ++ (int) { const_iterator tmp = *this; p = p->pNext; return tmp; }
+
+private:
+   const_iterator(const Node * p) : p(p) {}
+
+   const Node * p;   // the current node
+};
+
+/*****************************************
+ * PERSISTENT LIST :: INITIALIZER LIST CONSTRUCTOR
+ * Build a fresh chain, nothing shared yet
+ ****************************************/
+template <typename T>
+persistent_list <T> :: persistent_list(const std::initializer_list<T> & il)
+: numElements(0), pHead(nullptr)
+{
+   Node ** ppLink = &pHead;
+   for (const T & item : il)
+   {
+      *ppLink = new Node(item, nullptr);
+      ppLink = &(*ppLink)->pNext;
+      numElements++;
+   }
+}
+
+/*********************************************
+ * PERSISTENT LIST :: AT
+ * The element at index i
+ *    COST   : O(i)
+ *********************************************/
+template <typename T>
+const T & persistent_list <T> :: at(size_t i) const
+{
+   assert(i < numElements);
+   Node * p = pHead;
+   while (i--)
+      p = p->pNext;
+   return p->data;
+}
+
+/*********************************************
+ * PERSISTENT LIST :: PUSH FRONT
+ * A new version with data in front of all of this
+ *    OUTPUT : the new version, sharing every node
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+persistent_list <T> persistent_list <T> :: push_front(const T & data) const
+{
+   Node * pNew = new Node(data, pHead);
+   acquire(pHead);   // only once nothing can throw
+   return persistent_list(pNew, numElements + 1);
+}
+
+template <typename T>
+persistent_list <T> persistent_list <T> :: push_front(T && data) const
+{
+   Node * pNew = new Node(std::move(data), pHead);
+   acquire(pHead);   // only once nothing can throw
+   return persistent_list(pNew, numElements + 1);
+}
+
+/*********************************************
+ * PERSISTENT LIST :: POP FRONT
+ * A new version without the first element
+ *    OUTPUT : the new version, sharing every node
+ *             after the first
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+persistent_list <T> persistent_list <T> :: pop_front() const
+{
+   if (empty())
+      return persistent_list();
+   return persistent_list(acquire(pHead->pNext), numElements - 1);
+}
+
+/*********************************************
+ * PERSISTENT LIST :: INSERT
+ * A new version with data at index i
+ *    INPUT  : where it goes, 0 through size()
+ *    OUTPUT : the new version, sharing everything
+ *             from the old index i on
+ *    COST   : O(i)
+ *********************************************/
+template <typename T>
+persistent_list <T> persistent_list <T> :: insert(size_t i, const T & data) const
+{
+   assert(i <= numElements);
+   Node * pRest = pHead;
+   for (size_t j = 0; j < i; j++)
+      pRest = pRest->pNext;
+
+   Node * pNew = new Node(data, pRest);
+   acquire(pRest);   // only once nothing can throw
+   return persistent_list(copyPrefix(i, pNew), numElements + 1);
+}
+
+/*********************************************
+ * PERSISTENT LIST :: ERASE
+ * A new version without the element at index i
+ *    INPUT  : which element, 0 through size() - 1
+ *    OUTPUT : the new version, sharing everything
+ *             after the old index i
+ *    COST   : O(i)
+ *********************************************/
+template <typename T>
+persistent_list <T> persistent_list <T> :: erase(size_t i) const
+{
+   assert(i < numElements);
+   Node * pRest = pHead;
+   for (size_t j = 0; j <= i; j++)
+      pRest = pRest->pNext;
+
+   return persistent_list(copyPrefix(i, acquire(pRest)), numElements - 1);
+}
+
+/*********************************************
+ * PERSISTENT LIST :: ACQUIRE
+ * Take one more reference to p
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+typename persistent_list <T> :: Node * persistent_list <T> :: acquire(Node * p)
+{
+   if (p)
+      p->refs.fetch_add(1, std::memory_order_relaxed);
+   return p;
+}
+
+/*********************************************
+ * PERSISTENT LIST :: RELEASE
+ * Drop a reference to p. Freeing a node drops its
+ * reference to the next one, so this walks down
+ * the chain until it reaches a node someone else
+ * still holds. A loop rather than recursion keeps
+ * a long history from overflowing the stack.
+ *    COST   : O(nodes freed)
+ *********************************************/
+template <typename T>
+void persistent_list <T> :: release(Node * p)
+{
+   while (p && p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+   {
+      Node * pDelete = p;
+      p = p->pNext;
+      delete pDelete;
+   }
+}
+
+/*********************************************
+ * PERSISTENT LIST :: COPY PREFIX
+ * Copy the first count nodes of this version and
+ * hang pRest after them. If a copy throws, the
+ * nodes made so far and the reference to pRest
+ * are released before the exception goes on.
+ *    INPUT  : how many nodes to copy
+ *             what follows them, already acquired
+ *    OUTPUT : the head of the new chain
+ *    COST   : O(count)
+ *********************************************/
+template <typename T>
+typename persistent_list <T> :: Node *
+persistent_list <T> :: copyPrefix(size_t count, Node * pRest) const
+{
+   // the chain always ends in pRest, so it is whole at every step
+   Node * pNewHead = pRest;
+   Node ** ppLink = &pNewHead;
+   Node * p = pHead;
+   try
+   {
+      for (size_t j = 0; j < count; j++, p = p->pNext)
+      {
+         *ppLink = new Node(p->data, pRest);
+         ppLink = &(*ppLink)->pNext;
+      }
+   }
+   catch (...)
+   {
+      release(pNewHead);
+      throw;
+   }
+   return pNewHead;
+}
+
+}; // namespace custom
@@ -0,0 +1,414 @@
+/***********************************************************************
+ * Header:
+ *    RCU LIST
+ * Summary:
+ *    A singly linked list for data that is read constantly and changed
+ *    rarely. Readers never lock and never perform an atomic
+ *    read-modify-write: they announce which epoch they started in with
+ *    a plain store and then follow pNext with acquire loads.
+ *
+ *    Writers take one mutex among themselves, publish new links with
+ *    release stores, and never free a node they unlink right away.
+ *    Instead the node is retired along with the current epoch, the
+ *    epoch is advanced, and the node is freed once every reader that
+ *    might have seen it has left its read-side critical section.
+ *
+ *    This will contain the class definition of:
+ *        rcu_list         : A read-copy-update list
+ *        rcu_list::reader : A registered reader, one per thread
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <atomic>      // for std::atomic
+#include <cstdint>     // for uint64_t
+#include <mutex>       // for std::mutex
+#include <thread>      // for std::this_thread::yield
+#include <utility>     // for std::pair
+#include <vector>      // for std::vector
+
+class TestRcuList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * RCU LIST
+ * Writers: push_front, push_back, remove, remove_if,
+ * clear. Readers: go through an rcu_list::reader.
+ **************************************************/
+template <typename T>
+class rcu_list
+{
+   friend class ::TestRcuList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   rcu_list() : pHead(nullptr), pTail(nullptr), numElements(0),
+                epoch(1), pSlots(nullptr) {}
+   rcu_list(const rcu_list & rhs) = delete;
+   rcu_list & operator = (const rcu_list & rhs) = delete;
+   ~rcu_list();
+
+   class reader;
+
+   //
+   // Insert (writers)
+   //
+
+   void push_front(const T & data);
+   void push_back (const T & data);
+
+   //
+   // Remove (writers)
+   //
+
+   template <class Predicate>
+   size_t remove_if(Predicate pred);
+   size_t remove(const T & data)
+   {
+      return remove_if([&data](const T & value) { return value == data; });
+   }
+   void clear() { remove_if([](const T &) { return true; }); }
+
+   //
+   // Reclaim (writers)
+   //
+
+   void reclaim();
+   void synchronize();
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return numElements.load() == 0; }
+   size_t size() const { return numElements.load();      }
+
+private:
+   // nested classes
+   class Node;
+   class Slot;
+
+   Slot * acquireSlot();
+   void retire(Node * p);
+   uint64_t oldestActive() const;
+
+   // member variables
+   std::atomic<Node *> pHead;        // first node, read by everyone
+   Node * pTail;                     // last node, writers only
+   std::atomic<size_t> numElements;  // number of linked nodes
+   std::mutex writeLock;             // serializes writers
+   std::atomic<uint64_t> epoch;      // advanced once per unlinking write
+   std::atomic<Slot *> pSlots;       // every reader slot ever created
+   std::vector<std::pair<Node *, uint64_t>> retired; // unlinked, not yet freed
+};
+
+/*************************************************
+ * NODE
+ * Data never changes once a node is published
+ *************************************************/
+template <typename T>
+class rcu_list <T> :: Node
+{
+public:
+   Node(const T & data) : data(data), pNext(nullptr) {}
+
+   const T data;               // user data
+   std::atomic<Node *> pNext;  // pointer to next node
+};
+
+/*************************************************
+ * SLOT
+ * Where one reader announces its epoch, 0 when it
+ * is not reading. Slots are recycled, never freed
+ * until the list is.
+ *************************************************/
+template <typename T>
+class alignas(64) rcu_list <T> :: Slot
+{
+public:
+   Slot() : epoch(0), inUse(true), pNext(nullptr) {}
+
+   std::atomic<uint64_t> epoch;  // the epoch the reader entered in
+   std::atomic<bool> inUse;      // owned by a reader
+   Slot * pNext;                 // next slot, immutable once published
+};
+
+/*************************************************
+ * RCU LIST READER
+ * A thread's registration with the list. Create
+ * one per reading thread and keep it around;
+ * lock() and unlock() bracket a read-side critical
+ * section and may nest.
+ ************************************************/
+template <typename T>
+class rcu_list <T> :: reader
+{
+   friend class ::TestRcuList; // give unit tests access to the privates
+public:
+   reader(rcu_list <T> & l) : l(l), pSlot(l.acquireSlot()), depth(0) {}
+   reader(const reader & rhs) = delete;
+   reader & operator = (const reader & rhs) = delete;
+   ~reader()
+   {
+      assert(depth == 0);
+      pSlot->inUse.store(false, std::memory_order_release);
+   }
+
+   // enter a read-side critical section: one store and a fence
+   void lock()
+   {
+      if (depth++ == 0)
+      {
+         pSlot->epoch.store(l.epoch.load(std::memory_order_acquire),
+                            std::memory_order_relaxed);
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+      }
+   }
+
+   // leave it: nodes we saw may now be freed
+   void unlock()
+   {
+      assert(depth > 0);
+      if (--depth == 0)
+         pSlot->epoch.store(0, std::memory_order_release);
+   }
+
+   // visit every element in order
+   template <class Function>
+   void for_each(Function f)
+   {
+      lock();
+      for (Node * p = l.pHead.load(std::memory_order_acquire); p;
+           p = p->pNext.load(std::memory_order_acquire))
+         f(p->data);
+      unlock();
+   }
+
+   // is this value in the list?
+   bool contains(const T & data)
+   {
+      bool found = false;
+      lock();
+      for (Node * p = l.pHead.load(std::memory_order_acquire); p && !found;
+           p = p->pNext.load(std::memory_order_acquire))
+         found = (p->data == data);
+      unlock();
+      return found;
+   }
+
+private:
+   rcu_list <T> & l;     // the list we read
+   Slot * pSlot;         // where we announce our epoch
+   int depth;            // nesting of lock()
+};
+
+/*****************************************
+ * RCU LIST :: DESTRUCTOR
+ * No reader may still be registered
+ ****************************************/
+template <typename T>
+rcu_list <T> :: ~rcu_list()
+{
+   Node * p = pHead.load();
+   while (p)
+   {
+      Node * pDelete = p;
+      p = p->pNext.load();
+      delete pDelete;
+   }
+   for (std::pair<Node *, uint64_t> & entry : retired)
+      delete entry.first;
+
+   Slot * pSlot = pSlots.load();
+   while (pSlot)
+   {
+      Slot * pDelete = pSlot;
+      pSlot = pSlot->pNext;
+      delete pDelete;
+   }
+}
+
+/*********************************************
+ * RCU LIST :: ACQUIRE SLOT
+ * Reuse a slot a departed reader left behind or
+ * publish a new one. This runs once per reader.
+ *    COST   : O(number of slots)
+ *********************************************/
+template <typename T>
+typename rcu_list <T> :: Slot * rcu_list <T> :: acquireSlot()
+{
+   for (Slot * p = pSlots.load(std::memory_order_acquire); p; p = p->pNext)
+   {
+      bool expected = false;
+      if (p->inUse.compare_exchange_strong(expected, true))
+         return p;
+   }
+
+   Slot * pNew = new Slot();
+   pNew->pNext = pSlots.load(std::memory_order_relaxed);
+   while (!pSlots.compare_exchange_weak(pNew->pNext, pNew,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed))
+      ;
+   return pNew;
+}
+
+/*********************************************
+ * RCU LIST :: PUSH FRONT
+ * Fully build the node, then publish it
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+void rcu_list <T> :: push_front(const T & data)
+{
+   Node * pNew = new Node(data);
+   std::lock_guard<std::mutex> guard(writeLock);
+   pNew->pNext.store(pHead.load(std::memory_order_relaxed), std::memory_order_relaxed);
+   pHead.store(pNew, std::memory_order_release);
+   if (pTail == nullptr)
+      pTail = pNew;
+   numElements++;
+}
+
+/*********************************************
+ * RCU LIST :: PUSH BACK
+ * Fully build the node, then publish it
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+void rcu_list <T> :: push_back(const T & data)
+{
+   Node * pNew = new Node(data);
+   std::lock_guard<std::mutex> guard(writeLock);
+   if (pTail)
+      pTail->pNext.store(pNew, std::memory_order_release);
+   else
+      pHead.store(pNew, std::memory_order_release);
+   pTail = pNew;
+   numElements++;
+}
+
+/*********************************************
+ * RCU LIST :: REMOVE IF
+ * Unlink every element matching pred. Readers
+ * already standing on an unlinked node still see
+ * its pNext, so they carry on undisturbed.
+ *    INPUT  : which elements to remove
+ *    OUTPUT : how many were removed
+ *    COST   : O(n)
+ *********************************************/
+template <typename T>
+template <class Predicate>
+size_t rcu_list <T> :: remove_if(Predicate pred)
+{
+   size_t count = 0;
+   {
+      std::lock_guard<std::mutex> guard(writeLock);
+      Node * pPrev = nullptr;
+      Node * p = pHead.load(std::memory_order_relaxed);
+      while (p)
+      {
+         Node * pNext = p->pNext.load(std::memory_order_relaxed);
+         if (pred(p->data))
+         {
+            if (pPrev)
+               pPrev->pNext.store(pNext, std::memory_order_release);
+            else
+               pHead.store(pNext, std::memory_order_release);
+            if (pTail == p)
+               pTail = pPrev;
+            retire(p);
+            count++;
+         }
+         else
+            pPrev = p;
+         p = pNext;
+      }
+      numElements -= count;
+      if (count)
+         epoch.fetch_add(1);
+   }
+   if (count)
+      reclaim();
+   return count;
+}
+
+/*********************************************
+ * RCU LIST :: RETIRE
+ * Remember an unlinked node and when it left
+ *********************************************/
+template <typename T>
+void rcu_list <T> :: retire(Node * p)
+{
+   retired.push_back(std::make_pair(p, epoch.load(std::memory_order_relaxed)));
+}
+
+/*********************************************
+ * RCU LIST :: OLDEST ACTIVE
+ * The smallest epoch any reader is still in, or
+ * UINT64_MAX if nobody is reading
+ *    COST   : O(number of slots)
+ *********************************************/
+template <typename T>
+uint64_t rcu_list <T> :: oldestActive() const
+{
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   uint64_t oldest = UINT64_MAX;
+   for (Slot * p = pSlots.load(std::memory_order_acquire); p; p = p->pNext)
+   {
+      uint64_t e = p->epoch.load(std::memory_order_acquire);
+      if (e != 0 && e < oldest)
+         oldest = e;
+   }
+   return oldest;
+}
+
+/*********************************************
+ * RCU LIST :: RECLAIM
+ * Free every retired node no reader can still see.
+ * A node retired in epoch e is safe once every
+ * active reader entered in a later epoch.
+ *    COST   : O(retired + number of slots)
+ *********************************************/
+template <typename T>
+void rcu_list <T> :: reclaim()
+{
+   std::lock_guard<std::mutex> guard(writeLock);
+   uint64_t oldest = oldestActive();
+   size_t kept = 0;
+   for (size_t i = 0; i < retired.size(); i++)
+      if (retired[i].second < oldest)
+         delete retired[i].first;
+      else
+         retired[kept++] = retired[i];
+   retired.resize(kept);
+}
+
+/*********************************************
+ * RCU LIST :: SYNCHRONIZE
+ * Wait until every node retired so far is freed
+ *    COST   : until the slowest current reader leaves
+ *********************************************/
+template <typename T>
+void rcu_list <T> :: synchronize()
+{
+   for (;;)
+   {
+      reclaim();
+      {
+         std::lock_guard<std::mutex> guard(writeLock);
+         if (retired.empty())
+            return;
+      }
+      std::this_thread::yield();
+   }
+}
+
+}; // namespace custom
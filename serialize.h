@@ -0,0 +1,311 @@
+/***********************************************************************
+ * Header:
+ *    SERIALIZE
+ * Summary:
+ *    Write a custom::list to a binary stream and read it back. The
+ *    format is a fixed header followed by the elements in list order:
+ *
+ *        magic         4 bytes  "CLST"
+ *        element size  4 bytes  sizeof(T), or 0 when elements vary
+ *        count         8 bytes  number of elements
+ *        payload       8 bytes  number of bytes that follow
+ *        elements      payload bytes
+ *
+ *    Integers are in the byte order of the machine, since a trivially
+ *    copyable element is written as its raw bytes. Neither side touches
+ *    the stream once per element: writes gather into a 64 KiB buffer
+ *    and go out a chunk at a time, and reads pull chunks the same way,
+ *    never past the payload, so several lists can share one stream.
+ *
+ *    A type says how it is written by specializing serializer, the way
+ *    node_layout is specialized for list nodes. Trivially copyable types
+ *    and std::string are handled here.
+ *
+ *    This will contain the definitions of:
+ *        serializer    : How one element is sized, written, and read
+ *        serial_writer : A buffered sink over an std::ostream
+ *        serial_reader : A buffered source over an std::istream
+ *        serialize     : Write a list
+ *        deserialize   : Read a list
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include "list.h"          // for custom::list
+
+#include <algorithm>       // for std::min
+#include <cstdint>         // for uint32_t, uint64_t
+#include <cstring>         // for std::memcpy
+#include <istream>         // for std::istream
+#include <new>             // for std::launder
+#include <ostream>         // for std::ostream
+#include <stdexcept>       // for std::runtime_error
+#include <string>          // for std::string
+#include <type_traits>     // for std::is_trivially_copyable
+#include <vector>          // for std::vector
+
+class TestSerialize; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * SERIAL WRITER
+ * Gathers small writes and hands the stream one
+ * chunk at a time
+ **************************************************/
+class serial_writer
+{
+   friend class ::TestSerialize; // give unit tests access to the privates
+public:
+   static constexpr size_t CHUNK = 64 * 1024;
+
+   serial_writer(std::ostream & out) : out(out), numBuffered(0), buffer(CHUNK) {}
+   ~serial_writer() { flush(); }
+
+   void write(const void * p, size_t numBytes);
+   void flush();
+
+private:
+   std::ostream & out;        // where full chunks go
+   size_t numBuffered;        // bytes waiting in buffer
+   std::vector<char> buffer;  // the chunk being filled
+};
+
+/**************************************************
+ * SERIAL READER
+ * Pulls chunks from the stream, but never more than
+ * the bytes it was told belong to it
+ **************************************************/
+class serial_reader
+{
+   friend class ::TestSerialize; // give unit tests access to the privates
+public:
+   serial_reader(std::istream & in, uint64_t numBytes)
+   : in(in), numLeft(numBytes), iNext(0), numBuffered(0),
+     buffer((size_t)std::min<uint64_t>(numBytes, serial_writer::CHUNK)) {}
+
+   void read(void * p, size_t numBytes);
+   uint64_t remaining() const { return numLeft + (numBuffered - iNext); }
+
+private:
+   void refill();
+
+   std::istream & in;         // where the chunks come from
+   uint64_t numLeft;          // payload bytes not yet pulled from the stream
+   size_t iNext;              // next unread byte in buffer
+   size_t numBuffered;        // bytes pulled into buffer
+   std::vector<char> buffer;  // the current chunk
+};
+
+/**************************************************
+ * SERIALIZER
+ * No default: a type must say how it is written
+ **************************************************/
+template <typename T, typename Enable = void>
+struct serializer;
+
+/**************************************************
+ * SERIALIZER : TRIVIALLY COPYABLE
+ * The raw bytes, all the same size
+ **************************************************/
+template <typename T>
+struct serializer <T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
+{
+   static const uint32_t fixedSize = sizeof(T);
+   static uint64_t size(const T &) { return sizeof(T); }
+   static void write(serial_writer & out, const T & value) { out.write(&value, sizeof(T)); }
+   static T read(serial_reader & in)
+   {
+      // T need not be default constructible: the bytes land in raw,
+      // suitably aligned storage and T is copied out of it
+      alignas(T) unsigned char buffer[sizeof(T)];
+      in.read(buffer, sizeof(T));
+      return *std::launder(reinterpret_cast <T *> (buffer));
+   }
+};
+
+/**************************************************
+ * SERIALIZER : STRING
+ * An 8 byte length, then the characters
+ **************************************************/
+template <>
+struct serializer <std::string>
+{
+   static const uint32_t fixedSize = 0;
+   static uint64_t size(const std::string & s) { return sizeof(uint64_t) + s.size(); }
+   static void write(serial_writer & out, const std::string & s)
+   {
+      uint64_t length = s.size();
+      out.write(&length, sizeof(length));
+      out.write(s.data(), s.size());
+   }
+   static std::string read(serial_reader & in)
+   {
+      uint64_t length;
+      in.read(&length, sizeof(length));
+      if (length > in.remaining())
+         throw std::runtime_error("deserialize: string runs past the payload");
+      std::string s((size_t)length, '\0');
+      in.read(&s[0], s.size());
+      return s;
+   }
+};
+
+/*********************************************
+ * SERIAL HEADER
+ * What comes before the elements
+ *********************************************/
+struct serial_header
+{
+   static const uint32_t MAGIC = 0x54534c43;   // "CLST" in little-endian order
+
+   uint32_t magic;
+   uint32_t elementSize;
+   uint64_t count;
+   uint64_t payload;
+};
+
+/*********************************************
+ * SERIAL WRITER :: WRITE
+ * Copy into the chunk, sending it when full. A
+ * write bigger than a chunk goes straight through.
+ *    INPUT  : the bytes and how many
+ *    COST   : O(numBytes)
+ *********************************************/
+inline void serial_writer :: write(const void * p, size_t numBytes)
+{
+   if (numBuffered + numBytes > CHUNK)
+   {
+      flush();
+      if (numBytes >= CHUNK)
+      {
+         out.write(static_cast <const char *> (p), numBytes);
+         return;
+      }
+   }
+   std::memcpy(buffer.data() + numBuffered, p, numBytes);
+   numBuffered += numBytes;
+}
+
+/*********************************************
+ * SERIAL WRITER :: FLUSH
+ * Send whatever is in the chunk
+ *    COST   : O(CHUNK)
+ *********************************************/
+inline void serial_writer :: flush()
+{
+   if (numBuffered)
+      out.write(buffer.data(), numBuffered);
+   numBuffered = 0;
+}
+
+/*********************************************
+ * SERIAL READER :: READ
+ * Copy out of the chunk, pulling the next one
+ * as each runs dry
+ *    INPUT  : where the bytes go and how many
+ *    COST   : O(numBytes)
+ *********************************************/
+inline void serial_reader :: read(void * p, size_t numBytes)
+{
+   char * pOut = static_cast <char *> (p);
+   while (numBytes)
+   {
+      if (iNext == numBuffered)
+         refill();
+      size_t numTaken = std::min(numBytes, numBuffered - iNext);
+      std::memcpy(pOut, buffer.data() + iNext, numTaken);
+      iNext += numTaken;
+      pOut += numTaken;
+      numBytes -= numTaken;
+   }
+}
+
+/*********************************************
+ * SERIAL READER :: REFILL
+ * Pull the next chunk of the payload
+ *    COST   : O(CHUNK)
+ *********************************************/
+inline void serial_reader :: refill()
+{
+   if (numLeft == 0)
+      throw std::runtime_error("deserialize: element runs past the payload");
+   size_t numWanted = (size_t)std::min<uint64_t>(numLeft, buffer.size());
+   in.read(buffer.data(), numWanted);
+   if ((size_t)in.gcount() != numWanted)
+      throw std::runtime_error("deserialize: stream ended early");
+   numLeft -= numWanted;
+   numBuffered = numWanted;
+   iNext = 0;
+}
+
+/*********************************************
+ * SERIALIZE
+ * Write the header, then every element in list
+ * order through one buffered writer
+ *    INPUT  : the list and where it goes
+ *    COST   : O(n), plus a sizing walk when the
+ *             elements are not all the same size
+ *********************************************/
+template <typename T, typename A>
+void serialize(const list <T, A> & l, std::ostream & out)
+{
+   typedef serializer<T> Format;
+   typedef typename list <T, A> :: const_iterator const_iterator;
+
+   serial_header header;
+   header.magic = serial_header::MAGIC;
+   header.elementSize = Format::fixedSize;
+   header.count = l.size();
+   if (Format::fixedSize)
+      header.payload = header.count * Format::fixedSize;
+   else
+   {
+      header.payload = 0;
+      for (const_iterator it = l.cbegin(); it != l.cend(); ++it)
+         header.payload += Format::size(*it);
+   }
+
+   serial_writer writer(out);
+   writer.write(&header, sizeof(header));
+   for (const_iterator it = l.cbegin(); it != l.cend(); ++it)
+      Format::write(writer, *it);
+}
+
+/*********************************************
+ * DESERIALIZE
+ * Check the header, then read exactly its payload
+ * and append each element as it is decoded
+ *    INPUT  : where the list comes from
+ *    OUTPUT : the list; throws std::runtime_error if
+ *             the stream does not hold one of T
+ *    COST   : O(n)
+ *********************************************/
+template <typename T, typename A = std::allocator<T>>
+list <T, A> deserialize(std::istream & in)
+{
+   typedef serializer<T> Format;
+
+   serial_header header;
+   in.read(reinterpret_cast <char *> (&header), sizeof(header));
+   if ((size_t)in.gcount() != sizeof(header))
+      throw std::runtime_error("deserialize: stream ended early");
+   if (header.magic != serial_header::MAGIC)
+      throw std::runtime_error("deserialize: not a serialized list");
+   if (header.elementSize != Format::fixedSize)
+      throw std::runtime_error("deserialize: element size does not match");
+   if (Format::fixedSize && header.payload != header.count * Format::fixedSize)
+      throw std::runtime_error("deserialize: payload does not match the count");
+
+   list <T, A> l;
+   serial_reader reader(in, header.payload);
+   for (uint64_t i = 0; i < header.count; i++)
+      l.push_back(Format::read(reader));
+   if (reader.remaining() != 0)
+      throw std::runtime_error("deserialize: payload does not match the count");
+   return l;
+}
+
+}; // namespace custom
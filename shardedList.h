@@ -0,0 +1,247 @@
+/***********************************************************************
+ * Header:
+ *    SHARDED LIST
+ * Summary:
+ *    A list split into independent custom::list shards so that threads
+ *    appending at the same time do not all fight over one pTail. Each
+ *    thread is hashed to a shard and appends there under that shard's
+ *    own lock, which is almost never contended. Each shard sits on its
+ *    own cache line so neighboring shards do not false-share.
+ *
+ *    Order is kept within a shard, so everything one thread appends
+ *    stays in the order it was appended. There is no order between
+ *    shards.
+ *
+ *    This will contain the class definition of:
+ *        sharded_list           : N custom::list shards
+ *        sharded_list::iterator : A walk over every shard in turn
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <functional>  // for std::hash
+#include <memory>      // for std::unique_ptr
+#include <mutex>       // for std::mutex
+#include <thread>      // for std::this_thread::get_id
+#include "list.h"      // for custom::list
+#include "parallel.h"  // for custom::defaultNumThreads
+
+class TestShardedList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * SHARDED LIST
+ * push_back and size are safe from any thread. The
+ * iterator and collapse expect appends to be done.
+ **************************************************/
+template <typename T, typename A = std::allocator<T>>
+class sharded_list
+{
+   friend class ::TestShardedList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   sharded_list(size_t numShards = defaultNumThreads())
+   : numShards(numShards ? numShards : 1), shards(new Shard[numShards ? numShards : 1]) {}
+   sharded_list(const sharded_list & rhs) = delete;
+   sharded_list & operator = (const sharded_list & rhs) = delete;
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin();
+   iterator end() { return iterator(this, numShards); }
+
+   //
+   // Insert
+   //
+
+   void push_back(const T &  data) { push_back(localShard(), data);            }
+   void push_back(      T && data) { push_back(localShard(), std::move(data)); }
+   void push_back(size_t iShard, const T & data)
+   {
+      Shard & shard = shards[iShard];
+      std::lock_guard<std::mutex> guard(shard.lock);
+      shard.l.push_back(data);
+   }
+   void push_back(size_t iShard, T && data)
+   {
+      Shard & shard = shards[iShard];
+      std::lock_guard<std::mutex> guard(shard.lock);
+      shard.l.push_back(std::move(data));
+   }
+
+   //
+   // Combine
+   //
+
+   template <class Function>
+   void for_each(Function f);
+   list <T, A> collapse();
+
+   //
+   // Status
+   //
+
+   size_t shard_count() const { return numShards; }
+   size_t localShard() const
+   {
+      return std::hash<std::thread::id>()(std::this_thread::get_id()) % numShards;
+   }
+   size_t size() const;
+   bool empty() const { return size() == 0; }
+
+private:
+   /*************************************************
+    * SHARD
+    * One list and the lock that guards it, alone on
+    * its cache line
+    *************************************************/
+   struct alignas(64) Shard
+   {
+      std::mutex lock;
+      list <T, A> l;
+   };
+
+   // member variables
+   size_t numShards;                 // how many shards there are
+   std::unique_ptr<Shard[]> shards;  // the shards themselves
+};
+
+/*************************************************
+ * SHARDED LIST ITERATOR
+ * Walk shard 0, then shard 1, and so on
+ ************************************************/
+template <typename T, typename A>
+class sharded_list <T, A> :: iterator
+{
+   friend class ::TestShardedList; // give unit tests access to the privates
+   friend class custom::sharded_list <T, A>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : pSharded(nullptr), iShard(0) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const
+   {
+      return iShard == rhs.iShard && it == rhs.it;
+   }
+   bool operator != (const iterator & rhs) const { return !(*this == rhs); }
+
+   // dereference operator, fetch a node
+   T & operator * () { return *it; }
+
+   // prefix increment
+   iterator & operator ++ ()
+   {
+      ++it;
+      skipEmpty();
+      return *this;
+   }
+
+   // postfix increment
+   iterator operator ++ (int) { iterator tmp = *this; ++(*this); return tmp; }
+
+private:
+   iterator(sharded_list <T, A> * pSharded, size_t iShard)
+   : pSharded(pSharded), iShard(iShard) {}
+
+   // move past the end of finished shards
+   void skipEmpty()
+   {
+      while (iShard < pSharded->numShards &&
+             it == pSharded->shards[iShard].l.end())
+      {
+         iShard++;
+         it = (iShard < pSharded->numShards) ?
+              pSharded->shards[iShard].l.begin() :
+              typename list <T, A> :: iterator();
+      }
+   }
+
+   sharded_list <T, A> * pSharded;    // the list being walked
+   size_t iShard;                     // which shard we are in
+   typename list <T, A> :: iterator it; // where we are in that shard
+};
+
+/*********************************************
+ * SHARDED LIST :: BEGIN
+ * The first element of the first non-empty shard
+ *    COST   : O(number of shards)
+ *********************************************/
+template <typename T, typename A>
+typename sharded_list <T, A> :: iterator sharded_list <T, A> :: begin()
+{
+   iterator it(this, 0);
+   it.it = shards[0].l.begin();
+   it.skipEmpty();
+   return it;
+}
+
+/*********************************************
+ * SHARDED LIST :: FOR EACH
+ * Visit every element, holding each shard's lock
+ * only while visiting that shard
+ *    INPUT  : function taking a T &
+ *    COST   : O(n)
+ *********************************************/
+template <typename T, typename A>
+template <class Function>
+void sharded_list <T, A> :: for_each(Function f)
+{
+   for (size_t i = 0; i < numShards; i++)
+   {
+      std::lock_guard<std::mutex> guard(shards[i].lock);
+      for (typename list <T, A> :: iterator it = shards[i].l.begin();
+           it != shards[i].l.end(); ++it)
+         f(*it);
+   }
+}
+
+/*********************************************
+ * SHARDED LIST :: COLLAPSE
+ * Splice every shard onto the end of one list,
+ * leaving all the shards empty
+ *    OUTPUT : the combined list, shard 0 first
+ *    COST   : O(number of shards), no element moves
+ *********************************************/
+template <typename T, typename A>
+list <T, A> sharded_list <T, A> :: collapse()
+{
+   list <T, A> l;
+   for (size_t i = 0; i < numShards; i++)
+   {
+      std::lock_guard<std::mutex> guard(shards[i].lock);
+      l.splice(l.end(), shards[i].l);
+   }
+   return l;
+}
+
+/*********************************************
+ * SHARDED LIST :: SIZE
+ * Sum of the shard sizes
+ *    COST   : O(number of shards)
+ *********************************************/
+template <typename T, typename A>
+size_t sharded_list <T, A> :: size() const
+{
+   size_t total = 0;
+   for (size_t i = 0; i < numShards; i++)
+   {
+      std::lock_guard<std::mutex> guard(shards[i].lock);
+      total += shards[i].l.size();
+   }
+   return total;
+}
+
+}; // namespace custom
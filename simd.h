@@ -0,0 +1,511 @@
+/***********************************************************************
+ * Header:
+ *    SIMD
+ * Summary:
+ *    Linear search and reduction over contiguous values: find, count,
+ *    min_element and accumulate. A linked list cannot be searched
+ *    several elements at a time, but its neighbors in this library that
+ *    keep values in arrays can, most of all a soa_list column. For int,
+ *    and for double where the result does not depend on the order of
+ *    the work, these compare or add four or eight values per
+ *    instruction with SSE2 or AVX2, picked once at run time from what
+ *    the processor supports. Every other T, and every build without
+ *    x86 vector instructions, gets the plain loop.
+ *
+ *    The same four names also take a custom::list. Those simply walk
+ *    the nodes: the walk is bound by chasing pointers, and copying the
+ *    values into a buffer for the kernels measured no faster.
+ *
+ *    This will contain the definition of:
+ *        find        : the first element equal to a value
+ *        count       : how many elements equal a value
+ *        min_element : the first smallest element
+ *        accumulate  : init plus every element
+ *        simd_level  : which instruction set the kernels use
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, int64_t
+#include "list.h"       // for custom::list
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CUSTOM_SIMD_SSE2
+#include <emmintrin.h>  // for the SSE2 intrinsics
+#endif
+
+#if defined(CUSTOM_SIMD_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CUSTOM_SIMD_AVX2
+#define CUSTOM_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>  // for the AVX2 intrinsics
+#endif
+
+namespace custom
+{
+
+/**************************************************
+ * SIMD LEVEL
+ * The widest instructions the kernels may use
+ **************************************************/
+enum simd_width { SIMD_SCALAR, SIMD_SSE2, SIMD_AVX2 };
+
+inline simd_width detectSimd()
+{
+#if defined(CUSTOM_SIMD_AVX2)
+   return __builtin_cpu_supports("avx2") ? SIMD_AVX2 : SIMD_SSE2;
+#elif defined(CUSTOM_SIMD_SSE2)
+   return SIMD_SSE2;
+#else
+   return SIMD_SCALAR;
+#endif
+}
+
+inline simd_width simd_level()
+{
+   static const simd_width level = detectSimd();
+   return level;
+}
+
+namespace simd
+{
+
+/**************************************************
+ * SCALAR KERNELS
+ * The reference every vector kernel must match,
+ * and what they finish the last few values with
+ **************************************************/
+template <typename T>
+const T * findScalar(const T * first, const T * last, const T & value)
+{
+   for (; first != last; ++first)
+      if (*first == value)
+         return first;
+   return last;
+}
+
+template <typename T>
+size_t countScalar(const T * first, const T * last, const T & value)
+{
+   size_t total = 0;
+   for (; first != last; ++first)
+      if (*first == value)
+         total++;
+   return total;
+}
+
+template <typename T>
+const T * minScalar(const T * first, const T * last)
+{
+   const T * pMin = first;
+   for (; first != last; ++first)
+      if (*first < *pMin)
+         pMin = first;
+   return pMin;
+}
+
+// int adds wrap, as the vector adds do, instead of overflowing
+inline int sumScalar(const int * first, const int * last, int init)
+{
+   uint32_t total = (uint32_t)init;
+   for (; first != last; ++first)
+      total += (uint32_t)*first;
+   return (int)total;
+}
+
+// the position of the lowest set bit of a nonzero compare mask
+inline int lowestBit(unsigned int mask)
+{
+   int i = 0;
+   while (!(mask & 1u))
+   {
+      mask >>= 1;
+      i++;
+   }
+   return i;
+}
+
+#ifdef CUSTOM_SIMD_SSE2
+
+/**************************************************
+ * SSE2 KERNELS
+ * Four ints or two doubles per instruction
+ **************************************************/
+inline const int * findSse2(const int * first, const int * last, int value)
+{
+   __m128i needle = _mm_set1_epi32(value);
+   for (; last - first >= 4; first += 4)
+   {
+      __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)first), needle);
+      int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+      if (mask)
+         return first + lowestBit(mask);
+   }
+   return findScalar(first, last, value);
+}
+
+inline const double * findSse2(const double * first, const double * last, double value)
+{
+   __m128d needle = _mm_set1_pd(value);
+   for (; last - first >= 2; first += 2)
+   {
+      int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(first), needle));
+      if (mask)
+         return first + lowestBit(mask);
+   }
+   return findScalar(first, last, value);
+}
+
+inline size_t countSse2(const int * first, const int * last, int value)
+{
+   // each lane counts down by one per match; flushed before it can wrap
+   const size_t maxVectors = 1 << 20;
+   __m128i needle = _mm_set1_epi32(value);
+   size_t total = 0;
+   while (last - first >= 4)
+   {
+      size_t numVectors = (size_t)(last - first) / 4;
+      if (numVectors > maxVectors)
+         numVectors = maxVectors;
+      __m128i counts = _mm_setzero_si128();
+      for (size_t i = 0; i < numVectors; i++, first += 4)
+         counts = _mm_sub_epi32(counts,
+            _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)first), needle));
+      alignas(16) uint32_t lanes[4];
+      _mm_store_si128((__m128i *)lanes, counts);
+      total += (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+   }
+   return total + countScalar(first, last, value);
+}
+
+inline size_t countSse2(const double * first, const double * last, double value)
+{
+   __m128d needle = _mm_set1_pd(value);
+   __m128i counts = _mm_setzero_si128();
+   for (; last - first >= 2; first += 2)
+      counts = _mm_sub_epi64(counts,
+         _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(first), needle)));
+   alignas(16) int64_t lanes[2];
+   _mm_store_si128((__m128i *)lanes, counts);
+   return (size_t)(lanes[0] + lanes[1]) + countScalar(first, last, value);
+}
+
+inline const int * minSse2(const int * first, const int * last)
+{
+   if (last - first < 4)
+      return minScalar(first, last);
+
+   // SSE2 has no integer min, so select with a compare
+   __m128i best = _mm_loadu_si128((const __m128i *)first);
+   const int * p = first + 4;
+   for (; last - p >= 4; p += 4)
+   {
+      __m128i v = _mm_loadu_si128((const __m128i *)p);
+      __m128i greater = _mm_cmpgt_epi32(best, v);
+      best = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, best));
+   }
+   alignas(16) int lanes[4];
+   _mm_store_si128((__m128i *)lanes, best);
+   int smallest = *minScalar(lanes, lanes + 4);
+   for (; p != last; ++p)
+      if (*p < smallest)
+         smallest = *p;
+   return findSse2(first, last, smallest);
+}
+
+inline int sumSse2(const int * first, const int * last, int init)
+{
+   __m128i sums = _mm_setzero_si128();
+   for (; last - first >= 4; first += 4)
+      sums = _mm_add_epi32(sums, _mm_loadu_si128((const __m128i *)first));
+   alignas(16) uint32_t lanes[4];
+   _mm_store_si128((__m128i *)lanes, sums);
+   uint32_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+   return sumScalar(first, last, (int)(total + (uint32_t)init));
+}
+
+#endif // CUSTOM_SIMD_SSE2
+
+#ifdef CUSTOM_SIMD_AVX2
+
+/**************************************************
+ * AVX2 KERNELS
+ * Eight ints or four doubles per instruction. Only
+ * called once simd_level() has seen AVX2.
+ **************************************************/
+CUSTOM_TARGET_AVX2
+inline const int * findAvx2(const int * first, const int * last, int value)
+{
+   __m256i needle = _mm256_set1_epi32(value);
+   for (; last - first >= 8; first += 8)
+   {
+      __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)first), needle);
+      int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+      if (mask)
+         return first + lowestBit(mask);
+   }
+   return findSse2(first, last, value);
+}
+
+CUSTOM_TARGET_AVX2
+inline const double * findAvx2(const double * first, const double * last, double value)
+{
+   __m256d needle = _mm256_set1_pd(value);
+   for (; last - first >= 4; first += 4)
+   {
+      int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(first), needle, _CMP_EQ_OQ));
+      if (mask)
+         return first + lowestBit(mask);
+   }
+   return findSse2(first, last, value);
+}
+
+CUSTOM_TARGET_AVX2
+inline size_t countAvx2(const int * first, const int * last, int value)
+{
+   const size_t maxVectors = 1 << 20;
+   __m256i needle = _mm256_set1_epi32(value);
+   size_t total = 0;
+   while (last - first >= 8)
+   {
+      size_t numVectors = (size_t)(last - first) / 8;
+      if (numVectors > maxVectors)
+         numVectors = maxVectors;
+      __m256i counts = _mm256_setzero_si256();
+      for (size_t i = 0; i < numVectors; i++, first += 8)
+         counts = _mm256_sub_epi32(counts,
+            _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)first), needle));
+      alignas(32) uint32_t lanes[8];
+      _mm256_store_si256((__m256i *)lanes, counts);
+      for (uint32_t lane : lanes)
+         total += lane;
+   }
+   return total + countSse2(first, last, value);
+}
+
+CUSTOM_TARGET_AVX2
+inline size_t countAvx2(const double * first, const double * last, double value)
+{
+   __m256d needle = _mm256_set1_pd(value);
+   __m256i counts = _mm256_setzero_si256();
+   for (; last - first >= 4; first += 4)
+      counts = _mm256_sub_epi64(counts,
+         _mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(first), needle, _CMP_EQ_OQ)));
+   alignas(32) int64_t lanes[4];
+   _mm256_store_si256((__m256i *)lanes, counts);
+   return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + countSse2(first, last, value);
+}
+
+CUSTOM_TARGET_AVX2
+inline const int * minAvx2(const int * first, const int * last)
+{
+   if (last - first < 8)
+      return minSse2(first, last);
+
+   __m256i best = _mm256_loadu_si256((const __m256i *)first);
+   const int * p = first + 8;
+   for (; last - p >= 8; p += 8)
+      best = _mm256_min_epi32(best, _mm256_loadu_si256((const __m256i *)p));
+   alignas(32) int lanes[8];
+   _mm256_store_si256((__m256i *)lanes, best);
+   int smallest = *minScalar(lanes, lanes + 8);
+   for (; p != last; ++p)
+      if (*p < smallest)
+         smallest = *p;
+   return findAvx2(first, last, smallest);
+}
+
+CUSTOM_TARGET_AVX2
+inline int sumAvx2(const int * first, const int * last, int init)
+{
+   __m256i sums = _mm256_setzero_si256();
+   for (; last - first >= 8; first += 8)
+      sums = _mm256_add_epi32(sums, _mm256_loadu_si256((const __m256i *)first));
+   alignas(32) uint32_t lanes[8];
+   _mm256_store_si256((__m256i *)lanes, sums);
+   uint32_t total = (uint32_t)init;
+   for (uint32_t lane : lanes)
+      total += lane;
+   return sumSse2(first, last, (int)total);
+}
+
+#endif // CUSTOM_SIMD_AVX2
+
+} // namespace simd
+
+/*********************************************
+ * FIND
+ * The first element in [first, last) equal to value
+ *    OUTPUT : a pointer to it, or last
+ *    COST   : O(n), n / 8 compares with AVX2 for int
+ *********************************************/
+template <typename T>
+const T * find(const T * first, const T * last, const T & value)
+{
+   return simd::findScalar(first, last, value);
+}
+
+inline const int * find(const int * first, const int * last, const int & value)
+{
+#ifdef CUSTOM_SIMD_AVX2
+   if (simd_level() == SIMD_AVX2)
+      return simd::findAvx2(first, last, value);
+#endif
+#ifdef CUSTOM_SIMD_SSE2
+   return simd::findSse2(first, last, value);
+#else
+   return simd::findScalar(first, last, value);
+#endif
+}
+
+inline const double * find(const double * first, const double * last, const double & value)
+{
+#ifdef CUSTOM_SIMD_AVX2
+   if (simd_level() == SIMD_AVX2)
+      return simd::findAvx2(first, last, value);
+#endif
+#ifdef CUSTOM_SIMD_SSE2
+   return simd::findSse2(first, last, value);
+#else
+   return simd::findScalar(first, last, value);
+#endif
+}
+
+/*********************************************
+ * COUNT
+ * How many elements in [first, last) equal value
+ *    COST   : O(n)
+ *********************************************/
+template <typename T>
+size_t count(const T * first, const T * last, const T & value)
+{
+   return simd::countScalar(first, last, value);
+}
+
+inline size_t count(const int * first, const int * last, const int & value)
+{
+#ifdef CUSTOM_SIMD_AVX2
+   if (simd_level() == SIMD_AVX2)
+      return simd::countAvx2(first, last, value);
+#endif
+#ifdef CUSTOM_SIMD_SSE2
+   return simd::countSse2(first, last, value);
+#else
+   return simd::countScalar(first, last, value);
+#endif
+}
+
+inline size_t count(const double * first, const double * last, const double & value)
+{
+#ifdef CUSTOM_SIMD_AVX2
+   if (simd_level() == SIMD_AVX2)
+      return simd::countAvx2(first, last, value);
+#endif
+#ifdef CUSTOM_SIMD_SSE2
+   return simd::countSse2(first, last, value);
+#else
+   return simd::countScalar(first, last, value);
+#endif
+}
+
+/*********************************************
+ * MIN ELEMENT
+ * The first smallest element of [first, last).
+ * The int kernels find the smallest value a
+ * vector at a time, then find where it first is.
+ *    OUTPUT : a pointer to it, or last if empty
+ *    COST   : O(n)
+ *********************************************/
+template <typename T>
+const T * min_element(const T * first, const T * last)
+{
+   return simd::minScalar(first, last);
+}
+
+inline const int * min_element(const int * first, const int * last)
+{
+#ifdef CUSTOM_SIMD_AVX2
+   if (simd_level() == SIMD_AVX2)
+      return simd::minAvx2(first, last);
+#endif
+#ifdef CUSTOM_SIMD_SSE2
+   return simd::minSse2(first, last);
+#else
+   return simd::minScalar(first, last);
+#endif
+}
+
+/*********************************************
+ * ACCUMULATE
+ * init plus every element of [first, last). Only
+ * int is vectorized: adding doubles in another
+ * order would change the result.
+ *    COST   : O(n)
+ *********************************************/
+template <typename T>
+T accumulate(const T * first, const T * last, T init)
+{
+   for (; first != last; ++first)
+      init = init + *first;
+   return init;
+}
+
+inline int accumulate(const int * first, const int * last, int init)
+{
+#ifdef CUSTOM_SIMD_AVX2
+   if (simd_level() == SIMD_AVX2)
+      return simd::sumAvx2(first, last, init);
+#endif
+#ifdef CUSTOM_SIMD_SSE2
+   return simd::sumSse2(first, last, init);
+#else
+   return simd::sumScalar(first, last, init);
+#endif
+}
+
+/*********************************************
+ * LIST FIND / COUNT / MIN ELEMENT / ACCUMULATE
+ * The nodes are not contiguous, so these simply
+ * walk; no kernel can load several at once
+ *    COST   : O(n)
+ *********************************************/
+template <typename T, typename A>
+typename list <T, A> :: iterator find(list <T, A> & l, const T & value)
+{
+   typename list <T, A> :: iterator it = l.begin();
+   for (; it != l.end(); ++it)
+      if (*it == value)
+         break;
+   return it;
+}
+
+template <typename T, typename A>
+size_t count(list <T, A> & l, const T & value)
+{
+   size_t total = 0;
+   for (typename list <T, A> :: iterator it = l.begin(); it != l.end(); ++it)
+      if (*it == value)
+         total++;
+   return total;
+}
+
+template <typename T, typename A>
+typename list <T, A> :: iterator min_element(list <T, A> & l)
+{
+   typename list <T, A> :: iterator itMin = l.begin();
+   for (typename list <T, A> :: iterator it = l.begin(); it != l.end(); ++it)
+      if (*it < *itMin)
+         itMin = it;
+   return itMin;
+}
+
+template <typename T, typename A>
+T accumulate(list <T, A> & l, T init)
+{
+   for (typename list <T, A> :: iterator it = l.begin(); it != l.end(); ++it)
+      init = init + *it;
+   return init;
+}
+
+}; // namespace custom
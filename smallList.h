@@ -0,0 +1,367 @@
+/***********************************************************************
+ * Header:
+ *    SMALL LIST
+ * Summary:
+ *    A doubly linked list that keeps its first N nodes inside the list
+ *    object itself. Most lists hold only a handful of elements, and for
+ *    those creating, filling, and destroying the list never touches the
+ *    heap. Once all N inline slots are taken further nodes come from
+ *    new, and an inline slot freed by an erase is reused before the
+ *    heap is asked again.
+ *
+ *    A bitmask records which inline slots hold a node. Nodes never move
+ *    once linked, so iterators stay valid exactly as for custom::list.
+ *    The price is that a small_list cannot hand its nodes to another
+ *    list: moving and swapping move the elements, which is O(n).
+ *
+ *    This will contain the class definition of:
+ *        small_list           : A list with N inline nodes
+ *        small_list::iterator : An iterator through it
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>          // for ASSERT
+#include <cstddef>          // for size_t
+#include <cstdint>          // for uint64_t
+#include <functional>       // for std::less
+#include <initializer_list> // for std::initializer_list
+#include <new>              // for placement new
+#include <utility>          // for std::move, std::forward
+
+class TestSmallList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * SMALL LIST
+ * The list interface of custom::list for the ends
+ * and iterators, with N nodes stored inline
+ **************************************************/
+template <typename T, size_t N = 4>
+class small_list
+{
+   static_assert(N >= 1 && N <= 64, "small_list keeps 1 to 64 nodes inline");
+   friend class ::TestSmallList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   small_list() : numElements(0), pHead(nullptr), pTail(nullptr), used(0) {}
+   small_list(const std::initializer_list<T> & il);
+   small_list(const small_list & rhs);
+   small_list(small_list && rhs);
+   ~small_list() { clear(); }
+
+   //
+   // Assign
+   //
+
+   small_list & operator = (const small_list & rhs);
+   small_list & operator = (small_list && rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin()  { return iterator(pHead);   }
+   iterator rbegin() { return iterator(pTail);   }
+   iterator end()    { return iterator(nullptr); }
+
+   //
+   // Access
+   //
+
+   T & front() { assert(pHead); return pHead->data; }
+   T & back()  { assert(pTail); return pTail->data; }
+
+   //
+   // Insert
+   //
+
+   void push_front(const T &  data) { insert(begin(), data);            }
+   void push_front(      T && data) { insert(begin(), std::move(data)); }
+   void push_back (const T &  data) { insert(end(), data);              }
+   void push_back (      T && data) { insert(end(), std::move(data));   }
+   iterator insert(iterator it, const T &  data) { return link(it, allocNode(data));            }
+   iterator insert(iterator it,       T && data) { return link(it, allocNode(std::move(data))); }
+
+   //
+   // Remove
+   //
+
+   void pop_front() { if (pHead) erase(begin());  }
+   void pop_back()  { if (pTail) erase(rbegin()); }
+   iterator erase(iterator it);
+   void clear();
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return pHead == nullptr; }
+   size_t size() const { return numElements;      }
+   static size_t inline_capacity() { return N;    }
+
+private:
+   // nested linked list class
+   class Node;
+
+   static const uint64_t FULL = (N == 64) ? ~(uint64_t)0 : (((uint64_t)1 << N) - 1);
+
+   Node * slot(size_t i) { return reinterpret_cast <Node *> (slots) + i; }
+   bool isInline(const Node * p) const;
+   template <typename U>
+   Node * allocNode(U && data);
+   void freeNode(Node * p);
+   iterator link(iterator it, Node * pNew);
+
+   // member variables
+   size_t numElements;  // though we could count, it is faster to keep a variable
+   Node * pHead;        // pointer to the beginning of the list
+   Node * pTail;        // pointer to the ending of the list
+   uint64_t used;       // bit i set when inline slot i holds a node
+   alignas(Node) unsigned char slots[N * sizeof(Node)];  // the inline nodes
+};
+
+/*************************************************
+ * NODE
+ * Same links as a custom::list node
+ *************************************************/
+template <typename T, size_t N>
+class small_list <T, N> :: Node
+{
+public:
+   Node(const T &  data) : pNext(nullptr), pPrev(nullptr), data(data) {}
+   Node(      T && data) : pNext(nullptr), pPrev(nullptr), data(std::move(data)) {}
+
+   Node * pNext;       // pointer to next node
+   Node * pPrev;       // pointer to previous node
+   T data;             // user data
+};
+
+/*************************************************
+ * SMALL LIST ITERATOR
+ * Iterate through a small_list in either direction
+ ************************************************/
+template <typename T, size_t N>
+class small_list <T, N> :: iterator
+{
+   friend class ::TestSmallList; // give unit tests access to the privates
+   friend class custom::small_list <T, N>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator, fetch a node
+   T & operator * () { return p->data; }
+
+   // prefix increment
+   iterator & operator ++ () { p = p->pNext; return *this; }
+
+   // postfix increment
+   iterator operator ++ (int) { iterator tmp = *this; p = p->pNext; return tmp; }
+
+   // prefix decrement
+   iterator & operator -- () { p = p->pPrev; return *this; }
+
+   // postfix decrement
+   iterator operator -- (int) { iterator tmp = *this; p = p->pPrev; return tmp; }
+
+private:
+   iterator(Node * p) : p(p) {}
+
+   Node * p;   // the current node
+};
+
+/*****************************************
+ * SMALL LIST :: CONSTRUCTORS
+ * Every constructor copies or moves element by
+ * element, since inline nodes cannot change owner
+ ****************************************/
+template <typename T, size_t N>
+small_list <T, N> :: small_list(const std::initializer_list<T> & il)
+: numElements(0), pHead(nullptr), pTail(nullptr), used(0)
+{
+   for (const T & item : il)
+      push_back(item);
+}
+
+template <typename T, size_t N>
+small_list <T, N> :: small_list(const small_list & rhs)
+: numElements(0), pHead(nullptr), pTail(nullptr), used(0)
+{
+   for (Node * p = rhs.pHead; p; p = p->pNext)
+      push_back(p->data);
+}
+
+template <typename T, size_t N>
+small_list <T, N> :: small_list(small_list && rhs)
+: numElements(0), pHead(nullptr), pTail(nullptr), used(0)
+{
+   *this = std::move(rhs);
+}
+
+/*****************************************
+ * SMALL LIST :: ASSIGNMENT
+ *    COST   : O(n + m)
+ ****************************************/
+template <typename T, size_t N>
+small_list <T, N> & small_list <T, N> :: operator = (const small_list & rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+      for (Node * p = rhs.pHead; p; p = p->pNext)
+         push_back(p->data);
+   }
+   return *this;
+}
+
+template <typename T, size_t N>
+small_list <T, N> & small_list <T, N> :: operator = (small_list && rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+      for (Node * p = rhs.pHead; p; p = p->pNext)
+         push_back(std::move(p->data));
+      rhs.clear();
+   }
+   return *this;
+}
+
+/*********************************************
+ * SMALL LIST :: IS INLINE
+ * Whether p lives in this list's inline slots
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, size_t N>
+bool small_list <T, N> :: isInline(const Node * p) const
+{
+   const Node * pFirst = reinterpret_cast <const Node *> (slots);
+   std::less<const Node *> less;
+   return !less(p, pFirst) && less(p, pFirst + N);
+}
+
+/*********************************************
+ * SMALL LIST :: ALLOCATE NODE
+ * Build a node in the lowest free inline slot,
+ * or on the heap when every slot is taken
+ *    COST   : O(N) to find the slot, no allocation
+ *             while one is free
+ *********************************************/
+template <typename T, size_t N>
+template <typename U>
+typename small_list <T, N> :: Node * small_list <T, N> :: allocNode(U && data)
+{
+   if (used == FULL)
+      return new Node(std::forward<U>(data));
+
+   size_t i = 0;
+   while (used & ((uint64_t)1 << i))
+      i++;
+   Node * pNew = new (slot(i)) Node(std::forward<U>(data));
+   used |= (uint64_t)1 << i;
+   return pNew;
+}
+
+/*********************************************
+ * SMALL LIST :: FREE NODE
+ * Destroy a node and give back its slot or memory
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, size_t N>
+void small_list <T, N> :: freeNode(Node * p)
+{
+   if (isInline(p))
+   {
+      size_t i = p - slot(0);
+      p->~Node();
+      used &= ~((uint64_t)1 << i);
+   }
+   else
+      delete p;
+}
+
+/*********************************************
+ * SMALL LIST :: LINK
+ * Hang a new node in front of it
+ *    OUTPUT : the new element
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, size_t N>
+typename small_list <T, N> :: iterator
+small_list <T, N> :: link(iterator it, Node * pNew)
+{
+   Node * pNext = it.p;
+   Node * pPrev = pNext ? pNext->pPrev : pTail;
+   pNew->pNext = pNext;
+   pNew->pPrev = pPrev;
+   if (pPrev)
+      pPrev->pNext = pNew;
+   else
+      pHead = pNew;
+   if (pNext)
+      pNext->pPrev = pNew;
+   else
+      pTail = pNew;
+   numElements++;
+   return iterator(pNew);
+}
+
+/*********************************************
+ * SMALL LIST :: ERASE
+ * Remove one element
+ *    INPUT  : the element to remove
+ *    OUTPUT : the element that followed it
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, size_t N>
+typename small_list <T, N> :: iterator
+small_list <T, N> :: erase(iterator it)
+{
+   Node * pErase = it.p;
+   assert(pErase);
+   Node * pNext = pErase->pNext;
+   if (pErase->pPrev)
+      pErase->pPrev->pNext = pNext;
+   else
+      pHead = pNext;
+   if (pNext)
+      pNext->pPrev = pErase->pPrev;
+   else
+      pTail = pErase->pPrev;
+   freeNode(pErase);
+   numElements--;
+   return iterator(pNext);
+}
+
+/*********************************************
+ * SMALL LIST :: CLEAR
+ *    COST   : O(n)
+ *********************************************/
+template <typename T, size_t N>
+void small_list <T, N> :: clear()
+{
+   while (pHead)
+   {
+      Node * pDelete = pHead;
+      pHead = pHead->pNext;
+      freeNode(pDelete);
+   }
+   pTail = nullptr;
+   numElements = 0;
+}
+
+}; // namespace custom
@@ -0,0 +1,305 @@
+/***********************************************************************
+ * Header:
+ *    SOA LIST
+ * Summary:
+ *    A list of records stored as a structure of arrays. Each field of
+ *    the record has its own contiguous column, and the list order is
+ *    kept by two more arrays of indices, next and prev. Inserting or
+ *    erasing in the middle only relinks indices, as in custom::list,
+ *    while a scan that needs one field, such as summing a price or
+ *    counting a flag, walks one dense column the compiler can
+ *    vectorize instead of chasing a pointer per record.
+ *
+ *    The columns stay dense: erase moves the last row into the hole
+ *    and relinks it. Column order is therefore storage order, not list
+ *    order, and an erase invalidates iterators to the last row as well
+ *    as to the erased one.
+ *
+ *    This will contain the class definition of:
+ *        soa_list           : A list of rows stored column by column
+ *        soa_list::iterator : A walk in list order
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <limits>      // for std::numeric_limits
+#include <tuple>       // for std::tuple, std::get
+#include <utility>     // for std::index_sequence, std::move
+#include <vector>      // for std::vector
+
+class TestSoaList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * SOA LIST
+ * One column per field: soa_list<int, double> holds
+ * rows of an int and a double
+ **************************************************/
+template <typename ... Fields>
+class soa_list
+{
+   friend class ::TestSoaList; // give unit tests access to the privates
+public:
+   typedef std::tuple<Fields & ...> reference;
+
+   //
+   // Construct
+   //
+
+   soa_list() : head(NONE), tail(NONE) {}
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin()  { return iterator(this, head); }
+   iterator rbegin() { return iterator(this, tail); }
+   iterator end()    { return iterator(this, NONE); }
+
+   //
+   // Access
+   //
+
+   template <size_t I>
+   std::vector<typename std::tuple_element<I, std::tuple<Fields ...>>::type> & column()
+   {
+      return std::get<I>(columns);
+   }
+   template <size_t I>
+   const std::vector<typename std::tuple_element<I, std::tuple<Fields ...>>::type> & column() const
+   {
+      return std::get<I>(columns);
+   }
+   reference front() { assert(head != NONE); return row(head); }
+   reference back()  { assert(tail != NONE); return row(tail); }
+
+   //
+   // Insert
+   //
+
+   void push_front(const Fields & ... values) { insert(begin(), values ...); }
+   void push_back (const Fields & ... values) { insert(end(),   values ...); }
+   iterator insert(iterator it, const Fields & ... values);
+
+   //
+   // Remove
+   //
+
+   void pop_front() { if (head != NONE) erase(begin());  }
+   void pop_back()  { if (tail != NONE) erase(rbegin()); }
+   iterator erase(iterator it);
+   void clear();
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return next.empty(); }
+   size_t size() const { return next.size();  }
+   void reserve(size_t numRows);
+
+private:
+   static const size_t NONE = std::numeric_limits<size_t>::max();
+   typedef std::index_sequence_for<Fields ...> Columns;
+
+   reference row(size_t i) { return row(i, Columns()); }
+   template <size_t ... Is>
+   reference row(size_t i, std::index_sequence<Is ...>)
+   {
+      return reference(std::get<Is>(columns)[i] ...);
+   }
+   template <size_t ... Is>
+   void append(std::index_sequence<Is ...>, const Fields & ... values)
+   {
+      (std::get<Is>(columns).push_back(values), ...);
+   }
+   template <size_t ... Is>
+   void moveLast(size_t iTo, std::index_sequence<Is ...>)
+   {
+      ((std::get<Is>(columns)[iTo] = std::move(std::get<Is>(columns).back())), ...);
+   }
+   template <size_t ... Is>
+   void popLast(std::index_sequence<Is ...>)
+   {
+      (std::get<Is>(columns).pop_back(), ...);
+   }
+   template <size_t ... Is>
+   void reserveAll(size_t numRows, std::index_sequence<Is ...>)
+   {
+      (std::get<Is>(columns).reserve(numRows), ...);
+   }
+   template <size_t ... Is>
+   void clearAll(std::index_sequence<Is ...>)
+   {
+      (std::get<Is>(columns).clear(), ...);
+   }
+
+   // member variables
+   std::tuple<std::vector<Fields> ...> columns; // one dense array per field
+   std::vector<size_t> next;   // row after row i in list order, NONE at the tail
+   std::vector<size_t> prev;   // row before row i in list order, NONE at the head
+   size_t head;                // first row in list order
+   size_t tail;                // last row in list order
+};
+
+/*************************************************
+ * SOA LIST ITERATOR
+ * A row index plus the list it indexes
+ ************************************************/
+template <typename ... Fields>
+class soa_list <Fields ...> :: iterator
+{
+   friend class ::TestSoaList; // give unit tests access to the privates
+   friend class custom::soa_list <Fields ...>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : pList(nullptr), i(NONE) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return i == rhs.i; }
+   bool operator != (const iterator & rhs) const { return i != rhs.i; }
+
+   // dereference operator, fetch the whole row or one field
+   reference operator * () { return pList->row(i); }
+   template <size_t I>
+   typename std::tuple_element<I, std::tuple<Fields ...>>::type & get()
+   {
+      return std::get<I>(pList->columns)[i];
+   }
+
+   // prefix increment
+   iterator & operator ++ () { i = pList->next[i]; return *this; }
+
+   // postfix increment
+   iterator operator ++ (int) { iterator tmp = *this; ++*this; return tmp; }
+
+   // prefix decrement
+   iterator & operator -- () { i = pList->prev[i]; return *this; }
+
+   // postfix decrement
+   iterator operator -- (int) { iterator tmp = *this; --*this; return tmp; }
+
+private:
+   iterator(soa_list * pList, size_t i) : pList(pList), i(i) {}
+
+   soa_list * pList;  // whose columns we index
+   size_t i;          // the current row, NONE past the end
+};
+
+/*********************************************
+ * SOA LIST :: INSERT
+ * Append a row to every column and link it in
+ * front of it
+ *    INPUT  : where it goes in list order
+ *             one value per field
+ *    OUTPUT : the new row
+ *    COST   : O(1) amortized
+ *********************************************/
+template <typename ... Fields>
+typename soa_list <Fields ...> :: iterator
+soa_list <Fields ...> :: insert(iterator it, const Fields & ... values)
+{
+   size_t iNew = next.size();
+   size_t iNext = it.i;
+   size_t iPrev = iNext != NONE ? prev[iNext] : tail;
+
+   append(Columns(), values ...);
+   next.push_back(iNext);
+   prev.push_back(iPrev);
+
+   if (iPrev != NONE)
+      next[iPrev] = iNew;
+   else
+      head = iNew;
+   if (iNext != NONE)
+      prev[iNext] = iNew;
+   else
+      tail = iNew;
+   return iterator(this, iNew);
+}
+
+/*********************************************
+ * SOA LIST :: ERASE
+ * Unlink a row, then fill its hole with the last
+ * row so every column stays dense
+ *    INPUT  : the row to remove
+ *    OUTPUT : the row that followed it in list order
+ *    COST   : O(1)
+ *********************************************/
+template <typename ... Fields>
+typename soa_list <Fields ...> :: iterator
+soa_list <Fields ...> :: erase(iterator it)
+{
+   size_t i = it.i;
+   assert(i < next.size());
+   size_t iNext = next[i];
+
+   // unlink row i
+   if (prev[i] != NONE)
+      next[prev[i]] = next[i];
+   else
+      head = next[i];
+   if (next[i] != NONE)
+      prev[next[i]] = prev[i];
+   else
+      tail = prev[i];
+
+   // move the last row into the hole and point its neighbors there
+   size_t iLast = next.size() - 1;
+   if (i != iLast)
+   {
+      moveLast(i, Columns());
+      next[i] = next[iLast];
+      prev[i] = prev[iLast];
+      if (prev[i] != NONE)
+         next[prev[i]] = i;
+      else
+         head = i;
+      if (next[i] != NONE)
+         prev[next[i]] = i;
+      else
+         tail = i;
+      if (iNext == iLast)
+         iNext = i;
+   }
+
+   popLast(Columns());
+   next.pop_back();
+   prev.pop_back();
+   return iterator(this, iNext);
+}
+
+/*********************************************
+ * SOA LIST :: CLEAR
+ *    COST   : O(n)
+ *********************************************/
+template <typename ... Fields>
+void soa_list <Fields ...> :: clear()
+{
+   clearAll(Columns());
+   next.clear();
+   prev.clear();
+   head = tail = NONE;
+}
+
+/*********************************************
+ * SOA LIST :: RESERVE
+ * Make room for numRows without reallocating
+ *    COST   : O(n) if the columns grow
+ *********************************************/
+template <typename ... Fields>
+void soa_list <Fields ...> :: reserve(size_t numRows)
+{
+   reserveAll(numRows, Columns());
+   next.reserve(numRows);
+   prev.reserve(numRows);
+}
+
+}; // namespace custom
@@ -0,0 +1,447 @@
+/***********************************************************************
+ * Header:
+ *    SORTED LIST
+ * Summary:
+ *    A doubly linked list that keeps its elements in order, with a skip
+ *    list layered over the nodes so that searching and inserting take
+ *    O(log n) expected time instead of a linear scan.
+ *
+ *    Every node gets a random height and, at each level it reaches, a
+ *    pointer to the next node that is at least as tall. Level 0 is the
+ *    ordinary doubly linked chain, so iterating is the same plain walk
+ *    as custom::list. Equal elements stay in the order they were
+ *    inserted. The last node of every level is remembered as well, so
+ *    appending something no smaller than back(), the common case for a
+ *    timeline, costs O(1) expected.
+ *
+ *    This will contain the class definition of:
+ *        sorted_list           : An ordered list with O(log n) search
+ *        sorted_list::iterator : A read-only walk in order
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t
+#include <functional>  // for std::less
+#include <utility>     // for std::move, std::swap
+
+class TestSortedList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * SORTED LIST
+ * Elements are kept ordered by Compare; there is
+ * no way to put one anywhere else
+ **************************************************/
+template <typename T, typename Compare = std::less<T>>
+class sorted_list
+{
+   friend class ::TestSortedList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   sorted_list(const Compare & cmp = Compare());
+   sorted_list(const sorted_list & rhs);
+   sorted_list(sorted_list && rhs);
+   ~sorted_list() { clear(); }
+
+   //
+   // Assign
+   //
+
+   sorted_list & operator = (sorted_list rhs) { swap(rhs); return *this; }
+   void swap(sorted_list & rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() const { return iterator(first[0]); }
+   iterator end()   const { return iterator(nullptr);  }
+
+   //
+   // Access
+   //
+
+   const T & front() const { assert(numElements); return first[0]->data; }
+   const T & back()  const { assert(numElements); return tail[0]->data;  }
+   iterator find(const T & data) const;
+   iterator lower_bound(const T & data) const;
+   iterator upper_bound(const T & data) const;
+   bool contains(const T & data) const { return find(data) != end(); }
+
+   //
+   // Insert
+   //
+
+   iterator insert(const T &  data) { return link(new Node(data, randomHeight()));            }
+   iterator insert(      T && data) { return link(new Node(std::move(data), randomHeight())); }
+
+   //
+   // Remove
+   //
+
+   iterator erase(const iterator & it);
+   size_t erase(const T & data);
+   void pop_front() { if (numElements) erase(begin()); }
+   void clear();
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return numElements == 0; }
+   size_t size() const { return numElements;      }
+
+private:
+   // nested linked list class
+   enum { MAX_LEVELS = 16 };   // a quarter of the nodes reach each next level
+   class Node;
+
+   unsigned randomHeight();
+   iterator link(Node * pNew);
+   template <class Before>
+   void findPreds(Before before, Node ** preds) const;
+
+   // member variables
+   Compare cmp;                    // the ordering
+   size_t numElements;             // number of nodes
+   unsigned numLevels;             // no level at or above this has nodes
+   uint32_t seed;                  // state of the height generator
+   Node * first[MAX_LEVELS];       // first node at each level
+   Node * tail[MAX_LEVELS];        // last node at each level
+};
+
+/*************************************************
+ * NODE
+ * skips[0] is the plain next pointer; higher
+ * levels exist up to height
+ *************************************************/
+template <typename T, typename Compare>
+class sorted_list <T, Compare> :: Node
+{
+public:
+   Node(const T & data, unsigned height)
+   : pPrev(nullptr), skips(new Node * [height]()), height(height), data(data) {}
+   Node(T && data, unsigned height)
+   : pPrev(nullptr), skips(new Node * [height]()), height(height), data(std::move(data)) {}
+   Node(const Node & rhs) = delete;
+   Node & operator = (const Node & rhs) = delete;
+   ~Node() { delete [] skips; }
+
+   Node * pPrev;       // pointer to previous node
+   Node ** skips;      // next node at each level
+   unsigned height;    // how many levels this node is on
+   T data;             // user data
+};
+
+/*************************************************
+ * SORTED LIST ITERATOR
+ * Walks level 0. Elements are read-only, since
+ * changing one could put it out of order.
+ ************************************************/
+template <typename T, typename Compare>
+class sorted_list <T, Compare> :: iterator
+{
+   friend class ::TestSortedList; // give unit tests access to the privates
+   friend class custom::sorted_list <T, Compare>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator, fetch a node
+   const T & operator * () const { return p->data; }
+
+   // prefix increment and decrement
+   iterator & operator ++ () { p = p->skips[0]; return *this; }
+   iterator & operator -- () { p = p->pPrev;    return *this; }
+
+   // postfix increment and decrement
+   iterator operator ++ (int) { iterator tmp = *this; ++(*this); return tmp; }
+   iterator operator -- (int) { iterator tmp = *this; --(*this); return tmp; }
+
+private:
+   iterator(Node * p) : p(p) {}
+
+   Node * p;   // the current node
+};
+
+/*****************************************
+ * SORTED LIST :: CONSTRUCTORS
+ ****************************************/
+template <typename T, typename Compare>
+sorted_list <T, Compare> :: sorted_list(const Compare & cmp)
+: cmp(cmp), numElements(0), numLevels(0), seed(2463534242u)
+{
+   for (unsigned L = 0; L < MAX_LEVELS; L++)
+      first[L] = tail[L] = nullptr;
+}
+
+template <typename T, typename Compare>
+sorted_list <T, Compare> :: sorted_list(const sorted_list & rhs) : sorted_list(rhs.cmp)
+{
+   // already in order, so every insert is an append
+   for (Node * p = rhs.first[0]; p; p = p->skips[0])
+      insert(p->data);
+}
+
+template <typename T, typename Compare>
+sorted_list <T, Compare> :: sorted_list(sorted_list && rhs) : sorted_list(rhs.cmp)
+{
+   swap(rhs);
+}
+
+/*****************************************
+ * SORTED LIST :: SWAP
+ *    COST   : O(MAX_LEVELS)
+ ****************************************/
+template <typename T, typename Compare>
+void sorted_list <T, Compare> :: swap(sorted_list & rhs)
+{
+   std::swap(cmp, rhs.cmp);
+   std::swap(numElements, rhs.numElements);
+   std::swap(numLevels, rhs.numLevels);
+   std::swap(seed, rhs.seed);
+   for (unsigned L = 0; L < MAX_LEVELS; L++)
+   {
+      std::swap(first[L], rhs.first[L]);
+      std::swap(tail[L], rhs.tail[L]);
+   }
+}
+
+/*********************************************
+ * SORTED LIST :: RANDOM HEIGHT
+ * 1 with probability 3/4, 2 with 3/16, and so on
+ *    COST   : O(1) expected
+ *********************************************/
+template <typename T, typename Compare>
+unsigned sorted_list <T, Compare> :: randomHeight()
+{
+   // xorshift32
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+
+   unsigned height = 1;
+   for (uint32_t bits = seed; (bits & 3) == 0 && height < MAX_LEVELS; bits >>= 2)
+      height++;
+   return height;
+}
+
+/*********************************************
+ * SORTED LIST :: FIND PREDS
+ * For every level, the last node for which
+ * before(node) holds, or nullptr if there is none.
+ * before must be true for a prefix of the list.
+ *    COST   : O(log n) expected
+ *********************************************/
+template <typename T, typename Compare>
+template <class Before>
+void sorted_list <T, Compare> :: findPreds(Before before, Node ** preds) const
+{
+   Node * p = nullptr;
+   for (unsigned L = numLevels; L-- > 0; )
+   {
+      if (!p && first[L] && before(first[L]->data))
+         p = first[L];
+      if (p)
+         while (p->skips[L] && before(p->skips[L]->data))
+            p = p->skips[L];
+      preds[L] = p;
+   }
+}
+
+/*********************************************
+ * SORTED LIST :: LOWER BOUND
+ * The first element not less than data
+ *    COST   : O(log n) expected
+ *********************************************/
+template <typename T, typename Compare>
+typename sorted_list <T, Compare> :: iterator
+sorted_list <T, Compare> :: lower_bound(const T & data) const
+{
+   if (numElements == 0)
+      return end();
+   Node * preds[MAX_LEVELS];
+   findPreds([this, &data](const T & value) { return cmp(value, data); }, preds);
+   return iterator(preds[0] ? preds[0]->skips[0] : first[0]);
+}
+
+/*********************************************
+ * SORTED LIST :: UPPER BOUND
+ * The first element greater than data
+ *    COST   : O(log n) expected
+ *********************************************/
+template <typename T, typename Compare>
+typename sorted_list <T, Compare> :: iterator
+sorted_list <T, Compare> :: upper_bound(const T & data) const
+{
+   if (numElements == 0)
+      return end();
+   Node * preds[MAX_LEVELS];
+   findPreds([this, &data](const T & value) { return !cmp(data, value); }, preds);
+   return iterator(preds[0] ? preds[0]->skips[0] : first[0]);
+}
+
+/*********************************************
+ * SORTED LIST :: FIND
+ * The first element equivalent to data
+ *    COST   : O(log n) expected
+ *********************************************/
+template <typename T, typename Compare>
+typename sorted_list <T, Compare> :: iterator
+sorted_list <T, Compare> :: find(const T & data) const
+{
+   iterator it = lower_bound(data);
+   if (it != end() && cmp(data, *it))
+      return end();
+   return it;
+}
+
+/*********************************************
+ * SORTED LIST :: LINK
+ * Put pNew after everything not greater than it
+ *    OUTPUT : an iterator to the new element
+ *    COST   : O(1) expected when appending,
+ *             otherwise O(log n) expected
+ *********************************************/
+template <typename T, typename Compare>
+typename sorted_list <T, Compare> :: iterator
+sorted_list <T, Compare> :: link(Node * pNew)
+{
+   Node * preds[MAX_LEVELS];
+   if (tail[0] && cmp(pNew->data, tail[0]->data))
+   {
+      const T & data = pNew->data;
+      findPreds([this, &data](const T & value) { return !cmp(data, value); }, preds);
+   }
+   else
+   {
+      // nothing in the list is greater: append
+      for (unsigned L = 0; L < pNew->height; L++)
+         preds[L] = tail[L];
+   }
+
+   for (unsigned L = 0; L < pNew->height; L++)
+   {
+      Node * pPred = (L < numLevels) ? preds[L] : nullptr;
+      Node * pNext = pPred ? pPred->skips[L] : first[L];
+      pNew->skips[L] = pNext;
+      if (pPred)
+         pPred->skips[L] = pNew;
+      else
+         first[L] = pNew;
+      if (pNext == nullptr)
+         tail[L] = pNew;
+   }
+
+   pNew->pPrev = (numLevels ? preds[0] : nullptr);
+   if (pNew->skips[0])
+      pNew->skips[0]->pPrev = pNew;
+   if (numLevels < pNew->height)
+      numLevels = pNew->height;
+   numElements++;
+   return iterator(pNew);
+}
+
+/*********************************************
+ * SORTED LIST :: ERASE
+ * Unlink the node from every level it is on. On
+ * each level the search lands just before the
+ * run of equal elements; step along that run to
+ * reach the node itself.
+ *    INPUT  : the element to remove
+ *    OUTPUT : the element after it
+ *    COST   : O(log n + equal elements) expected
+ *********************************************/
+template <typename T, typename Compare>
+typename sorted_list <T, Compare> :: iterator
+sorted_list <T, Compare> :: erase(const iterator & it)
+{
+   Node * pDelete = it.p;
+   assert(pDelete);
+
+   Node * preds[MAX_LEVELS];
+   const T & data = pDelete->data;
+   findPreds([this, &data](const T & value) { return cmp(value, data); }, preds);
+
+   for (unsigned L = 0; L < pDelete->height; L++)
+   {
+      Node * pPred = preds[L];
+      Node * pNext = pPred ? pPred->skips[L] : first[L];
+      while (pNext != pDelete)
+      {
+         pPred = pNext;
+         pNext = pPred->skips[L];
+      }
+
+      if (pPred)
+         pPred->skips[L] = pDelete->skips[L];
+      else
+         first[L] = pDelete->skips[L];
+      if (tail[L] == pDelete)
+         tail[L] = pPred;
+   }
+
+   Node * pNext = pDelete->skips[0];
+   if (pNext)
+      pNext->pPrev = pDelete->pPrev;
+   while (numLevels > 0 && first[numLevels - 1] == nullptr)
+      numLevels--;
+   numElements--;
+   delete pDelete;
+   return iterator(pNext);
+}
+
+/*********************************************
+ * SORTED LIST :: ERASE
+ * Remove every element equivalent to data
+ *    OUTPUT : how many were removed
+ *    COST   : O(log n) expected per element
+ *********************************************/
+template <typename T, typename Compare>
+size_t sorted_list <T, Compare> :: erase(const T & data)
+{
+   // find the range first: data may be one of the elements going away
+   size_t count = 0;
+   iterator itLast = upper_bound(data);
+   for (iterator it = lower_bound(data); it != itLast; count++)
+      it = erase(it);
+   return count;
+}
+
+/*********************************************
+ * SORTED LIST :: CLEAR
+ *    COST   : O(n)
+ *********************************************/
+template <typename T, typename Compare>
+void sorted_list <T, Compare> :: clear()
+{
+   Node * p = first[0];
+   while (p)
+   {
+      Node * pDelete = p;
+      p = p->skips[0];
+      delete pDelete;
+   }
+   for (unsigned L = 0; L < MAX_LEVELS; L++)
+      first[L] = tail[L] = nullptr;
+   numElements = 0;
+   numLevels = 0;
+}
+
+}; // namespace custom
@@ -0,0 +1,289 @@
+/***********************************************************************
+ * Header:
+ *    TEST BLOCKING QUEUE
+ * Summary:
+ *    Unit tests for blocking_queue
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "blockingQueue.h" // class under test
+#include "unitTest.h"      // unit test baseclass
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/***********************************************
+ * TEST BLOCKING QUEUE
+ * Unit tests for the blocking_queue class
+ ***********************************************/
+class TestBlockingQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_zeroCapacity();
+
+      // Insert
+      test_push_standard();
+      test_pushFor_full();
+
+      // Remove
+      test_tryPop_empty();
+      test_popFor_timeout();
+      test_popBatch_some();
+      test_popBatch_all();
+      test_drain_standard();
+
+      // Close
+      test_close_wakesConsumer();
+      test_close_rejectsPush();
+
+      // Concurrent
+      test_producersConsumers_concurrent();
+
+      report("BlockingQueue");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, empty and effectively unbounded
+   void test_construct_default()
+   {  // exercise
+      custom::blocking_queue<int> q;
+      // verify
+      assertUnit(q.pending.empty());
+      assertUnit(!q.closed);
+      assertUnit(q.max_size() == std::numeric_limits<size_t>::max());
+      assertUnit(q.empty());
+   }  // teardown
+
+   // a capacity of zero would deadlock, so it becomes one
+   void test_construct_zeroCapacity()
+   {  // exercise
+      custom::blocking_queue<int> q(0);
+      // verify
+      assertUnit(q.capacity == 1);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push three, pop them back in order
+   void test_push_standard()
+   {  // setup
+      custom::blocking_queue<int> q(3);
+      int value = 0;
+      // exercise
+      assertUnit(q.push(11));
+      assertUnit(q.push(26));
+      assertUnit(q.push(31));
+      // verify
+      assertUnit(q.size() == 3);
+      assertUnit(q.pop(value) && value == 11);
+      assertUnit(q.pop(value) && value == 26);
+      assertUnit(q.pop(value) && value == 31);
+      assertUnit(q.empty());
+   }  // teardown
+
+   // a full queue times out instead of growing
+   void test_pushFor_full()
+   {  // setup
+      custom::blocking_queue<int> q(2);
+      q.push(11);
+      q.push(26);
+      // exercise
+      bool pushed = q.push_for(31, std::chrono::milliseconds(10));
+      // verify
+      assertUnit(!pushed);
+      assertUnit(q.size() == 2);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // nothing to take, nothing taken
+   void test_tryPop_empty()
+   {  // setup
+      custom::blocking_queue<int> q;
+      int value = 99;
+      // exercise
+      bool popped = q.try_pop(value);
+      // verify
+      assertUnit(!popped);
+      assertUnit(value == 99);
+   }  // teardown
+
+   // waiting on an empty queue gives up
+   void test_popFor_timeout()
+   {  // setup
+      custom::blocking_queue<int> q;
+      int value = 99;
+      // exercise
+      bool popped = q.pop_for(value, std::chrono::milliseconds(10));
+      // verify
+      assertUnit(!popped);
+      assertUnit(value == 99);
+   }  // teardown
+
+   // take two of [11][26][31], leaving [31]
+   void test_popBatch_some()
+   {  // setup
+      custom::blocking_queue<int> q;
+      q.push(11);
+      q.push(26);
+      q.push(31);
+      custom::list<int> out{ 99 };
+      // exercise
+      size_t count = q.pop_batch(out, 2);
+      // verify
+      assertUnit(count == 2);
+      assertUnit(out.size() == 3);
+      custom::list<int>::iterator it = out.begin();
+      assertUnit(*it == 99);
+      ++it;
+      assertUnit(*it == 11);
+      ++it;
+      assertUnit(*it == 26);
+      assertUnit(q.size() == 1);
+      assertUnit(q.pending.front() == 31);
+   }  // teardown
+
+   // the nodes themselves move out, nothing is copied
+   void test_popBatch_all()
+   {  // setup
+      custom::blocking_queue<int> q;
+      q.push(11);
+      q.push(26);
+      int * p11 = &q.pending.front();
+      custom::list<int> out;
+      // exercise
+      size_t count = q.pop_batch(out);
+      // verify
+      assertUnit(count == 2);
+      assertUnit(&out.front() == p11);
+      assertUnit(out.back() == 26);
+      assertUnit(q.pending.empty());
+   }  // teardown
+
+   // drain never waits
+   void test_drain_standard()
+   {  // setup
+      custom::blocking_queue<int> q;
+      custom::list<int> out;
+      // exercise
+      size_t countEmpty = q.drain(out);
+      q.push(11);
+      q.push(26);
+      size_t count = q.drain(out);
+      // verify
+      assertUnit(countEmpty == 0);
+      assertUnit(count == 2);
+      assertUnit(out.size() == 2);
+      assertUnit(q.empty());
+   }  // teardown
+
+   /***************************************
+    * CLOSE
+    ***************************************/
+
+   // a consumer blocked on an empty queue wakes up and gets false
+   void test_close_wakesConsumer()
+   {  // setup
+      custom::blocking_queue<int> q;
+      std::atomic<int> result(-1);
+      std::thread consumer([&q, &result]()
+      {
+         int value;
+         result = q.pop(value) ? 1 : 0;
+      });
+      // exercise
+      q.close();
+      consumer.join();
+      // verify
+      assertUnit(result == 0);
+      assertUnit(q.is_closed());
+   }  // teardown
+
+   // after close, pushes fail but pending items still come out
+   void test_close_rejectsPush()
+   {  // setup
+      custom::blocking_queue<int> q;
+      q.push(11);
+      int value = 0;
+      // exercise
+      q.close();
+      // verify
+      assertUnit(!q.push(26));
+      assertUnit(q.pop(value) && value == 11);
+      assertUnit(!q.pop(value));
+      custom::list<int> out;
+      assertUnit(q.pop_batch(out) == 0);
+   }  // teardown
+
+   /***************************************
+    * CONCURRENT
+    ***************************************/
+
+   // every item pushed through a small queue comes out exactly once
+   void test_producersConsumers_concurrent()
+   {  // setup
+      custom::blocking_queue<int> q(16);
+      const int numProducers = 4;
+      const int numEach = 2000;
+      std::vector<std::atomic<int>> seen(numProducers * numEach);
+      std::vector<std::thread> producers;
+      std::vector<std::thread> consumers;
+      // exercise
+      for (int t = 0; t < 3; t++)
+         consumers.emplace_back([&q, &seen, t]()
+         {
+            custom::list<int> batch;
+            int value;
+            if (t == 0)
+               while (q.pop(value))
+                  seen[value]++;
+            else
+               while (q.pop_batch(batch, 8 * t))
+               {
+                  for (custom::list<int>::iterator it = batch.begin(); it != batch.end(); ++it)
+                     seen[*it]++;
+                  batch.clear();
+               }
+         });
+      for (int t = 0; t < numProducers; t++)
+         producers.emplace_back([&q, t]()
+         {
+            for (int i = 0; i < numEach; i++)
+               q.push(t * numEach + i);
+         });
+      for (std::thread & producer : producers)
+         producer.join();
+      q.close();
+      for (std::thread & consumer : consumers)
+         consumer.join();
+      // verify
+      bool exactlyOnce = true;
+      for (std::atomic<int> & count : seen)
+         if (count != 1)
+            exactlyOnce = false;
+      assertUnit(exactlyOnce);
+      assertUnit(q.empty());
+   }  // teardown
+};
+
+#endif // DEBUG
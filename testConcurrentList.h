@@ -0,0 +1,505 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT LIST
+ * Summary:
+ *    Unit tests for concurrent_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrentList.h"   // class under test
+#include "unitTest.h"         // unit test baseclass
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/***********************************************
+ * TEST CONCURRENT LIST
+ * Unit tests for the concurrent_list class
+ ***********************************************/
+class TestConcurrentList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Insert
+      test_pushback_standard();
+      test_pushfront_standard();
+      test_insert_standardMiddle();
+      test_insert_end();
+
+      // Remove
+      test_erase_standardMiddle();
+      test_popfront_empty();
+      test_popfront_standard();
+
+      // Concurrent
+      test_pushback_concurrent();
+      test_mixed_concurrent();
+
+      // Hazard
+      test_hazard_walk();
+      test_hazard_eraseDeferred();
+      test_hazard_eraseSuccessorPinned();
+      test_hazard_noReadersNoRetire();
+      test_hazard_reclaimBacksOff();
+      test_hazard_concurrent();
+
+      report("ConcurrentList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, just the two sentinels
+   void test_construct_default()
+   {  // exercise
+      custom::concurrent_list<int> l;
+      // verify
+      assertUnit(l.numElements == 0);
+      assertUnit(l.pHead != nullptr);
+      assertUnit(l.pTail != nullptr);
+      if (l.pHead && l.pTail)
+      {
+         assertUnit(l.pHead->pNext == l.pTail);
+         assertUnit(l.pTail->pPrev == l.pHead);
+      }
+      assertUnit(l.empty());
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push three items onto the back
+   void test_pushback_standard()
+   {  // setup
+      custom::concurrent_list<int> l;
+      // exercise
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // push three items onto the front
+   void test_pushfront_standard()
+   {  // setup
+      custom::concurrent_list<int> l;
+      // exercise
+      l.push_front(31);
+      l.push_front(26);
+      l.push_front(11);
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // insert 26 in front of 31
+   void test_insert_standardMiddle()
+   {  // setup
+      custom::concurrent_list<int> l;
+      l.push_back(11);
+      l.push_back(31);
+      custom::concurrent_list<int>::iterator it = l.begin();
+      ++it;
+      // exercise
+      custom::concurrent_list<int>::iterator itNew = l.insert(it, 26);
+      // verify
+      assertUnit(it == l.end());
+      assertUnit(itNew != l.end());
+      if (itNew != l.end())
+         assertUnit(*itNew == 26);
+      assertUnit(itNew.lockPrev.owns_lock());
+      assertUnit(itNew.lockCurr.owns_lock());
+      itNew.release();
+      assertStandardFixture(l);
+   }  // teardown
+
+   // insert at end() is a push_back
+   void test_insert_end()
+   {  // setup
+      custom::concurrent_list<int> l;
+      l.push_back(11);
+      l.push_back(26);
+      custom::concurrent_list<int>::iterator it = l.end();
+      // exercise
+      custom::concurrent_list<int>::iterator itNew = l.insert(it, 31);
+      // verify
+      if (itNew != l.end())
+         assertUnit(*itNew == 31);
+      itNew.release();
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase 99 from [11][99][26][31]
+   void test_erase_standardMiddle()
+   {  // setup
+      custom::concurrent_list<int> l;
+      l.push_back(11);
+      l.push_back(99);
+      l.push_back(26);
+      l.push_back(31);
+      custom::concurrent_list<int>::iterator it = l.begin();
+      ++it;
+      // exercise
+      custom::concurrent_list<int>::iterator itNext = l.erase(it);
+      // verify
+      assertUnit(itNext != l.end());
+      if (itNext != l.end())
+         assertUnit(*itNext == 26);
+      itNext.release();
+      assertStandardFixture(l);
+   }  // teardown
+
+   // pop from an empty list
+   void test_popfront_empty()
+   {  // setup
+      custom::concurrent_list<int> l;
+      int value = 99;
+      // exercise
+      bool popped = l.pop_front(value);
+      // verify
+      assertUnit(popped == false);
+      assertUnit(value == 99);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // pop 99 from [99][11][26][31]
+   void test_popfront_standard()
+   {  // setup
+      custom::concurrent_list<int> l;
+      l.push_back(99);
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      int value = 0;
+      // exercise
+      bool popped = l.pop_front(value);
+      // verify
+      assertUnit(popped == true);
+      assertUnit(value == 99);
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * CONCURRENT
+    ***************************************/
+
+   // many threads pushing onto both ends at once
+   void test_pushback_concurrent()
+   {  // setup
+      custom::concurrent_list<int> l;
+      const int numThreads = 8;
+      const int numEach = 1000;
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.emplace_back([&l, t]()
+         {
+            for (int i = 0; i < numEach; i++)
+               if (t % 2)
+                  l.push_back(i);
+               else
+                  l.push_front(i);
+         });
+      for (std::thread & thread : threads)
+         thread.join();
+      // verify
+      assertUnit(l.size() == numThreads * numEach);
+      assertUnit(countLinks(l) == numThreads * numEach);
+      assertUnit(linksConsistent(l));
+   }  // teardown
+
+   // threads inserting and erasing through iterators while others push
+   void test_mixed_concurrent()
+   {  // setup
+      custom::concurrent_list<int> l;
+      for (int i = 0; i < 1000; i++)
+         l.push_back(i);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 4; t++)
+         threads.emplace_back([&l]()
+         {  // remove every odd value we come across
+            custom::concurrent_list<int>::iterator it = l.begin();
+            while (it != l.end())
+               if (*it % 2)
+                  it = l.erase(it);
+               else
+                  ++it;
+         });
+      for (int t = 0; t < 2; t++)
+         threads.emplace_back([&l]()
+         {  // put a 0 in front of every 100th item
+            custom::concurrent_list<int>::iterator it = l.begin();
+            for (int i = 0; it != l.end(); i++)
+               if (i % 100 == 0)
+               {
+                  it = l.insert(it, 0);
+                  ++it;
+                  ++it;
+               }
+               else
+                  ++it;
+         });
+      for (int t = 0; t < 2; t++)
+         threads.emplace_back([&l]()
+         {
+            for (int i = 0; i < 500; i++)
+               l.push_back(2 * i);
+         });
+      for (std::thread & thread : threads)
+         thread.join();
+      // verify
+      assertUnit(countLinks(l) == l.size());
+      assertUnit(linksConsistent(l));
+      int numOdd = 0;
+      l.for_each([&numOdd](int & value) { numOdd += value % 2; });
+      assertUnit(numOdd == 0);
+   }  // teardown
+
+   /***************************************
+    * HAZARD
+    ***************************************/
+
+   // a hazard iterator reads 11, 26, 31 without taking a lock
+   void test_hazard_walk()
+   {  // setup
+      custom::concurrent_list<int> l;
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      std::vector<int> values;
+      // exercise
+      {
+         custom::concurrent_list<int>::hazard_iterator it = l.hazard_begin();
+         assertUnit(l.numReaders == 1);
+         for (; it != l.end(); ++it)
+            values.push_back(*it);
+      }
+      // verify
+      assertUnit(values == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.numReaders == 0);
+      assertUnit(l.pHazards.load() != nullptr);
+      if (l.pHazards.load())
+      {
+         assertUnit(!l.pHazards.load()->inUse);
+         assertUnit(l.pHazards.load()->p[0].load() == nullptr);
+         assertUnit(l.pHazards.load()->p[1].load() == nullptr);
+      }
+      assertStandardFixture(l);
+   }  // teardown
+
+   // erasing the node a reader stands on leaves it allocated
+   void test_hazard_eraseDeferred()
+   {  // setup
+      custom::concurrent_list<int> l;
+      l.push_back(11);
+      l.push_back(99);
+      l.push_back(26);
+      l.push_back(31);
+      custom::concurrent_list<int>::hazard_iterator itRead = l.hazard_begin();
+      ++itRead;
+      {
+         custom::concurrent_list<int>::iterator it = l.begin();
+         ++it;
+         // exercise
+         l.erase(it);
+      }
+      // verify
+      assertUnit(l.retired.size() == 1);
+      assertUnit(*itRead == 99);
+      l.collect();
+      assertUnit(l.retired.size() == 1);
+      ++itRead;
+      assertUnit(*itRead == 26);
+      l.collect();
+      assertUnit(l.retired.empty());
+      assertStandardFixture(l);
+   }  // teardown
+
+   // a reader on an erased node can still step to its erased successor
+   void test_hazard_eraseSuccessorPinned()
+   {  // setup
+      custom::concurrent_list<int> l;
+      l.push_back(11);
+      l.push_back(98);
+      l.push_back(99);
+      l.push_back(26);
+      l.push_back(31);
+      std::vector<int> values;
+      {
+         custom::concurrent_list<int>::hazard_iterator itRead = l.hazard_begin();
+         ++itRead;
+         values.push_back(*itRead);
+         // exercise
+         {
+            custom::concurrent_list<int>::iterator it = l.begin();
+            ++it;
+            it = l.erase(it);
+            it = l.erase(it);
+         }
+         l.collect();
+         assertUnit(l.retired.size() == 2);
+         for (++itRead; itRead != l.end(); ++itRead)
+            values.push_back(*itRead);
+      }
+      l.collect();
+      // verify
+      assertUnit(values == std::vector<int>({ 98, 99, 26, 31 }));
+      assertUnit(l.retired.empty());
+      assertStandardFixture(l);
+   }  // teardown
+
+   // with nobody reading, erase frees at once
+   void test_hazard_noReadersNoRetire()
+   {  // setup
+      custom::concurrent_list<int> l;
+      l.push_back(11);
+      l.push_back(99);
+      l.push_back(26);
+      l.push_back(31);
+      {
+         custom::concurrent_list<int>::hazard_iterator itRead = l.hazard_begin();
+      }
+      custom::concurrent_list<int>::iterator it = l.begin();
+      ++it;
+      // exercise
+      l.erase(it);
+      // verify
+      assertUnit(l.retired.empty());
+      assertStandardFixture(l);
+   }  // teardown
+
+   // nodes a reader pins raise the bar for the next reclaim
+   void test_hazard_reclaimBacksOff()
+   {  // setup
+      custom::concurrent_list<int> l;
+      for (int i = 0; i < 200; i++)
+         l.push_back(i);
+      std::vector<int> values;
+      {
+         custom::concurrent_list<int>::hazard_iterator itRead = l.hazard_begin();
+         int value;
+         // exercise
+         for (int i = 0; i < 200; i++)
+            l.pop_front(value);
+         // verify
+         assertUnit(l.retired.size() == 200);  // reclaimed at 64 and 128, kept all
+         assertUnit(l.reclaimAt == 256);
+         for (; itRead != l.end(); ++itRead)
+            values.push_back(*itRead);
+      }
+      assertUnit(values.size() == 200 && values[0] == 0 && values[199] == 199);
+      l.collect();
+      assertUnit(l.retired.empty());
+      assertUnit(l.reclaimAt == 64);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // readers walk while other threads pop and push
+   void test_hazard_concurrent()
+   {  // setup
+      custom::concurrent_list<int> l;
+      for (int i = 0; i < 200; i++)
+         l.push_back(i);
+      std::atomic<bool> done(false);
+      std::atomic<bool> sawGarbage(false);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 4; t++)
+         threads.emplace_back([&]()
+         {
+            while (!done)
+               for (custom::concurrent_list<int>::hazard_iterator it = l.hazard_begin();
+                    it != l.end(); ++it)
+                  if (*it < 0 || *it >= 5000)
+                     sawGarbage = true;
+         });
+      for (int t = 0; t < 2; t++)
+         threads.emplace_back([&l, t]()
+         {
+            int value;
+            for (int i = 0; i < 2400; i++)
+               if (l.pop_front(value))
+                  l.push_back(200 + t * 2400 + i);
+         });
+      for (size_t t = 4; t < threads.size(); t++)
+         threads[t].join();
+      done = true;
+      for (size_t t = 0; t < 4; t++)
+         threads[t].join();
+      l.collect();
+      // verify
+      assertUnit(!sawGarbage);
+      assertUnit(l.retired.empty());
+      assertUnit(l.size() == 200);
+      assertUnit(countLinks(l) == 200);
+      assertUnit(linksConsistent(l));
+   }  // teardown
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *        pHead                      pTail
+    *       +---+   +----+   +----+   +----+   +---+
+    *       |   | - | 11 | - | 26 | - | 31 | - |   |
+    *       +---+   +----+   +----+   +----+   +---+
+    ****************************************************************/
+   void assertStandardFixtureParameters(const custom::concurrent_list<int> & l,
+                                        int line, const char * function)
+   {
+      assertIndirect(l.numElements == 3);
+      assertIndirect(countLinks(l) == 3);
+      assertIndirect(linksConsistent(l));
+      if (countLinks(l) == 3)
+      {
+         assertIndirect(data(l.pHead->pNext) == 11);
+         assertIndirect(data(l.pHead->pNext.load()->pNext) == 26);
+         assertIndirect(data(l.pHead->pNext.load()->pNext.load()->pNext) == 31);
+      }
+   }
+
+   // count the nodes between the sentinels
+   size_t countLinks(const custom::concurrent_list<int> & l)
+   {
+      size_t count = 0;
+      for (const custom::concurrent_list<int>::Link * p = l.pHead->pNext;
+           p != l.pTail && p; p = p->pNext)
+         count++;
+      return count;
+   }
+
+   // every pNext has a matching pPrev
+   bool linksConsistent(const custom::concurrent_list<int> & l)
+   {
+      for (const custom::concurrent_list<int>::Link * p = l.pHead; p != l.pTail; p = p->pNext)
+         if (p->pNext == nullptr || p->pNext.load()->pPrev != p)
+            return false;
+      return true;
+   }
+
+   // fetch the data out of a link
+   int data(custom::concurrent_list<int>::Link * p)
+   {
+      return static_cast <custom::concurrent_list<int>::Node *> (p)->data;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,221 @@
+/***********************************************************************
+ * Header:
+ *    TEST COW LIST
+ * Summary:
+ *    Unit tests for cow_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "cowList.h"      // class under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <thread>
+#include <vector>
+
+/***********************************************
+ * TEST COW LIST
+ * Unit tests for the cow_list class
+ ***********************************************/
+class TestCowList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+      test_construct_adoptList();
+
+      // Copy
+      test_copy_shares();
+      test_write_clonesShared();
+      test_write_keepsUnique();
+      test_clear_leavesOthers();
+
+      // Iterator
+      test_iterator_standard();
+
+      // Concurrent
+      test_snapshots_concurrent();
+
+      report("CowList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, nothing allocated
+   void test_construct_default()
+   {  // exercise
+      custom::cow_list<int> l;
+      // verify
+      assertUnit(l.pList == nullptr);
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(!l.shared());
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   // build from {11, 26, 31}
+   void test_construct_initializerList()
+   {  // exercise
+      custom::cow_list<int> l{ 11, 26, 31 };
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.front() == 11);
+      assertUnit(l.back() == 31);
+   }  // teardown
+
+   // take over a list's nodes without copying them
+   void test_construct_adoptList()
+   {  // setup
+      custom::list<int> lSource{ 11, 26, 31 };
+      int * p11 = &lSource.front();
+      // exercise
+      custom::cow_list<int> l(std::move(lSource));
+      // verify
+      assertUnit(&l.front() == p11);
+      assertUnit(l.size() == 3);
+   }  // teardown
+
+   /***************************************
+    * COPY
+    ***************************************/
+
+   // a copy is the same list with one more reference
+   void test_copy_shares()
+   {  // setup
+      custom::cow_list<int> l{ 11, 26, 31 };
+      // exercise
+      custom::cow_list<int> lCopy(l);
+      // verify
+      assertUnit(lCopy.pList == l.pList);
+      assertUnit(l.pList.use_count() == 2);
+      assertUnit(l.shared());
+      assertUnit(&lCopy.front() == &l.front());
+   }  // teardown
+
+   // the first write to a shared list clones it; the original is untouched
+   void test_write_clonesShared()
+   {  // setup
+      custom::cow_list<int> l{ 11, 26, 31 };
+      custom::cow_list<int> lCopy(l);
+      const int * p11 = &l.front();
+      // exercise
+      lCopy.push_back(99);
+      // verify
+      assertUnit(lCopy.pList != l.pList);
+      assertUnit(!l.shared());
+      assertUnit(!lCopy.shared());
+      assertUnit(&l.front() == p11);
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(contents(lCopy) == std::vector<int>({ 11, 26, 31, 99 }));
+   }  // teardown
+
+   // writing to a list nobody else sees does not copy
+   void test_write_keepsUnique()
+   {  // setup
+      custom::cow_list<int> l{ 11, 26, 31 };
+      custom::list<int> * pBefore = l.pList.get();
+      // exercise
+      l.pop_front();
+      l.write().push_front(99);
+      // verify
+      assertUnit(l.pList.get() == pBefore);
+      assertUnit(contents(l) == std::vector<int>({ 99, 26, 31 }));
+   }  // teardown
+
+   // clearing a shared list just lets go of it
+   void test_clear_leavesOthers()
+   {  // setup
+      custom::cow_list<int> l{ 11, 26, 31 };
+      custom::cow_list<int> lCopy(l);
+      // exercise
+      lCopy.clear();
+      // verify
+      assertUnit(lCopy.pList == nullptr);
+      assertUnit(lCopy.empty());
+      assertUnit(l.size() == 3);
+      assertUnit(!l.shared());
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // walk with the const iterator, pre and post increment
+   void test_iterator_standard()
+   {  // setup
+      custom::cow_list<int> l{ 11, 26, 31 };
+      // exercise
+      custom::cow_list<int>::const_iterator it = l.cbegin();
+      int first = *it++;
+      int second = *it;
+      ++it;
+      int third = *it;
+      ++it;
+      // verify
+      assertUnit(first == 11);
+      assertUnit(second == 26);
+      assertUnit(third == 31);
+      assertUnit(it == l.cend());
+   }  // teardown
+
+   /***************************************
+    * CONCURRENT
+    ***************************************/
+
+   // threads take snapshots and modify their own copies
+   void test_snapshots_concurrent()
+   {  // setup
+      custom::cow_list<int> l;
+      for (int i = 0; i < 100; i++)
+         l.push_back(i);
+      std::vector<std::thread> threads;
+      std::vector<int> ok(4, 0);
+      // exercise
+      for (int t = 0; t < 4; t++)
+         threads.emplace_back([&l, &ok, t]()
+         {
+            bool good = true;
+            for (int i = 0; i < 200; i++)
+            {
+               custom::cow_list<int> snapshot(l);
+               int sum = 0;
+               snapshot.for_each([&sum](const int & value) { sum += value; });
+               good = good && sum == 4950;
+               if (i % 10 == t)
+               {
+                  snapshot.push_back(t);
+                  good = good && snapshot.size() == 101;
+               }
+            }
+            ok[t] = good ? 1 : 0;
+         });
+      for (std::thread & thread : threads)
+         thread.join();
+      // verify
+      assertUnit(ok == std::vector<int>(4, 1));
+      assertUnit(l.size() == 100);
+      assertUnit(!l.shared());
+   }  // teardown
+
+   // read the list out through the const iterator
+   std::vector<int> contents(const custom::cow_list<int> & l)
+   {
+      std::vector<int> values;
+      for (custom::cow_list<int>::const_iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,223 @@
+/***********************************************************************
+ * Header:
+ *    TEST FORWARD LIST
+ * Summary:
+ *    Unit tests for forward_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "forwardList.h"  // class under test
+#include "spy.h"          // for the Spy class
+#include "unitTest.h"     // unit test baseclass
+
+#include <utility>
+#include <vector>
+
+/***********************************************
+ * TEST FORWARD LIST
+ * Unit tests for the forward_list class
+ ***********************************************/
+class TestForwardList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+      test_construct_copy();
+      test_construct_move();
+      test_node_oneLink();
+
+      // Insert
+      test_push_backFront();
+      test_insertAfter_tail();
+
+      // Remove
+      test_popFront_toEmpty();
+      test_eraseAfter_tail();
+      test_clear_destroysAll();
+
+      // Splice
+      test_spliceBack_empty();
+
+      report("ForwardList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no nodes
+   void test_construct_default()
+   {  // exercise
+      custom::forward_list<int> l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   // build from {11, 26, 31}
+   void test_construct_initializerList()
+   {  // exercise
+      custom::forward_list<int> l{ 11, 26, 31 };
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.front() == 11);
+      assertUnit(l.back() == 31);
+      assertUnit(l.pTail->pNext == nullptr);
+   }  // teardown
+
+   // a copy has its own nodes
+   void test_construct_copy()
+   {  // setup
+      custom::forward_list<int> lSource{ 11, 26, 31 };
+      // exercise
+      custom::forward_list<int> lCopy(lSource);
+      lCopy.push_back(49);
+      // verify
+      assertUnit(contents(lSource) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(contents(lCopy) == std::vector<int>({ 11, 26, 31, 49 }));
+      assertUnit(lCopy.pHead != lSource.pHead);
+   }  // teardown
+
+   // moving hands over the nodes
+   void test_construct_move()
+   {  // setup
+      custom::forward_list<int> lSource{ 11, 26 };
+      // exercise
+      custom::forward_list<int> lDest(std::move(lSource));
+      // verify
+      assertUnit(lSource.empty());
+      assertUnit(lSource.pTail == nullptr);
+      assertUnit(contents(lDest) == std::vector<int>({ 11, 26 }));
+   }  // teardown
+
+   // a node is one pointer smaller than a list node
+   void test_node_oneLink()
+   {  // verify
+      assertUnit(sizeof(custom::forward_list<void *>::Node) == 2 * sizeof(void *));
+   }
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push at both ends keeps the tail right
+   void test_push_backFront()
+   {  // setup
+      custom::forward_list<int> l;
+      // exercise
+      l.push_back(26);
+      l.push_front(11);
+      l.push_back(31);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.back() == 31);
+      assertUnit(l.size() == 3);
+   }  // teardown
+
+   // inserting after the last element moves the tail
+   void test_insertAfter_tail()
+   {  // setup
+      custom::forward_list<int> l{ 11, 31 };
+      // exercise
+      custom::forward_list<int>::iterator it = l.insert_after(l.begin(), 26);
+      l.insert_after(custom::forward_list<int>::iterator(l.pTail), 49);
+      l.push_back(57);
+      // verify
+      assertUnit(*it == 26);
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31, 49, 57 }));
+      assertUnit(l.size() == 5);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // a queue drained from the front
+   void test_popFront_toEmpty()
+   {  // setup
+      custom::forward_list<int> l{ 11, 26 };
+      // exercise
+      l.pop_front();
+      l.pop_front();
+      l.pop_front();
+      l.push_back(31);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 31 }));
+      assertUnit(l.pHead == l.pTail);
+   }  // teardown
+
+   // erasing the last element pulls the tail back
+   void test_eraseAfter_tail()
+   {  // setup
+      custom::forward_list<int> l{ 11, 26, 31 };
+      custom::forward_list<int>::iterator itSecond = ++l.begin();
+      // exercise
+      custom::forward_list<int>::iterator it = l.erase_after(itSecond);
+      custom::forward_list<int>::iterator itNone = l.erase_after(itSecond);
+      l.push_back(49);
+      // verify
+      assertUnit(it == custom::forward_list<int>::iterator());
+      assertUnit(itNone == l.end());
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 49 }));
+      assertUnit(l.size() == 3);
+   }  // teardown
+
+   // clear destroys every element once
+   void test_clear_destroysAll()
+   {  // setup
+      custom::forward_list<Spy> l;
+      l.push_back(Spy(11));
+      l.push_back(Spy(26));
+      Spy::reset();
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 2);
+      assertUnit(l.empty());
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
+   /***************************************
+    * SPLICE
+    ***************************************/
+
+   // append a whole list, including onto an empty one
+   void test_spliceBack_empty()
+   {  // setup
+      custom::forward_list<int> l;
+      custom::forward_list<int> lFirst{ 11, 26 };
+      custom::forward_list<int> lSecond{ 31 };
+      // exercise
+      l.splice_back(lFirst);
+      l.splice_back(lSecond);
+      // verify
+      assertUnit(lFirst.empty() && lSecond.empty());
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.back() == 31);
+      assertUnit(l.size() == 3);
+   }  // teardown
+
+   // read the list out front to back
+   std::vector<int> contents(custom::forward_list<int> & l)
+   {
+      std::vector<int> values;
+      for (custom::forward_list<int>::iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,337 @@
+/***********************************************************************
+ * Header:
+ *    TEST HASH
+ * Summary:
+ *    Unit tests for unordered_map
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "unorderedMap.h" // class under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/***********************************************
+ * TEST HASH
+ * Unit tests for the unordered_map class
+ ***********************************************/
+class TestHash : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+      test_construct_copy();
+
+      // Insert
+      test_insert_new();
+      test_insert_duplicate();
+      test_square_addsDefault();
+
+      // Access
+      test_find_collisions();
+      test_at_missing();
+
+      // Remove
+      test_erase_key();
+      test_erase_iteratorWalk();
+      test_clear_keepsBuckets();
+
+      // Rehash
+      test_rehash_keepsOrder();
+      test_random_againstMap();
+
+      report("Hash");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, eight empty buckets
+   void test_construct_default()
+   {  // exercise
+      custom::unordered_map<int, int> m;
+      // verify
+      assertUnit(m.empty());
+      assertUnit(m.size() == 0);
+      assertUnit(m.bucket_count() == 8);
+      assertUnit(m.begin() == m.end());
+      assertUnit(m.find(11) == m.end());
+      assertUnit(bucketsValid(m));
+   }  // teardown
+
+   // build from {{31,1}, {11,2}, {26,3}}, kept in that order
+   void test_construct_initializerList()
+   {  // exercise
+      custom::unordered_map<int, int> m{ {31, 1}, {11, 2}, {26, 3} };
+      // verify
+      assertUnit(keys(m) == std::vector<int>({ 31, 11, 26 }));
+      assertUnit(m.at(11) == 2);
+      assertUnit(bucketsValid(m));
+   }  // teardown
+
+   // a copy owns its own entries and chains
+   void test_construct_copy()
+   {  // setup
+      custom::unordered_map<int, int> mSource{ {31, 1}, {11, 2}, {26, 3} };
+      // exercise
+      custom::unordered_map<int, int> mCopy(mSource);
+      mCopy[11] = 99;
+      mCopy.erase(31);
+      // verify
+      assertUnit(keys(mSource) == std::vector<int>({ 31, 11, 26 }));
+      assertUnit(mSource.at(11) == 2);
+      assertUnit(keys(mCopy) == std::vector<int>({ 11, 26 }));
+      assertUnit(mCopy.at(11) == 99);
+      assertUnit(bucketsValid(mSource));
+      assertUnit(bucketsValid(mCopy));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // insert appends to the end of the iteration order
+   void test_insert_new()
+   {  // setup
+      custom::unordered_map<std::string, int> m;
+      // exercise
+      std::pair<custom::unordered_map<std::string, int>::iterator, bool> result =
+         m.insert(std::make_pair(std::string("twenty-six"), 26));
+      m.insert(std::make_pair(std::string("eleven"), 11));
+      // verify
+      assertUnit(result.second);
+      assertUnit(result.first->first == "twenty-six");
+      assertUnit(result.first->second == 26);
+      assertUnit(m.size() == 2);
+      assertUnit(m.begin()->first == "twenty-six");
+      assertUnit(m.find("eleven")->second == 11);
+   }  // teardown
+
+   // inserting a key already present changes nothing
+   void test_insert_duplicate()
+   {  // setup
+      custom::unordered_map<int, int> m{ {11, 1}, {26, 2} };
+      // exercise
+      std::pair<custom::unordered_map<int, int>::iterator, bool> result =
+         m.insert(std::make_pair(11, 99));
+      // verify
+      assertUnit(!result.second);
+      assertUnit(result.first == m.begin());
+      assertUnit(m.at(11) == 1);
+      assertUnit(m.size() == 2);
+   }  // teardown
+
+   // [] on a missing key appends a default value
+   void test_square_addsDefault()
+   {  // setup
+      custom::unordered_map<int, int> m{ {11, 1} };
+      // exercise
+      m[26] += 5;
+      m[11] += 5;
+      // verify
+      assertUnit(keys(m) == std::vector<int>({ 11, 26 }));
+      assertUnit(m.at(11) == 6);
+      assertUnit(m.at(26) == 5);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // keys that share a bucket are told apart by the chain walk
+   void test_find_collisions()
+   {  // setup
+      custom::unordered_map<int, int, SameHash> m(4);
+      for (int i = 0; i < 6; i++)
+         m[i] = i * 10;
+      // exercise
+      custom::unordered_map<int, int, SameHash>::iterator it = m.find(3);
+      // verify
+      assertUnit(it != m.end());
+      assertUnit(it->second == 30);
+      assertUnit(m.find(6) == m.end());
+      assertUnit(m.bucket_size(0) == 6);
+      assertUnit(m.count(5) == 1);
+      assertUnit(!m.contains(7));
+      assertUnit(bucketsValid(m));
+   }  // teardown
+
+   // at() on a missing key throws
+   void test_at_missing()
+   {  // setup
+      custom::unordered_map<int, int> m{ {11, 1} };
+      bool thrown = false;
+      // exercise
+      try
+      {
+         m.at(26);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(m.size() == 1);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase by key from the middle of a shared chain
+   void test_erase_key()
+   {  // setup
+      custom::unordered_map<int, int, SameHash> m(4);
+      for (int i = 0; i < 5; i++)
+         m[i] = i;
+      // exercise
+      size_t removed = m.erase(2);
+      size_t missing = m.erase(2);
+      // verify
+      assertUnit(removed == 1);
+      assertUnit(missing == 0);
+      assertUnit(keys(m) == std::vector<int>({ 0, 1, 3, 4 }));
+      assertUnit(m.find(2) == m.end());
+      assertUnit(m.find(3) != m.end());
+      assertUnit(bucketsValid(m));
+   }  // teardown
+
+   // erase(it) hands back the next element in insertion order
+   void test_erase_iteratorWalk()
+   {  // setup
+      custom::unordered_map<int, int> m;
+      for (int i = 0; i < 10; i++)
+         m[i] = i;
+      // exercise
+      for (custom::unordered_map<int, int>::iterator it = m.begin(); it != m.end(); )
+         if (it->first % 2)
+            it = m.erase(it);
+         else
+            ++it;
+      // verify
+      assertUnit(keys(m) == std::vector<int>({ 0, 2, 4, 6, 8 }));
+      assertUnit(bucketsValid(m));
+   }  // teardown
+
+   // clear empties the map but keeps the table
+   void test_clear_keepsBuckets()
+   {  // setup
+      custom::unordered_map<int, int> m;
+      for (int i = 0; i < 20; i++)
+         m[i] = i;
+      size_t numBuckets = m.bucket_count();
+      // exercise
+      m.clear();
+      m[5] = 5;
+      // verify
+      assertUnit(m.size() == 1);
+      assertUnit(m.bucket_count() == numBuckets);
+      assertUnit(keys(m) == std::vector<int>({ 5 }));
+      assertUnit(bucketsValid(m));
+   }  // teardown
+
+   /***************************************
+    * REHASH
+    ***************************************/
+
+   // growing the table keeps iterators and order
+   void test_rehash_keepsOrder()
+   {  // setup
+      custom::unordered_map<int, int> m(2);
+      m[100] = 0;
+      custom::unordered_map<int, int>::iterator itFirst = m.begin();
+      std::vector<int> expected({ 100 });
+      // exercise
+      for (int i = 99; i > 50; i--)
+      {
+         m[i] = i;
+         expected.push_back(i);
+      }
+      // verify
+      assertUnit(m.bucket_count() >= m.size());
+      assertUnit(m.load_factor() <= 1.0f);
+      assertUnit(itFirst == m.begin());
+      assertUnit(itFirst->first == 100);
+      assertUnit(keys(m) == expected);
+      assertUnit(bucketsValid(m));
+   }  // teardown
+
+   // random inserts and erases agree with std::map
+   void test_random_againstMap()
+   {  // setup
+      custom::unordered_map<int, int> m;
+      std::map<int, int> expected;
+      srand(26);
+      // exercise
+      for (int i = 0; i < 2000; i++)
+      {
+         int key = rand() % 300;
+         if (rand() % 3 == 0)
+            assertUnit(m.erase(key) == expected.erase(key));
+         else
+         {
+            m[key] += i;
+            expected[key] += i;
+         }
+      }
+      // verify
+      assertUnit(m.size() == expected.size());
+      for (const std::pair<const int, int> & pair : expected)
+         assertUnit(m.find(pair.first) != m.end() && m.at(pair.first) == pair.second);
+      assertUnit(bucketsValid(m));
+   }  // teardown
+
+   /***************************************
+    * HELPERS
+    ***************************************/
+
+   // every key hashes to bucket zero
+   struct SameHash
+   {
+      size_t operator () (int) const { return 0; }
+   };
+
+   // the keys in iteration order
+   template <typename K, typename V, typename H>
+   std::vector<K> keys(custom::unordered_map<K, V, H> & m)
+   {
+      std::vector<K> values;
+      for (typename custom::unordered_map<K, V, H>::iterator it = m.begin(); it != m.end(); ++it)
+         values.push_back(it->first);
+      return values;
+   }
+
+   // every entry sits on exactly the chain for its hash
+   template <typename K, typename V, typename H>
+   bool bucketsValid(custom::unordered_map<K, V, H> & m)
+   {
+      size_t numChained = 0;
+      for (size_t i = 0; i < m.buckets.size(); i++)
+         for (auto it = m.buckets[i]; it != m.entries.end(); it = (*it).itNext)
+         {
+            if ((*it).hash % m.buckets.size() != i || (*it).hash != H()((*it).value.first))
+               return false;
+            numChained++;
+         }
+      return numChained == m.entries.size();
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,323 @@
+/***********************************************************************
+ * Header:
+ *    TEST INDEXED LIST
+ * Summary:
+ *    Unit tests for indexed_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "indexedList.h"  // class under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <map>
+#include <vector>
+
+/***********************************************
+ * TEST INDEXED LIST
+ * Unit tests for the indexed_list class
+ ***********************************************/
+class TestIndexedList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_copy();
+
+      // Insert
+      test_pushback_standard();
+      test_pushfront_standard();
+      test_pushfront_onlyShifts();
+      test_insertAt_middle();
+
+      // Access
+      test_at_standard();
+      test_indexOf_standard();
+
+      // Remove
+      test_erase_middle();
+      test_pop_ends();
+
+      // Everything at once
+      test_random_againstVector();
+
+      report("IndexedList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no levels in use
+   void test_construct_default()
+   {  // exercise
+      custom::indexed_list<int> l;
+      // verify
+      assertUnit(l.numElements == 0);
+      assertUnit(l.numLevels == 0);
+      assertUnit(l.first[0] == nullptr);
+      assertUnit(l.tail[0] == nullptr);
+      assertUnit(l.begin() == l.end());
+      assertUnit(l.empty());
+   }  // teardown
+
+   // a copy is independent and just as indexable
+   void test_construct_copy()
+   {  // setup
+      custom::indexed_list<int> l = build({ 11, 26, 31 });
+      // exercise
+      custom::indexed_list<int> lCopy(l);
+      lCopy.at(1) = 99;
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(contents(lCopy) == std::vector<int>({ 11, 99, 31 }));
+      assertUnit(structureValid(lCopy));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push onto the back
+   void test_pushback_standard()
+   {  // setup
+      custom::indexed_list<int> l;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         l.push_back(i);
+      // verify
+      assertUnit(l.size() == 100);
+      assertUnit(l.front() == 0);
+      assertUnit(l.back() == 99);
+      assertUnit(structureValid(l));
+   }  // teardown
+
+   // push onto the front
+   void test_pushfront_standard()
+   {  // setup
+      custom::indexed_list<int> l;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         l.push_front(i);
+      // verify
+      assertUnit(l.size() == 100);
+      assertUnit(l.front() == 99);
+      assertUnit(l.back() == 0);
+      assertUnit(l.at(10) == 89);
+      assertUnit(structureValid(l));
+   }  // teardown
+
+   // pushing on the front moves every position through the shift
+   void test_pushfront_onlyShifts()
+   {  // setup
+      custom::indexed_list<int> l = build({ 26, 31 });
+      size_t tailBefore = l.tailPos[0];
+      // exercise
+      l.push_front(11);
+      // verify
+      assertUnit(l.shift == 1);
+      assertUnit(l.tailPos[0] == tailBefore);
+      assertUnit(l.real(l.tailPos[0]) == 2);
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   // [11][31] -> [11][26][31]
+   void test_insertAt_middle()
+   {  // setup
+      custom::indexed_list<int> l = build({ 11, 31 });
+      // exercise
+      custom::indexed_list<int>::iterator it = l.insert_at(1, 26);
+      // verify
+      assertUnit(*it == 26);
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.index_of(it) == 1);
+      assertUnit(structureValid(l));
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // every index reads back the right value
+   void test_at_standard()
+   {  // setup
+      custom::indexed_list<int> l;
+      for (int i = 0; i < 1000; i++)
+         l.push_back(i * 2);
+      // exercise and verify
+      bool allRight = true;
+      for (size_t i = 0; i < 1000; i++)
+         if (l.at(i) != (int)i * 2 || l[i] != (int)i * 2)
+            allRight = false;
+      assertUnit(allRight);
+      assertUnit(*l.iterator_at(500) == 1000);
+   }  // teardown
+
+   // every node knows where it is
+   void test_indexOf_standard()
+   {  // setup
+      custom::indexed_list<int> l;
+      for (int i = 0; i < 500; i++)
+         l.push_front(i);
+      // exercise and verify
+      bool allRight = true;
+      size_t i = 0;
+      for (custom::indexed_list<int>::iterator it = l.begin(); it != l.end(); ++it, ++i)
+         if (l.index_of(it) != i)
+            allRight = false;
+      assertUnit(allRight);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // [11][99][26][31] -> [11][26][31]
+   void test_erase_middle()
+   {  // setup
+      custom::indexed_list<int> l = build({ 11, 99, 26, 31 });
+      // exercise
+      custom::indexed_list<int>::iterator it = l.erase(l.iterator_at(1));
+      // verify
+      assertUnit(*it == 26);
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(structureValid(l));
+   }  // teardown
+
+   // pop from both ends down to nothing
+   void test_pop_ends()
+   {  // setup
+      custom::indexed_list<int> l = build({ 11, 26, 31, 42 });
+      // exercise
+      l.pop_front();
+      l.pop_back();
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 26, 31 }));
+      assertUnit(structureValid(l));
+      l.pop_back();
+      l.pop_front();
+      l.pop_front();
+      assertUnit(l.empty());
+      assertUnit(l.numLevels == 0);
+      assertUnit(l.first[0] == nullptr && l.tail[0] == nullptr);
+   }  // teardown
+
+   /***************************************
+    * EVERYTHING AT ONCE
+    ***************************************/
+
+   // a few thousand random operations agree with std::vector
+   void test_random_againstVector()
+   {  // setup
+      custom::indexed_list<int> l;
+      std::vector<int> v;
+      unsigned int seed = 12345;
+      bool agree = true;
+      // exercise
+      for (int step = 0; step < 4000; step++)
+      {
+         seed = seed * 1103515245 + 12345;
+         unsigned int r = seed >> 8;
+         size_t i = v.empty() ? 0 : r % (v.size() + 1);
+         switch (r % 7)
+         {
+            case 0: l.push_front(step); v.insert(v.begin(), step); break;
+            case 1: l.push_back(step);  v.push_back(step);         break;
+            case 2:
+            case 3: l.insert_at(i, step); v.insert(v.begin() + i, step); break;
+            case 4:
+            case 5:
+               if (!v.empty())
+               {
+                  i %= v.size();
+                  l.erase(l.iterator_at(i));
+                  v.erase(v.begin() + i);
+               }
+               break;
+            case 6:
+               if (!v.empty())
+               {
+                  i %= v.size();
+                  if (l.at(i) != v[i] || l.index_of(l.iterator_at(i)) != i)
+                     agree = false;
+               }
+               break;
+         }
+      }
+      // verify
+      assertUnit(agree);
+      assertUnit(contents(l) == v);
+      assertUnit(structureValid(l));
+   }  // teardown
+
+   // build a list with push_back
+   custom::indexed_list<int> build(const std::vector<int> & values)
+   {
+      custom::indexed_list<int> l;
+      for (int value : values)
+         l.push_back(value);
+      return l;
+   }
+
+   // read the list out with the iterator
+   std::vector<int> contents(custom::indexed_list<int> & l)
+   {
+      std::vector<int> values;
+      for (custom::indexed_list<int>::iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+
+   // every jump, first, and tail agrees with the real positions
+   bool structureValid(const custom::indexed_list<int> & l)
+   {
+      typedef custom::indexed_list<int>::Node Node;
+      std::map<const Node *, size_t> pos;
+      size_t i = 0;
+      const Node * pPrev = nullptr;
+      for (const Node * p = l.first[0]; p; pPrev = p, p = p->skips[0].pNext)
+      {
+         if (p->pPrev != pPrev)
+            return false;
+         pos[p] = i++;
+      }
+      if (i != l.numElements || l.tail[0] != pPrev)
+         return false;
+
+      for (unsigned L = 0; L < custom::indexed_list<int>::MAX_LEVELS; L++)
+      {
+         // walk level L the slow way and compare
+         const Node * pFirst = nullptr;
+         const Node * pLast = nullptr;
+         for (const Node * p = l.first[0]; p; p = p->skips[0].pNext)
+            if (p->height > L)
+            {
+               if (pLast && (pLast->skips[L].pNext != p ||
+                             pLast->skips[L].width != pos[p] - pos[pLast]))
+                  return false;
+               if (!pFirst)
+                  pFirst = p;
+               pLast = p;
+            }
+         if (l.first[L] != pFirst || l.tail[L] != pLast)
+            return false;
+         if (pFirst && (l.real(l.firstPos[L]) != pos[pFirst] ||
+                        l.real(l.tailPos[L]) != pos[pLast] ||
+                        pLast->skips[L].pNext != nullptr))
+            return false;
+         if (pFirst && L >= l.numLevels)
+            return false;
+      }
+      return true;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,313 @@
+/***********************************************************************
+ * Header:
+ *    TEST INTRUSIVE LIST
+ * Summary:
+ *    Unit tests for intrusive_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "intrusiveList.h" // class under test
+#include "unitTest.h"      // unit test baseclass
+
+#include <utility>
+#include <vector>
+
+/***********************************************
+ * TEST INTRUSIVE LIST
+ * Unit tests for the intrusive_list class
+ ***********************************************/
+class TestIntrusiveList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_move();
+      test_assign_move();
+
+      // Insert
+      test_push_backFront();
+      test_insert_middle();
+
+      // Remove
+      test_erase_middle();
+      test_pop_ends();
+      test_remove_byReference();
+      test_clear_unlinksAll();
+
+      // Hooks
+      test_hooks_twoLists();
+      test_hook_copyUnlinked();
+
+      // Splice
+      test_splice_middle();
+
+      report("IntrusiveList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, nothing linked
+   void test_construct_default()
+   {  // exercise
+      Lru l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   // move constructor takes the chain, elements stay put
+   void test_construct_move()
+   {  // setup
+      Connection a(11), b(26);
+      Lru lSource;
+      lSource.push_back(a);
+      lSource.push_back(b);
+      // exercise
+      Lru lDest(std::move(lSource));
+      // verify
+      assertUnit(lSource.empty());
+      assertUnit(ids(lDest) == std::vector<int>({ 11, 26 }));
+      assertUnit(&lDest.front() == &a);
+   }  // teardown
+
+   // move assignment lets go of what it held and takes over the rest
+   void test_assign_move()
+   {  // setup
+      Connection a(11), b(26), c(99);
+      Lru lSource;
+      lSource.push_back(a);
+      lSource.push_back(b);
+      Lru lDest;
+      lDest.push_back(c);
+      // exercise
+      lDest = std::move(lSource);
+      // verify
+      assertUnit(lSource.empty());
+      assertUnit(lSource.size() == 0);
+      assertUnit(ids(lDest) == std::vector<int>({ 11, 26 }));
+      assertUnit(lDest.size() == 2);
+      assertUnit(!c.lru.is_linked());
+      assertUnit(c.lru.pNext == nullptr && c.lru.pPrev == nullptr);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // the objects themselves are linked, in order
+   void test_push_backFront()
+   {  // setup
+      Connection a(11), b(26), c(31);
+      Lru l;
+      // exercise
+      l.push_back(b);
+      l.push_back(c);
+      l.push_front(a);
+      // verify
+      assertUnit(ids(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(backwards(l) == std::vector<int>({ 31, 26, 11 }));
+      assertUnit(a.lru.pNext == &b);
+      assertUnit(c.lru.pPrev == &b);
+      assertUnit(a.lru.pPrev == nullptr);
+      assertUnit(c.lru.pNext == nullptr);
+      assertUnit(b.lru.is_linked());
+      assertUnit(l.size() == 3);
+   }  // teardown
+
+   // insert in front of an iterator
+   void test_insert_middle()
+   {  // setup
+      Connection a(11), b(26), c(31);
+      Lru l;
+      l.push_back(a);
+      l.push_back(c);
+      // exercise
+      Lru::iterator it = l.insert(Lru::iterator_to(c), b);
+      // verify
+      assertUnit(&*it == &b);
+      assertUnit(ids(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(backwards(l) == std::vector<int>({ 31, 26, 11 }));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase unlinks without destroying and returns the next
+   void test_erase_middle()
+   {  // setup
+      Connection a(11), b(26), c(31);
+      Lru l;
+      l.push_back(a);
+      l.push_back(b);
+      l.push_back(c);
+      // exercise
+      Lru::iterator it = l.erase(Lru::iterator_to(b));
+      // verify
+      assertUnit(&*it == &c);
+      assertUnit(ids(l) == std::vector<int>({ 11, 31 }));
+      assertUnit(backwards(l) == std::vector<int>({ 31, 11 }));
+      assertUnit(!b.lru.is_linked());
+      assertUnit(b.lru.pNext == nullptr && b.lru.pPrev == nullptr);
+      assertUnit(b.id == 26);
+   }  // teardown
+
+   // pop from both ends down to empty
+   void test_pop_ends()
+   {  // setup
+      Connection a(11), b(26);
+      Lru l;
+      l.push_back(a);
+      l.push_back(b);
+      // exercise
+      l.pop_back();
+      l.pop_front();
+      l.pop_front();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.pHead == nullptr && l.pTail == nullptr);
+      assertUnit(!a.lru.is_linked() && !b.lru.is_linked());
+   }  // teardown
+
+   // an element can take itself out knowing only itself
+   void test_remove_byReference()
+   {  // setup
+      Connection a(11), b(26), c(31);
+      Lru l;
+      l.push_back(a);
+      l.push_back(b);
+      l.push_back(c);
+      // exercise
+      l.remove(c);
+      l.remove(a);
+      // verify
+      assertUnit(ids(l) == std::vector<int>({ 26 }));
+      assertUnit(&l.front() == &b && &l.back() == &b);
+   }  // teardown
+
+   // clear leaves every element free to join another list
+   void test_clear_unlinksAll()
+   {  // setup
+      Connection a(11), b(26);
+      Lru l;
+      l.push_back(a);
+      l.push_back(b);
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(!a.lru.is_linked() && !b.lru.is_linked());
+      assertUnit(a.lru.pNext == nullptr);
+   }  // teardown
+
+   /***************************************
+    * HOOKS
+    ***************************************/
+
+   // one object in two lists through two hooks
+   void test_hooks_twoLists()
+   {  // setup
+      Connection a(11), b(26), c(31);
+      Lru lru;
+      Idle idle;
+      lru.push_back(a);
+      lru.push_back(b);
+      lru.push_back(c);
+      // exercise
+      idle.push_back(c);
+      idle.push_back(a);
+      lru.remove(a);
+      // verify
+      assertUnit(ids(lru) == std::vector<int>({ 26, 31 }));
+      assertUnit(ids(idle) == std::vector<int>({ 31, 11 }));
+      assertUnit(!a.lru.is_linked() && a.idle.is_linked());
+   }  // teardown
+
+   // copying an element does not copy its membership
+   void test_hook_copyUnlinked()
+   {  // setup
+      Connection a(11);
+      Lru l;
+      l.push_back(a);
+      // exercise
+      Connection copy(a);
+      // verify
+      assertUnit(copy.id == 11);
+      assertUnit(!copy.lru.is_linked());
+      assertUnit(copy.lru.pNext == nullptr && copy.lru.pPrev == nullptr);
+      assertUnit(l.size() == 1);
+   }  // teardown
+
+   /***************************************
+    * SPLICE
+    ***************************************/
+
+   // move a whole list into the middle of another
+   void test_splice_middle()
+   {  // setup
+      Connection a(11), b(26), c(31), d(49);
+      Lru l;
+      Lru lOther;
+      l.push_back(a);
+      l.push_back(d);
+      lOther.push_back(b);
+      lOther.push_back(c);
+      // exercise
+      l.splice(Lru::iterator_to(d), lOther);
+      // verify
+      assertUnit(lOther.empty());
+      assertUnit(l.size() == 4);
+      assertUnit(ids(l) == std::vector<int>({ 11, 26, 31, 49 }));
+      assertUnit(backwards(l) == std::vector<int>({ 49, 31, 26, 11 }));
+   }  // teardown
+
+   /***************************************
+    * HELPERS
+    ***************************************/
+
+   // an object owned elsewhere that may be in two lists
+   struct Connection
+   {
+      Connection(int id) : id(id) {}
+      int id;
+      custom::list_hook<Connection> lru;
+      custom::list_hook<Connection> idle;
+   };
+   typedef custom::intrusive_list<Connection, &Connection::lru>  Lru;
+   typedef custom::intrusive_list<Connection, &Connection::idle> Idle;
+
+   // the ids front to back
+   template <typename L>
+   std::vector<int> ids(L & l)
+   {
+      std::vector<int> values;
+      for (typename L::iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(it->id);
+      return values;
+   }
+
+   // the ids back to front
+   std::vector<int> backwards(Lru & l)
+   {
+      std::vector<int> values;
+      for (Lru::iterator it = l.rbegin(); it != l.end(); --it)
+         values.push_back(it->id);
+      return values;
+   }
+};
+
+#endif // DEBUG
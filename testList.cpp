@@ -16,6 +16,26 @@
 
 #include "testList.h"       // for the list unit tests
 #include "testSpy.h"        // for the spy unit tests
+#include "testConcurrentList.h" // for the concurrent list unit tests
+#include "testMpscList.h"   // for the mpsc list unit tests
+#include "testParallel.h"   // for the parallel algorithm unit tests
+#include "testRcuList.h"    // for the rcu list unit tests
+#include "testShardedList.h" // for the sharded list unit tests
+#include "testWorkStealing.h" // for the work stealing unit tests
+#include "testBlockingQueue.h" // for the blocking queue unit tests
+#include "testCowList.h" // for the cow list unit tests
+#include "testPersistentList.h" // for the persistent list unit tests
+#include "testIndexedList.h" // for the indexed list unit tests
+#include "testSortedList.h" // for the sorted list unit tests
+#include "testHash.h" // for the hash unit tests
+#include "testLruCache.h" // for the LRU cache unit tests
+#include "testIntrusiveList.h" // for the intrusive list unit tests
+#include "testForwardList.h" // for the forward list unit tests
+#include "testSmallList.h" // for the small list unit tests
+#include "testSoaList.h" // for the struct-of-arrays list unit tests
+#include "testSimd.h" // for the vectorized search unit tests
+#include "testSerialize.h" // for the binary serialization unit tests
+#include "testMappedList.h" // for the memory-mapped list unit tests
 int Spy::counters[] = {};
 
 
@@ -29,6 +49,26 @@ int main()
    // unit tests
    TestSpy().run();
    TestList().run();
+   TestConcurrentList().run();
+   TestMpscList().run();
+   TestParallel().run();
+   TestRcuList().run();
+   TestShardedList().run();
+   TestWorkStealing().run();
+   TestBlockingQueue().run();
+   TestCowList().run();
+   TestPersistentList().run();
+   TestIndexedList().run();
+   TestSortedList().run();
+   TestHash().run();
+   TestLruCache().run();
+   TestIntrusiveList().run();
+   TestForwardList().run();
+   TestSmallList().run();
+   TestSoaList().run();
+   TestSimd().run();
+   TestSerialize().run();
+   TestMappedList().run();
 #endif // DEBUG
    
    return 0;
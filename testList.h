@@ -21,9 +21,29 @@
 #include <memory>
 #include <iostream>
 
+// a record wider than a cache line whose key is all a search compares
+struct WideRecord
+{
+   int key;
+   char payload[200];
+};
+
+// give every WideRecord node a cache line of its own
+namespace custom
+{
+   template <>
+   struct node_layout<WideRecord>
+   {
+      static const size_t alignment = 64;
+   };
+}
+
 class TestList : public UnitTest
 {
 public:
+   // a list that keeps a finger for positional access
+   typedef custom::list<int, std::allocator<int>, true> FingerList;
+
    void run()
    {
       reset();
@@ -75,6 +95,7 @@ public:
       test_iterator_decrementPost_standardMiddle();
       test_iterator_dereference_read();
       test_iterator_dereference_update();
+      test_constIterator_walk();
 
       // Access
       test_front_empty();
@@ -115,6 +136,42 @@ public:
       test_erase_standardMiddle();
       test_erase_standardEnd();
 
+      // Splice
+      test_splice_all();
+      test_splice_single();
+      test_splice_range();
+      test_splice_rangeCounted();
+
+      // Sort
+      test_merge_standard();
+      test_sort_empty();
+      test_sort_standard();
+      test_sort_stable();
+      test_sort_throwKeepsOrder();
+      test_merge_throwKeepsBoth();
+
+      // Position
+      test_at_standard();
+      test_at_outOfRange();
+      test_position_fromFinger();
+      test_insertAt_sequential();
+      test_eraseAt_standardMiddle();
+      test_finger_pushfrontShifts();
+      test_finger_eraseElsewhereDrops();
+      test_finger_swapFollows();
+      test_finger_defaultIsFree();
+
+      // Bulk
+      test_copyTo_standard();
+      test_copyTo_short();
+      test_assignFrom_reusesNodes();
+      test_assignFrom_shrinks();
+
+      // Layout
+      test_node_linksFirst();
+      test_node_defaultAlignment();
+      test_node_cacheLineAlignment();
+
       // Status
       test_size_empty();
       test_size_three();
@@ -2686,6 +2743,539 @@ public:
    }
 
 
+   /***************************************
+    * SPLICE
+    ***************************************/
+
+   // move a whole list onto the end of the standard fixture
+   void test_splice_all()
+   {  // setup
+      //    +----+   +----+
+      //    | 11 | - | 26 |
+      //    +----+   +----+
+      custom::list<Spy> l;
+      setupStandardFixture(l);
+      custom::list<Spy> lSrc;
+      lSrc.pHead = lSrc.pTail = l.pTail;
+      lSrc.numElements = 1;
+      l.pTail = l.pTail->pPrev;
+      l.pTail->pNext = nullptr;
+      lSrc.pHead->pPrev = nullptr;
+      l.numElements = 2;
+      Spy::reset();
+      // exercise
+      l.splice(l.end(), lSrc);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertEmptyFixture(lSrc);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // move the 31 from the back to the front of the same list
+   void test_splice_single()
+   {  // setup
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      custom::list<Spy> l;
+      setupStandardFixture(l);
+      custom::list<Spy>::Node * p31 = l.pTail;
+      Spy::reset();
+      // exercise
+      l.splice(l.begin(), l, custom::list<Spy>::iterator(p31));
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      //    +----+   +----+   +----+
+      //    | 31 | - | 11 | - | 26 |
+      //    +----+   +----+   +----+
+      assertUnit(l.numElements == 3);
+      assertUnit(l.pHead == p31);
+      assertUnit(p31->pPrev == nullptr);
+      if (p31->pNext)
+      {
+         assertUnit(p31->pNext->data == Spy(11));
+         assertUnit(p31->pNext->pPrev == p31);
+      }
+      assertUnit(l.pTail->data == Spy(26));
+      assertUnit(l.pTail->pNext == nullptr);
+      // put it back the way it was
+      l.splice(l.end(), l, l.begin());
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // move [26][31] from one list into another
+   void test_splice_range()
+   {  // setup
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      custom::list<Spy> lSrc;
+      setupStandardFixture(lSrc);
+      custom::list<Spy> lDes;
+      Spy::reset();
+      // exercise
+      lDes.splice(lDes.end(), lSrc, ++lSrc.begin(), lSrc.end());
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      //    +----+
+      //    | 11 |
+      //    +----+
+      assertUnit(lSrc.numElements == 1);
+      assertUnit(lSrc.pHead == lSrc.pTail);
+      if (lSrc.pHead)
+      {
+         assertUnit(lSrc.pHead->data == Spy(11));
+         assertUnit(lSrc.pHead->pNext == nullptr);
+      }
+      //    +----+   +----+
+      //    | 26 | - | 31 |
+      //    +----+   +----+
+      assertUnit(lDes.numElements == 2);
+      if (lDes.pHead && lDes.pTail)
+      {
+         assertUnit(lDes.pHead->data == Spy(26));
+         assertUnit(lDes.pHead->pPrev == nullptr);
+         assertUnit(lDes.pTail->data == Spy(31));
+         assertUnit(lDes.pTail->pPrev == lDes.pHead);
+      }
+      // put it back the way it was
+      lSrc.splice(lSrc.end(), lDes);
+      assertEmptyFixture(lDes);
+      assertStandardFixture(lSrc);
+      // teardown
+      teardownStandardFixture(lSrc);
+   }
+
+   // a range whose size the caller knows is moved without counting it
+   void test_splice_rangeCounted()
+   {  // setup
+      custom::list<int> lSrc{ 11, 26, 31, 49 };
+      custom::list<int> lDes{ 5 };
+      custom::list<int>::iterator last = lSrc.begin();
+      ++last;
+      ++last;
+      // exercise
+      lDes.splice(lDes.end(), lSrc, lSrc.begin(), last, 2);
+      // verify
+      assertUnit(lSrc.size() == 2);
+      assertUnit(lDes.size() == 3);
+      assertUnit(contents(lSrc) == std::vector<int>({ 31, 49 }));
+      assertUnit(contents(lDes) == std::vector<int>({ 5, 11, 26 }));
+      lSrc.splice(lSrc.begin(), lSrc, ++lSrc.begin(), lSrc.end(), 1);
+      assertUnit(lSrc.size() == 2);
+      assertUnit(contents(lSrc) == std::vector<int>({ 49, 31 }));
+   }  // teardown
+
+   /***************************************
+    * SORT
+    ***************************************/
+
+   // merge [26] into [11][31]
+   void test_merge_standard()
+   {  // setup
+      custom::list<Spy> l;
+      setupStandardFixture(l);
+      custom::list<Spy> lSrc;
+      lSrc.splice(lSrc.end(), l, ++l.begin());
+      Spy::reset();
+      // exercise
+      l.merge(lSrc);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertEmptyFixture(lSrc);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // sort an empty list
+   void test_sort_empty()
+   {  // setup
+      custom::list<Spy> l;
+      Spy::reset();
+      // exercise
+      l.sort();
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // sort [31][11][26] into the standard fixture by relinking
+   void test_sort_standard()
+   {  // setup
+      custom::list<Spy> l;
+      setupStandardFixture(l);
+      l.splice(l.begin(), l, custom::list<Spy>::iterator(l.pTail));
+      l.splice(l.end(), l, ++l.begin());
+      Spy::reset();
+      // exercise
+      l.sort();
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numSwap() == 0);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // equal elements keep their order
+   void test_sort_stable()
+   {  // setup
+      custom::list<std::pair<int, int>> l;
+      for (int i = 0; i < 100; i++)
+         l.push_back(std::make_pair((i * 7) % 10, i));
+      // exercise
+      l.sort([](const std::pair<int, int> & lhs, const std::pair<int, int> & rhs)
+      {
+         return lhs.first < rhs.first;
+      });
+      // verify
+      bool ordered = true;
+      custom::list<std::pair<int, int>>::iterator it = l.begin();
+      std::pair<int, int> previous = *it;
+      for (++it; it != l.end(); ++it)
+      {
+         if ((*it).first < previous.first ||
+             ((*it).first == previous.first && (*it).second < previous.second))
+            ordered = false;
+         previous = *it;
+      }
+      assertUnit(ordered);
+      assertUnit(l.size() == 100);
+      assertUnit(l.pTail->pNext == nullptr);
+      assertUnit(l.pHead->pPrev == nullptr);
+   }  // teardown
+
+   // a cmp that throws part way leaves the old order, both ways
+   void test_sort_throwKeepsOrder()
+   {  // setup
+      custom::list<int> l{ 31, 11, 99, 26, 57, 5, 49 };
+      int numCalls = 0;
+      bool thrown = false;
+      // exercise
+      try
+      {
+         l.sort([&numCalls](int lhs, int rhs)
+         {
+            if (++numCalls == 6)
+               throw std::runtime_error("cmp");
+            return lhs < rhs;
+         });
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(l.size() == 7);
+      std::vector<int> forward;
+      for (custom::list<int>::iterator it = l.begin(); it != l.end(); ++it)
+         forward.push_back(*it);
+      std::vector<int> backward;
+      for (custom::list<int>::iterator it = l.rbegin(); it != l.end(); --it)
+         backward.push_back(*it);
+      assertUnit(forward == std::vector<int>({ 31, 11, 99, 26, 57, 5, 49 }));
+      assertUnit(backward == std::vector<int>({ 49, 5, 57, 26, 99, 11, 31 }));
+   }  // teardown
+
+   // a merge that throws gives every node back to its own list
+   void test_merge_throwKeepsBoth()
+   {  // setup
+      custom::list<int> l1{ 11, 31, 57 };
+      custom::list<int> l2{ 5, 26, 49 };
+      int numCalls = 0;
+      bool thrown = false;
+      // exercise
+      try
+      {
+         l1.merge(l2, [&numCalls](int lhs, int rhs)
+         {
+            if (++numCalls == 3)
+               throw std::runtime_error("cmp");
+            return lhs < rhs;
+         });
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(l1.size() == 3);
+      assertUnit(l2.size() == 3);
+      assertUnit(l1.pHead->data == 11 && l1.pHead->pNext->data == 31);
+      assertUnit(l1.pTail->data == 57 && l1.pTail->pNext == nullptr);
+      assertUnit(l2.pHead->data == 5 && l2.pHead->pNext->data == 26);
+      assertUnit(l2.pTail->data == 49 && l2.pTail->pNext == nullptr);
+   }  // teardown
+
+   /***************************************
+    * POSITION
+    ***************************************/
+
+   // read each of the standard fixture by index
+   void test_at_standard()
+   {  // setup
+      custom::list<Spy> l;
+      setupStandardFixture(l);
+      Spy::reset();
+      // exercise
+      int value = l.at(2).get();
+      // verify
+      assertUnit(value == 31);
+      assertUnit(l.at(0).get() == 11);
+      assertUnit(l.at(1).get() == 26);
+      assertUnit(Spy::numCopy() == 0);
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // past the end throws
+   void test_at_outOfRange()
+   {  // setup
+      custom::list<Spy> l;
+      setupStandardFixture(l);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         l.at(3);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // the walk starts from the finger when it is closest
+   void test_position_fromFinger()
+   {  // setup
+      FingerList l;
+      for (int i = 0; i < 1000; i++)
+         l.push_back(i);
+      l.at(500);
+      FingerList::Node * p500 = l.finger();
+      // exercise
+      FingerList::iterator it = l.position(503);
+      // verify
+      assertUnit(*it == 503);
+      assertUnit(l.pFinger == p500->pNext->pNext->pNext);
+      assertUnit(l.iFinger == 503);
+      assertUnit(l.position(1000) == l.end());
+      assertUnit(*l.position(0) == 0);
+      assertUnit(*l.position(999) == 999);
+   }  // teardown
+
+   // insert at consecutive positions, as an editor would
+   void test_insertAt_sequential()
+   {  // setup
+      FingerList l{ 11, 31 };
+      // exercise
+      l.insert_at(1, 26);
+      l.insert_at(2, 27);
+      l.insert_at(3, 28);
+      l.insert_at(5, 99);
+      // verify
+      std::vector<int> values = contents(l);
+      assertUnit(values == std::vector<int>({ 11, 26, 27, 28, 31, 99 }));
+      assertUnit(l.pFinger == l.pTail);
+      assertUnit(l.iFinger == 5);
+      assertUnit(l.at(3) == 28);
+   }  // teardown
+
+   // erase by index, the finger lands on the next element
+   void test_eraseAt_standardMiddle()
+   {  // setup
+      FingerList l{ 11, 99, 26, 31 };
+      // exercise
+      FingerList::iterator it = l.erase_at(1);
+      // verify
+      assertUnit(*it == 26);
+      assertUnit(l.pFinger == it.p);
+      assertUnit(l.iFinger == 1);
+      std::vector<int> values = contents(l);
+      assertUnit(values == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   // pushing on the front moves the finger's index, not its node
+   void test_finger_pushfrontShifts()
+   {  // setup
+      FingerList l{ 11, 26, 31 };
+      l.at(1);
+      FingerList::Node * p26 = l.finger();
+      // exercise
+      l.push_front(5);
+      l.pop_back();
+      // verify
+      assertUnit(l.pFinger == p26);
+      assertUnit(l.iFinger == 2);
+      assertUnit(l.at(2) == 26);
+      l.pop_front();
+      assertUnit(l.iFinger == 1);
+      assertUnit(l.at(1) == 26);
+   }  // teardown
+
+   // erasing somewhere we cannot place relative to the finger drops it
+   void test_finger_eraseElsewhereDrops()
+   {  // setup
+      FingerList l{ 11, 26, 31, 42, 57 };
+      l.at(1);
+      // exercise
+      l.erase(l.position(3));
+      // verify
+      assertUnit(l.pFinger != nullptr);
+      assertUnit(l.iFinger == 3);
+      l.at(1);
+      FingerList::iterator it = l.begin();
+      ++it;
+      ++it;
+      l.erase(it);
+      assertUnit(l.pFinger == nullptr);
+      assertUnit(l.at(2) == 57);
+   }  // teardown
+
+   // swap takes the finger along with the nodes
+   void test_finger_swapFollows()
+   {  // setup
+      FingerList l1{ 11, 26, 31 };
+      FingerList l2;
+      l1.at(2);
+      FingerList::Node * p31 = l1.finger();
+      // exercise
+      l1.swap(l2);
+      // verify
+      assertUnit(l1.pFinger == nullptr);
+      assertUnit(l2.pFinger == p31);
+      assertUnit(l2.iFinger == 2);
+      FingerList l3(std::move(l2));
+      assertUnit(l2.pFinger == nullptr);
+      assertUnit(l3.pFinger == p31);
+   }  // teardown
+
+   // a list without a finger is no bigger for it, and still finds by index
+   void test_finger_defaultIsFree()
+   {  // setup
+      custom::list<int> l{ 11, 26, 31 };
+      // exercise
+      int value = l.at(1);
+      // verify
+      assertUnit(value == 26);
+      assertUnit(l.finger() == nullptr);
+      assertUnit(sizeof(FingerList) == sizeof(custom::list<int>) + sizeof(void *) + sizeof(size_t));
+      l.insert_at(1, 99);
+      l.erase_at(2);
+      assertUnit(contents(l) == std::vector<int>({ 11, 99, 31 }));
+   }  // teardown
+
+   /***************************************
+    * BULK
+    ***************************************/
+
+   // the whole list lands in the array, in order
+   void test_copyTo_standard()
+   {  // setup
+      custom::list<int> l{ 11, 26, 31 };
+      int values[4] = { 0, 0, 0, 99 };
+      // exercise
+      size_t numCopied = l.copy_to(values, 4);
+      // verify
+      assertUnit(numCopied == 3);
+      assertUnit(values[0] == 11);
+      assertUnit(values[1] == 26);
+      assertUnit(values[2] == 31);
+      assertUnit(values[3] == 99);
+   }  // teardown
+
+   // a small array takes only the front, by assignment
+   void test_copyTo_short()
+   {  // setup
+      custom::list<Spy> l;
+      setupStandardFixture(l);
+      Spy values[2];
+      Spy::reset();
+      // exercise
+      size_t numCopied = l.copy_to(values, 2);
+      // verify
+      assertUnit(numCopied == 2);
+      assertUnit(Spy::numAssign() == 2);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(values[0] == Spy(11));
+      assertUnit(values[1] == Spy(26));
+      assertStandardFixture(l);
+   }  // teardown
+
+   // existing nodes are overwritten, only the extra value allocates
+   void test_assignFrom_reusesNodes()
+   {  // setup
+      custom::list<Spy> l;
+      l.push_back(Spy(85));
+      l.push_back(Spy(99));
+      custom::list<Spy>::Node * pFirst = l.pHead;
+      Spy values[3] = { Spy(11), Spy(26), Spy(31) };
+      Spy::reset();
+      // exercise
+      l.assign_from(values, 3);
+      // verify
+      assertUnit(Spy::numAssign() == 2);       // assign [11][26]
+      assertUnit(Spy::numCopy() == 1);         // copy construct [31]
+      assertUnit(Spy::numAlloc() == 1);        // allocate [31]
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(l.pHead == pFirst);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // a shorter array frees the leftover tail, an empty one everything
+   void test_assignFrom_shrinks()
+   {  // setup
+      FingerList l{ 11, 26, 31, 49 };
+      int values[2] = { 5, 6 };
+      l.at(3);
+      // exercise
+      l.assign_from(values, 2);
+      // verify
+      assertUnit(l.size() == 2);
+      assertUnit(l.pFinger == nullptr);
+      assertUnit(l.pHead->data == 5);
+      assertUnit(l.pTail->data == 6);
+      assertUnit(l.pTail->pNext == nullptr);
+      assertUnit(l.pTail->pPrev == l.pHead);
+      l.assign_from(values, 0);
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
    /***************************************
     * ITERATOR
     ***************************************/
@@ -3119,6 +3709,96 @@ public:
       teardownStandardFixture(l);
    }
 
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // the links sit at the front of every node, ahead of the data
+   void test_node_linksFirst()
+   {  // setup
+      //        pHead             pTail
+      //       +----+   +----+   +----+
+      //       | 11 | - | 26 | - | 31 |
+      //       +----+   +----+   +----+
+      custom::list<Spy> l;
+      setupStandardFixture(l);
+      custom::list<Spy>::Node * p = l.pHead->pNext;
+      // exercise
+      const char * pNode = reinterpret_cast<const char *>(p);
+      const char * pNext = reinterpret_cast<const char *>(&p->pNext);
+      const char * pPrev = reinterpret_cast<const char *>(&p->pPrev);
+      const char * pData = reinterpret_cast<const char *>(&p->data);
+      // verify
+      assertUnit(pNext == pNode);
+      assertUnit(pPrev == pNode + sizeof(p));
+      assertUnit(pData >= pPrev + sizeof(p));
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // without a node_layout a node is aligned only as its members need
+   void test_node_defaultAlignment()
+   {  // verify
+      assertUnit(alignof(custom::list<char>::Node) == alignof(void *));
+      assertUnit(sizeof(custom::list<void *>::Node) == 3 * sizeof(void *));
+   }
+
+   // node_layout<WideRecord> puts each node on a cache line boundary
+   void test_node_cacheLineAlignment()
+   {  // setup
+      custom::list<WideRecord> l;
+      WideRecord record = {};
+      // exercise
+      for (int i = 0; i < 3; i++)
+      {
+         record.key = i;
+         l.push_back(record);
+      }
+      // verify
+      assertUnit(alignof(custom::list<WideRecord>::Node) == 64);
+      for (custom::list<WideRecord>::Node * p = l.pHead; p; p = p->pNext)
+      {
+         assertUnit(reinterpret_cast<size_t>(p) % 64 == 0);
+         assertUnit(reinterpret_cast<const char *>(&p->data.key) -
+                    reinterpret_cast<const char *>(p) < 64);
+      }
+      assertUnit(l.back().key == 2);
+   }  // teardown
+
+   // a const list reads both ways without copying an element
+   void test_constIterator_walk()
+   {  // setup
+      custom::list<Spy> l;
+      setupStandardFixture(l);
+      const custom::list<Spy> & lConst = l;
+      std::vector<int> forward;
+      std::vector<int> backward;
+      Spy::reset();
+      // exercise
+      custom::list<Spy>::const_iterator it = lConst.cbegin();
+      for (; it != lConst.cend(); ++it)
+         forward.push_back((*it).get());
+      for (it = l.pTail; it != lConst.cend(); it--)
+         backward.push_back((*it).get());
+      // verify
+      assertUnit(forward == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(backward == std::vector<int>({ 31, 26, 11 }));
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // read a list of int out with the iterator
+   template <typename L>
+   std::vector<int> contents(L & l)
+   {
+      std::vector<int> values;
+      for (typename L::iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+
    /****************************************************************
     * Setup Standard Fixture
     *        pHead             pTail
@@ -0,0 +1,277 @@
+/***********************************************************************
+ * Header:
+ *    TEST LRU CACHE
+ * Summary:
+ *    Unit tests for lru_cache
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "lruCache.h"     // class under test
+#include "spy.h"          // for the Spy class
+#include "unitTest.h"     // unit test baseclass
+
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST LRU CACHE
+ * Unit tests for the lru_cache class
+ ***********************************************/
+class TestLruCache : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_empty();
+
+      // Access
+      test_get_miss();
+      test_get_touchesNoCopy();
+      test_peek_keepsOrder();
+
+      // Insert
+      test_put_overwrite();
+      test_put_evictsByCount();
+      test_put_evictsByBytes();
+      test_put_tooHeavy();
+
+      // Remove
+      test_evict_batched();
+      test_erase_silent();
+      test_resize_shrinks();
+
+      report("LruCache");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a new cache holds nothing
+   void test_construct_empty()
+   {  // exercise
+      custom::lru_cache<int, int> c(3);
+      // verify
+      assertUnit(c.empty());
+      assertUnit(c.size() == 0);
+      assertUnit(c.bytes() == 0);
+      assertUnit(c.max_count() == 3);
+      assertUnit(c.get(11) == nullptr);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // a miss changes nothing
+   void test_get_miss()
+   {  // setup
+      custom::lru_cache<int, int> c(3);
+      c.put(11, 1);
+      c.put(26, 2);
+      // exercise
+      int * p = c.get(31);
+      // verify
+      assertUnit(p == nullptr);
+      assertUnit(keys(c) == std::vector<int>({ 26, 11 }));
+   }  // teardown
+
+   // a hit moves the node to the front without copying or freeing
+   void test_get_touchesNoCopy()
+   {  // setup
+      custom::lru_cache<int, Spy> c(3);
+      c.put(11, Spy(1));
+      c.put(26, Spy(2));
+      c.put(31, Spy(3));
+      Spy * pOld = c.peek(11);
+      Spy::reset();
+      // exercise
+      Spy * pHit = c.get(11);
+      // verify
+      assertUnit(pHit == pOld);
+      assertUnit(pHit->get() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit((*c.entries.begin()).key == 11);
+      assertUnit((*c.entries.rbegin()).key == 26);
+      assertUnit(c.size() == 3);
+   }  // teardown
+
+   // peek finds the value but leaves it where it was
+   void test_peek_keepsOrder()
+   {  // setup
+      custom::lru_cache<int, int> c(3);
+      c.put(11, 1);
+      c.put(26, 2);
+      // exercise
+      int * p = c.peek(11);
+      // verify
+      assertUnit(p != nullptr && *p == 1);
+      assertUnit(keys(c) == std::vector<int>({ 26, 11 }));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // put on a cached key replaces the value and touches it
+   void test_put_overwrite()
+   {  // setup
+      custom::lru_cache<int, int> c(3);
+      c.put(11, 1);
+      c.put(26, 2);
+      // exercise
+      c.put(11, 99);
+      // verify
+      assertUnit(c.size() == 2);
+      assertUnit(*c.peek(11) == 99);
+      assertUnit(keys(c) == std::vector<int>({ 11, 26 }));
+   }  // teardown
+
+   // the least recently used entry goes first
+   void test_put_evictsByCount()
+   {  // setup
+      custom::lru_cache<int, int> c(3);
+      c.put(11, 1);
+      c.put(26, 2);
+      c.put(31, 3);
+      c.get(11);
+      // exercise
+      c.put(49, 4);
+      // verify
+      assertUnit(c.size() == 3);
+      assertUnit(!c.contains(26));
+      assertUnit(keys(c) == std::vector<int>({ 49, 11, 31 }));
+   }  // teardown
+
+   // the byte bound counts what the sizer reports
+   void test_put_evictsByBytes()
+   {  // setup
+      custom::lru_cache<int, std::string, LengthSizer> c(100, 9);
+      c.put(1, "abcd");
+      c.put(2, "efg");
+      c.put(3, "hi");
+      // exercise
+      c.put(4, "jklmn");
+      // verify
+      assertUnit(c.bytes() == 7);
+      assertUnit(c.size() == 2);
+      assertUnit(!c.contains(1));
+      assertUnit(!c.contains(2));
+      assertUnit(keys(c) == std::vector<int>({ 4, 3 }));
+   }  // teardown
+
+   // an entry that can never fit is evicted at once
+   void test_put_tooHeavy()
+   {  // setup
+      custom::lru_cache<int, std::string, LengthSizer> c(100, 4);
+      c.put(1, "ab");
+      std::vector<int> evicted;
+      c.on_evict([&evicted](custom::list<custom::lru_cache<int, std::string, LengthSizer>::entry> & victims)
+      {
+         for (auto it = victims.begin(); it != victims.end(); ++it)
+            evicted.push_back((*it).key);
+      });
+      // exercise
+      c.put(2, "cdefgh");
+      // verify
+      assertUnit(c.empty());
+      assertUnit(c.bytes() == 0);
+      assertUnit(evicted == std::vector<int>({ 2, 1 }));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // one callback for every victim of one put, least recent last
+   void test_evict_batched()
+   {  // setup
+      custom::lru_cache<int, std::string, LengthSizer> c(100, 6);
+      c.put(1, "a");
+      c.put(2, "b");
+      c.put(3, "c");
+      c.put(4, "d");
+      int numCalls = 0;
+      std::vector<int> evicted;
+      c.on_evict([&](custom::list<custom::lru_cache<int, std::string, LengthSizer>::entry> & victims)
+      {
+         numCalls++;
+         for (auto it = victims.begin(); it != victims.end(); ++it)
+            evicted.push_back((*it).key);
+      });
+      // exercise
+      c.put(5, "efghi");
+      // verify
+      assertUnit(numCalls == 1);
+      assertUnit(evicted == std::vector<int>({ 3, 2, 1 }));
+      assertUnit(keys(c) == std::vector<int>({ 5, 4 }));
+      assertUnit(c.bytes() == 6);
+      assertUnit(c.index.size() == 2);
+   }  // teardown
+
+   // erase drops the entry without calling back
+   void test_erase_silent()
+   {  // setup
+      custom::lru_cache<int, int> c(3);
+      c.put(11, 1);
+      c.put(26, 2);
+      int numCalls = 0;
+      c.on_evict([&numCalls](custom::list<custom::lru_cache<int, int>::entry> &) { numCalls++; });
+      // exercise
+      bool erased = c.erase(11);
+      bool missing = c.erase(11);
+      // verify
+      assertUnit(erased);
+      assertUnit(!missing);
+      assertUnit(numCalls == 0);
+      assertUnit(keys(c) == std::vector<int>({ 26 }));
+      assertUnit(c.bytes() == sizeof(int) * 2);
+   }  // teardown
+
+   // shrinking the bounds evicts down to them
+   void test_resize_shrinks()
+   {  // setup
+      custom::lru_cache<int, int> c(5);
+      for (int i = 0; i < 5; i++)
+         c.put(i, i);
+      // exercise
+      c.resize(2);
+      // verify
+      assertUnit(c.max_count() == 2);
+      assertUnit(keys(c) == std::vector<int>({ 4, 3 }));
+      assertUnit(c.index.size() == 2);
+   }  // teardown
+
+   /***************************************
+    * HELPERS
+    ***************************************/
+
+   // a string weighs its length
+   struct LengthSizer
+   {
+      size_t operator () (int, const std::string & s) const { return s.size(); }
+   };
+
+   // the keys from most to least recently used
+   template <typename V, typename S>
+   std::vector<int> keys(custom::lru_cache<int, V, S> & c)
+   {
+      std::vector<int> values;
+      for (auto it = c.entries.begin(); it != c.entries.end(); ++it)
+         values.push_back((*it).key);
+      return values;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,359 @@
+/***********************************************************************
+ * Header:
+ *    TEST MAPPED LIST
+ * Summary:
+ *    Unit tests for offset_ptr and mapped_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "mappedList.h"   // class under test
+#include "unitTest.h"     // unit test baseclass
+
+#ifdef CUSTOM_MAPPED_LIST
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+/***********************************************
+ * TEST MAPPED LIST
+ * Unit tests for the mapped_list class. Each
+ * test works in its own temporary file.
+ ***********************************************/
+class TestMappedList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Offset Pointer
+      test_offsetPtr_survivesMove();
+
+      // Construct
+      test_construct_newFile();
+      test_construct_reopen();
+      test_construct_wrongType();
+      test_construct_notAList();
+
+      // Insert
+      test_push_bothEnds();
+      test_push_growsFile();
+      test_push_aliasAcrossGrowth();
+
+      // Remove
+      test_erase_reusesNode();
+      test_clear_keepsFile();
+
+      report("MappedList");
+   }
+
+   /***************************************
+    * OFFSET POINTER
+    ***************************************/
+
+   // links copied byte for byte to another address still meet
+   void test_offsetPtr_survivesMove()
+   {  // setup
+      struct Pair
+      {
+         custom::offset_ptr<int> p;
+         int value;
+      };
+      Pair first;
+      first.value = 26;
+      first.p = &first.value;
+      Pair moved;
+      // exercise
+      std::memcpy(static_cast <void *> (&moved), &first, sizeof(Pair));
+      first.value = 0;
+      // verify
+      assertUnit(moved.p.get() == &moved.value);
+      assertUnit(*moved.p == 26);
+      assertUnit(moved.p.offset == first.p.offset);
+      custom::offset_ptr<int> copy(moved.p);
+      assertUnit(copy.get() == &moved.value);
+      assertUnit(!custom::offset_ptr<int>());
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a new file is sized for the nodes asked for and holds no elements
+   void test_construct_newFile()
+   {  // setup
+      std::string path = tempFile();
+      {
+         // exercise
+         custom::mapped_list<int> l(path, 16);
+         // verify
+         assertUnit(l.empty());
+         assertUnit(l.size() == 0);
+         assertUnit(l.begin() == l.end());
+         assertUnit(l.capacity() == 16);
+         assertUnit(fileSize(path) == l.numBytes);
+      }
+      // teardown
+      unlink(path.c_str());
+   }
+
+   // everything written is there, in order, after a reopen
+   void test_construct_reopen()
+   {  // setup
+      std::string path = tempFile();
+      {
+         custom::mapped_list<long> l(path);
+         for (long i = 0; i < 5000; i++)
+            l.push_back(i * 3);
+         l.pop_front();
+         l.sync();
+      }
+      // exercise
+      custom::mapped_list<long> l(path);
+      // verify
+      assertUnit(l.size() == 4999);
+      assertUnit(l.front() == 3);
+      assertUnit(l.back() == 4999 * 3);
+      std::vector<long> expected;
+      for (long i = 1; i < 5000; i++)
+         expected.push_back(i * 3);
+      assertUnit(forward(l) == expected);
+      assertUnit(backward(l) == std::vector<long>(expected.rbegin(), expected.rend()));
+      // teardown
+      unlink(path.c_str());
+   }
+
+   // a file of ints is not a list of doubles
+   void test_construct_wrongType()
+   {  // setup
+      std::string path = tempFile();
+      {
+         custom::mapped_list<int> l(path);
+         l.push_back(11);
+      }
+      // exercise
+      std::string message = errorOf<double>(path);
+      // verify
+      assertUnit(message == "mapped_list: element size does not match");
+      // teardown
+      unlink(path.c_str());
+   }
+
+   // any other file is refused, and left alone
+   void test_construct_notAList()
+   {  // setup
+      std::string path = tempFile();
+      std::string text(200, 't');
+      FILE * file = fopen(path.c_str(), "w");
+      fwrite(text.data(), 1, text.size(), file);
+      fclose(file);
+      // exercise
+      std::string message = errorOf<int>(path);
+      // verify
+      assertUnit(message == "mapped_list: not a mapped list file");
+      assertUnit(fileSize(path) == 200);
+      // teardown
+      unlink(path.c_str());
+   }
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // both ends and the middle link up both ways
+   void test_push_bothEnds()
+   {  // setup
+      std::string path = tempFile();
+      {
+         custom::mapped_list<int> l(path);
+         // exercise
+         l.push_back(26);
+         l.push_front(11);
+         l.push_back(49);
+         custom::mapped_list<int>::iterator it = l.insert(l.rbegin(), 31);
+         // verify
+         assertUnit(*it == 31);
+         assertUnit(l.size() == 4);
+         assertUnit(forward(l) == std::vector<int>({ 11, 26, 31, 49 }));
+         assertUnit(backward(l) == std::vector<int>({ 49, 31, 26, 11 }));
+      }
+      // teardown
+      unlink(path.c_str());
+   }
+
+   // a full file doubles and the list carries on
+   void test_push_growsFile()
+   {  // setup
+      std::string path = tempFile();
+      {
+         custom::mapped_list<int> l(path, 4);
+         // exercise
+         for (int i = 0; i < 100; i++)
+            l.insert(l.begin(), i);
+         // verify
+         assertUnit(l.capacity() == 128);
+         assertUnit(fileSize(path) == l.numBytes);
+         assertUnit(l.size() == 100);
+         assertUnit(l.front() == 99);
+         assertUnit(l.back() == 0);
+         assertUnit(backward(l).size() == 100);
+      }
+      // teardown
+      unlink(path.c_str());
+   }
+
+   // pushing an element of the list itself, just as the file moves
+   void test_push_aliasAcrossGrowth()
+   {  // setup
+      std::string path = tempFile();
+      {
+         custom::mapped_list<int> l(path, 2);
+         l.push_back(11);
+         l.push_back(26);
+         // exercise
+         l.push_back(l.front());
+         l.insert(l.rbegin(), l.back());
+         // verify
+         assertUnit(l.capacity() == 4);
+         assertUnit(forward(l) == std::vector<int>({ 11, 26, 11, 11 }));
+      }
+      // teardown
+      unlink(path.c_str());
+   }
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // an erased node is the next one handed out
+   void test_erase_reusesNode()
+   {  // setup
+      std::string path = tempFile();
+      {
+         custom::mapped_list<int> l(path);
+         l.push_back(11);
+         l.push_back(26);
+         l.push_back(31);
+         custom::mapped_list<int>::iterator it = l.begin();
+         ++it;
+         custom::mapped_list<int>::Node * pErased = it.p;
+         uint64_t used = l.header()->used;
+         // exercise
+         it = l.erase(it);
+         l.push_front(5);
+         // verify
+         assertUnit(*it == 31);
+         assertUnit(l.begin().p == pErased);
+         assertUnit(l.header()->used == used);
+         assertUnit(forward(l) == std::vector<int>({ 5, 11, 31 }));
+         assertUnit(backward(l) == std::vector<int>({ 31, 11, 5 }));
+      }
+      // teardown
+      unlink(path.c_str());
+   }
+
+   // clear forgets the nodes but keeps the room for them
+   void test_clear_keepsFile()
+   {  // setup
+      std::string path = tempFile();
+      {
+         custom::mapped_list<int> l(path, 8);
+         for (int i = 0; i < 20; i++)
+            l.push_back(i);
+         size_t numBytes = fileSize(path);
+         // exercise
+         l.clear();
+         // verify
+         assertUnit(l.empty());
+         assertUnit(l.begin() == l.end());
+         assertUnit(fileSize(path) == numBytes);
+         l.push_back(99);
+         assertUnit(forward(l) == std::vector<int>({ 99 }));
+      }
+      // teardown
+      unlink(path.c_str());
+   }
+
+   /***************************************
+    * HELPERS
+    ***************************************/
+
+   // an empty file no other test is using
+   std::string tempFile()
+   {
+      char path[] = "/tmp/testMappedList-XXXXXX";
+      int fd = mkstemp(path);
+      if (fd >= 0)
+         close(fd);
+      return path;
+   }
+
+   // how many bytes the file holds
+   size_t fileSize(const std::string & path)
+   {
+      struct stat status;
+      return stat(path.c_str(), &status) == 0 ? (size_t)status.st_size : 0;
+   }
+
+   // the values from head to tail
+   template <typename T>
+   std::vector<T> forward(custom::mapped_list<T> & l)
+   {
+      std::vector<T> values;
+      for (typename custom::mapped_list<T>::iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+
+   // the values from tail to head
+   template <typename T>
+   std::vector<T> backward(custom::mapped_list<T> & l)
+   {
+      std::vector<T> values;
+      for (typename custom::mapped_list<T>::iterator it = l.rbegin(); it != l.end(); --it)
+         values.push_back(*it);
+      return values;
+   }
+
+   // what opening path as a list of T complained about, or "" if it did not
+   template <typename T>
+   std::string errorOf(const std::string & path)
+   {
+      try
+      {
+         custom::mapped_list<T> l(path);
+      }
+      catch (const std::runtime_error & e)
+      {
+         return e.what();
+      }
+      return "";
+   }
+};
+
+#else // CUSTOM_MAPPED_LIST
+
+/***********************************************
+ * TEST MAPPED LIST
+ * Nothing to test where there is no mmap
+ ***********************************************/
+class TestMappedList : public UnitTest
+{
+public:
+   void run() {}
+};
+
+#endif // CUSTOM_MAPPED_LIST
+
+#endif // DEBUG
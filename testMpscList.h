@@ -0,0 +1,221 @@
+/***********************************************************************
+ * Header:
+ *    TEST MPSC LIST
+ * Summary:
+ *    Unit tests for mpsc_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "mpscList.h"     // class under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <thread>
+#include <vector>
+
+/***********************************************
+ * TEST MPSC LIST
+ * Unit tests for the mpsc_list class
+ ***********************************************/
+class TestMpscList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Insert
+      test_pushback_standard();
+
+      // Remove
+      test_popfront_empty();
+      test_popfront_standard();
+      test_popBatch_all();
+      test_drain_max();
+
+      // Concurrent
+      test_pushback_concurrent();
+
+      report("MpscList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, the stub is both head and tail
+   void test_construct_default()
+   {  // exercise
+      custom::mpsc_list<int> l;
+      // verify
+      assertUnit(l.pHead == &l.stub);
+      assertUnit(l.pTail.load() == &l.stub);
+      assertUnit(l.stub.pNext.load() == nullptr);
+      assertUnit(l.empty());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push three items onto the back
+   void test_pushback_standard()
+   {  // setup
+      custom::mpsc_list<int> l;
+      // exercise
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // verify
+      assertUnit(!l.empty());
+      assertUnit(l.pHead == &l.stub);
+      custom::mpsc_list<int>::Link * p = l.stub.pNext.load();
+      assertUnit(p != nullptr);
+      if (p)
+      {
+         assertUnit(data(p) == 11);
+         p = p->pNext.load();
+         assertUnit(p != nullptr);
+         if (p)
+         {
+            assertUnit(data(p) == 26);
+            p = p->pNext.load();
+            assertUnit(p != nullptr);
+            if (p)
+            {
+               assertUnit(data(p) == 31);
+               assertUnit(p == l.pTail.load());
+               assertUnit(p->pNext.load() == nullptr);
+            }
+         }
+      }
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // pop from an empty queue
+   void test_popfront_empty()
+   {  // setup
+      custom::mpsc_list<int> l;
+      int value = 99;
+      // exercise
+      bool popped = l.pop_front(value);
+      // verify
+      assertUnit(popped == false);
+      assertUnit(value == 99);
+      assertUnit(l.pHead == &l.stub);
+   }  // teardown
+
+   // pop 11 from [11][26][31], leaving the 11 node as the dummy
+   void test_popfront_standard()
+   {  // setup
+      custom::mpsc_list<int> l;
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      custom::mpsc_list<int>::Link * pFirst = l.stub.pNext.load();
+      int value = 0;
+      // exercise
+      bool popped = l.pop_front(value);
+      // verify
+      assertUnit(popped == true);
+      assertUnit(value == 11);
+      assertUnit(l.pHead == pFirst);
+      assertUnit(l.pop_front(value) && value == 26);
+      assertUnit(l.pop_front(value) && value == 31);
+      assertUnit(!l.pop_front(value));
+      assertUnit(l.empty());
+   }  // teardown
+
+   // take everything into a custom::list
+   void test_popBatch_all()
+   {  // setup
+      custom::mpsc_list<int> l;
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      custom::list<int> out;
+      out.push_back(5);
+      // exercise
+      size_t count = l.pop_batch(out);
+      // verify
+      assertUnit(count == 3);
+      assertUnit(l.empty());
+      assertUnit(out.size() == 4);
+      custom::list<int>::iterator it = out.begin();
+      assertUnit(*it == 5);
+      assertUnit(*++it == 11);
+      assertUnit(*++it == 26);
+      assertUnit(*++it == 31);
+   }  // teardown
+
+   // drain stops once it reaches max
+   void test_drain_max()
+   {  // setup
+      custom::mpsc_list<int> l;
+      for (int i = 0; i < 10; i++)
+         l.push_back(i);
+      int sum = 0;
+      // exercise
+      size_t count = l.drain([&sum](int && value) { sum += value; }, 4);
+      // verify
+      assertUnit(count == 4);
+      assertUnit(sum == 0 + 1 + 2 + 3);
+      int value = 0;
+      assertUnit(l.pop_front(value) && value == 4);
+   }  // teardown
+
+   /***************************************
+    * CONCURRENT
+    ***************************************/
+
+   // many producers, one consumer: nothing lost and each producer in order
+   void test_pushback_concurrent()
+   {  // setup
+      custom::mpsc_list<int> l;
+      const int numThreads = 4;
+      const int numEach = 10000;
+      std::vector<std::thread> threads;
+      std::vector<int> last(numThreads, -1);
+      bool inOrder = true;
+      int numPopped = 0;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.emplace_back([&l, t]()
+         {
+            for (int i = 0; i < numEach; i++)
+               l.push_back(t * numEach + i);
+         });
+      while (numPopped < numThreads * numEach)
+         numPopped += (int)l.drain([&](int && value)
+         {
+            int t = value / numEach;
+            if (value % numEach != last[t] + 1)
+               inOrder = false;
+            last[t] = value % numEach;
+         });
+      for (std::thread & thread : threads)
+         thread.join();
+      // verify
+      assertUnit(numPopped == numThreads * numEach);
+      assertUnit(inOrder);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // fetch the data out of a link
+   int data(custom::mpsc_list<int>::Link * p)
+   {
+      return static_cast <custom::mpsc_list<int>::Node *> (p)->data;
+   }
+};
+
+#endif // DEBUG
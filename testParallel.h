@@ -0,0 +1,336 @@
+/***********************************************************************
+ * Header:
+ *    TEST PARALLEL
+ * Summary:
+ *    Unit tests for the parallel list algorithms
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "parallel.h"     // functions under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+
+/***********************************************
+ * TEST PARALLEL
+ * Unit tests for parallel_for_each and friends
+ ***********************************************/
+class TestParallel : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Partition
+      test_partition_empty();
+      test_partition_uneven();
+      test_partition_moreSegmentsThanElements();
+
+      // For Each
+      test_forEach_empty();
+      test_forEach_standard();
+      test_forEach_exception();
+
+      // Transform
+      test_transform_standard();
+      test_transform_fingerList();
+
+      // Sort
+      test_sort_small();
+      test_sort_large();
+      test_sort_fingerList();
+      test_sort_exceptionInChunk();
+      test_sort_exceptionInMerge();
+
+      report("Parallel");
+   }
+
+   /***************************************
+    * PARTITION
+    ***************************************/
+
+   // nothing to cut
+   void test_partition_empty()
+   {  // setup
+      custom::list<int> l;
+      // exercise
+      auto segments = custom::partition_segments(l, 4);
+      // verify
+      assertUnit(segments.empty());
+   }  // teardown
+
+   // 10 elements into 4 segments is 3, 3, 2, 2
+   void test_partition_uneven()
+   {  // setup
+      custom::list<int> l{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+      // exercise
+      auto segments = custom::partition_segments(l, 4);
+      // verify
+      assertUnit(segments.size() == 4);
+      if (segments.size() == 4)
+      {
+         assertUnit(segments[0].count == 3 && *segments[0].it == 0);
+         assertUnit(segments[1].count == 3 && *segments[1].it == 3);
+         assertUnit(segments[2].count == 2 && *segments[2].it == 6);
+         assertUnit(segments[3].count == 2 && *segments[3].it == 8);
+      }
+   }  // teardown
+
+   // never make an empty segment
+   void test_partition_moreSegmentsThanElements()
+   {  // setup
+      custom::list<int> l{ 11, 26, 31 };
+      // exercise
+      auto segments = custom::partition_segments(l, 8);
+      // verify
+      assertUnit(segments.size() == 3);
+      for (auto & seg : segments)
+         assertUnit(seg.count == 1);
+   }  // teardown
+
+   /***************************************
+    * FOR EACH
+    ***************************************/
+
+   // f is never called
+   void test_forEach_empty()
+   {  // setup
+      custom::list<int> l;
+      std::atomic<int> numCalls(0);
+      // exercise
+      custom::parallel_for_each(l, [&numCalls](int &) { numCalls++; }, 4);
+      // verify
+      assertUnit(numCalls == 0);
+   }  // teardown
+
+   // every element visited exactly once
+   void test_forEach_standard()
+   {  // setup
+      custom::list<int> l;
+      for (int i = 1; i <= 10000; i++)
+         l.push_back(i);
+      std::atomic<long> sum(0);
+      std::atomic<int> numCalls(0);
+      // exercise
+      custom::parallel_for_each(l, [&](int & value)
+      {
+         sum += value;
+         numCalls++;
+      }, 8);
+      // verify
+      assertUnit(numCalls == 10000);
+      assertUnit(sum == 10000L * 10001L / 2L);
+   }  // teardown
+
+   // an exception on a worker reaches the caller
+   void test_forEach_exception()
+   {  // setup
+      custom::list<int> l{ 11, 26, 31, 99 };
+      bool caught = false;
+      // exercise
+      try
+      {
+         custom::parallel_for_each(l, [](int & value)
+         {
+            if (value == 26)
+               throw std::runtime_error("26");
+         }, 4);
+      }
+      catch (const std::runtime_error &)
+      {
+         caught = true;
+      }
+      // verify
+      assertUnit(caught);
+   }  // teardown
+
+   /***************************************
+    * TRANSFORM
+    ***************************************/
+
+   // square every element in place
+   void test_transform_standard()
+   {  // setup
+      custom::list<int> l;
+      for (int i = 0; i < 1000; i++)
+         l.push_back(i);
+      // exercise
+      custom::parallel_transform(l, [](int value) { return value * value; }, 3);
+      // verify
+      assertUnit(l.size() == 1000);
+      bool allSquared = true;
+      int i = 0;
+      for (custom::list<int>::iterator it = l.begin(); it != l.end(); ++it, ++i)
+         if (*it != i * i)
+            allSquared = false;
+      assertUnit(allSquared);
+   }  // teardown
+
+   // a list that keeps a finger is cut up and visited the same way
+   void test_transform_fingerList()
+   {  // setup
+      custom::list<int, std::allocator<int>, true> l;
+      for (int i = 0; i < 1000; i++)
+         l.push_back(i);
+      l.at(500);
+      // exercise
+      custom::parallel_transform(l, [](int value) { return value + 1; }, 4);
+      // verify
+      assertUnit(l.size() == 1000);
+      assertUnit(l.at(0) == 1);
+      assertUnit(l.at(500) == 501);
+      assertUnit(l.at(999) == 1000);
+   }  // teardown
+
+   /***************************************
+    * SORT
+    ***************************************/
+
+   // too small to be worth threads, falls back to list::sort
+   void test_sort_small()
+   {  // setup
+      custom::list<int> l{ 31, 11, 26 };
+      // exercise
+      custom::parallel_sort(l, std::less<int>(), 4);
+      // verify
+      assertUnit(l.size() == 3);
+      assertUnit(l.front() == 11);
+      assertUnit(*++l.begin() == 26);
+      assertUnit(l.back() == 31);
+   }  // teardown
+
+   // enough elements for several chunks and merge rounds
+   void test_sort_large()
+   {  // setup
+      custom::list<int> l;
+      unsigned int seed = 12345;
+      for (int i = 0; i < 100000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         l.push_back((int)(seed >> 8) % 100000);
+      }
+      custom::list<int>::iterator itFirst = l.begin();
+      // exercise
+      custom::parallel_sort(l, std::less<int>(), 5);
+      // verify
+      assertUnit(l.size() == 100000);
+      bool ordered = true;
+      size_t count = 0;
+      int previous = l.front();
+      for (custom::list<int>::iterator it = l.begin(); it != l.end(); ++it, ++count)
+      {
+         if (*it < previous)
+            ordered = false;
+         previous = *it;
+      }
+      assertUnit(ordered);
+      assertUnit(count == 100000);
+      bool nodeKept = false;
+      for (custom::list<int>::iterator it = l.begin(); it != l.end(); ++it)
+         if (it == itFirst)
+            nodeKept = true;
+      assertUnit(nodeKept);
+   }  // teardown
+
+   // a list that keeps a finger sorts in chunks too, and its finger
+   // does not outlive the relinking
+   void test_sort_fingerList()
+   {  // setup
+      custom::list<int, std::allocator<int>, true> l;
+      for (int i = 20000; i > 0; i--)
+         l.push_back(i);
+      l.at(10000);
+      // exercise
+      custom::parallel_sort(l, std::less<int>(), 4);
+      // verify
+      assertUnit(l.size() == 20000);
+      assertUnit(l.at(0) == 1);
+      assertUnit(l.at(10000) == 10001);
+      assertUnit(l.at(10001) == 10002);
+      assertUnit(l.at(19999) == 20000);
+   }  // teardown
+
+   // cmp throws on a worker while the chunks sort
+   void test_sort_exceptionInChunk()
+   {  // setup
+      custom::list<int> l = descending(20000);
+      // exercise
+      bool caught = sortThrowing(l, [](int lhs, int rhs)
+      {
+         return lhs == 18000 || rhs == 18000;
+      });
+      // verify
+      assertUnit(caught);
+      assertUnit(l.size() == 20000);
+      assertUnit(sumBothWays(l) == 2 * (19999L * 20000L / 2L));
+   }  // teardown
+
+   // cmp throws once merging reaches chunks far apart
+   void test_sort_exceptionInMerge()
+   {  // setup
+      custom::list<int> l = descending(20000);
+      // exercise
+      bool caught = sortThrowing(l, [](int lhs, int rhs)
+      {
+         return lhs - rhs >= 10000 || rhs - lhs >= 10000;
+      });
+      // verify
+      assertUnit(caught);
+      assertUnit(l.size() == 20000);
+      assertUnit(sumBothWays(l) == 2 * (19999L * 20000L / 2L));
+   }  // teardown
+
+   /***************************************
+    * HELPERS
+    ***************************************/
+
+   // numElements - 1 down to 0, so each of 4 chunks holds a run of values
+   custom::list<int> descending(int numElements)
+   {
+      custom::list<int> l;
+      for (int i = numElements - 1; i >= 0; i--)
+         l.push_back(i);
+      return l;
+   }
+
+   // sort on 4 threads with a cmp that throws when fails(lhs, rhs)
+   template <class Fails>
+   bool sortThrowing(custom::list<int> & l, Fails fails)
+   {
+      try
+      {
+         custom::parallel_sort(l, [fails](int lhs, int rhs)
+         {
+            if (fails(lhs, rhs))
+               throw std::runtime_error("cmp");
+            return lhs < rhs;
+         }, 4);
+      }
+      catch (const std::runtime_error &)
+      {
+         return true;
+      }
+      return false;
+   }
+
+   // the sum walking forward plus the sum walking back
+   long sumBothWays(custom::list<int> & l)
+   {
+      long sum = 0;
+      for (custom::list<int>::iterator it = l.begin(); it != l.end(); ++it)
+         sum += *it;
+      for (custom::list<int>::iterator it = l.rbegin(); it != l.end(); --it)
+         sum += *it;
+      return sum;
+   }
+};
+
+#endif // DEBUG
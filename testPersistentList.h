@@ -0,0 +1,266 @@
+/***********************************************************************
+ * Header:
+ *    TEST PERSISTENT LIST
+ * Summary:
+ *    Unit tests for persistent_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "persistentList.h" // class under test
+#include "unitTest.h"       // unit test baseclass
+#include "spy.h"            // for the Spy class
+
+#include <stdexcept>
+#include <vector>
+
+/***********************************************
+ * TEST PERSISTENT LIST
+ * Unit tests for the persistent_list class
+ ***********************************************/
+class TestPersistentList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+      test_copy_shares();
+
+      // New versions
+      test_pushfront_shares();
+      test_popfront_shares();
+      test_popfront_empty();
+      test_insert_middle();
+      test_insert_end();
+      test_erase_middle();
+      test_erase_copyThrows();
+
+      // Release
+      test_release_frees();
+      test_release_longChain();
+
+      report("PersistentList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, nothing allocated
+   void test_construct_default()
+   {  // exercise
+      custom::persistent_list<int> l;
+      // verify
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.numElements == 0);
+      assertUnit(l.empty());
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   // build [11][26][31]
+   void test_construct_initializerList()
+   {  // exercise
+      custom::persistent_list<int> l{ 11, 26, 31 };
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.size() == 3);
+      assertUnit(l.front() == 11);
+      assertUnit(l.at(2) == 31);
+      assertUnit(l.pHead->refs == 1);
+   }  // teardown
+
+   // a copy is the same chain with one more reference
+   void test_copy_shares()
+   {  // setup
+      custom::persistent_list<int> l{ 11, 26, 31 };
+      // exercise
+      custom::persistent_list<int> lCopy(l);
+      // verify
+      assertUnit(lCopy.pHead == l.pHead);
+      assertUnit(l.pHead->refs == 2);
+      assertUnit(lCopy.size() == 3);
+   }  // teardown
+
+   /***************************************
+    * NEW VERSIONS
+    ***************************************/
+
+   // [11][26][31] -> [99][11][26][31], sharing all three old nodes
+   void test_pushfront_shares()
+   {  // setup
+      custom::persistent_list<int> l{ 11, 26, 31 };
+      // exercise
+      custom::persistent_list<int> lNew = l.push_front(99);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(contents(lNew) == std::vector<int>({ 99, 11, 26, 31 }));
+      assertUnit(lNew.pHead->pNext == l.pHead);
+      assertUnit(l.pHead->refs == 2);
+      assertUnit(lNew.size() == 4);
+   }  // teardown
+
+   // [11][26][31] -> [26][31], sharing both
+   void test_popfront_shares()
+   {  // setup
+      custom::persistent_list<int> l{ 11, 26, 31 };
+      // exercise
+      custom::persistent_list<int> lNew = l.pop_front();
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(contents(lNew) == std::vector<int>({ 26, 31 }));
+      assertUnit(lNew.pHead == l.pHead->pNext);
+      assertUnit(lNew.pHead->refs == 2);
+   }  // teardown
+
+   // nothing to pop
+   void test_popfront_empty()
+   {  // setup
+      custom::persistent_list<int> l;
+      // exercise
+      custom::persistent_list<int> lNew = l.pop_front();
+      // verify
+      assertUnit(lNew.empty());
+      assertUnit(lNew.size() == 0);
+   }  // teardown
+
+   // [11][26][31] -> [11][99][26][31], copying only [11]
+   void test_insert_middle()
+   {  // setup
+      custom::persistent_list<int> l{ 11, 26, 31 };
+      // exercise
+      custom::persistent_list<int> lNew = l.insert(1, 99);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(contents(lNew) == std::vector<int>({ 11, 99, 26, 31 }));
+      assertUnit(lNew.pHead != l.pHead);
+      assertUnit(lNew.pHead->pNext->pNext == l.pHead->pNext);
+      assertUnit(l.pHead->refs == 1);
+      assertUnit(l.pHead->pNext->refs == 2);
+      assertUnit(lNew.size() == 4);
+   }  // teardown
+
+   // inserting at size() shares nothing but the (empty) end
+   void test_insert_end()
+   {  // setup
+      custom::persistent_list<int> l{ 11, 26 };
+      // exercise
+      custom::persistent_list<int> lNew = l.insert(2, 31);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26 }));
+      assertUnit(contents(lNew) == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   // [11][99][26][31] -> [11][26][31], sharing [26][31]
+   void test_erase_middle()
+   {  // setup
+      custom::persistent_list<int> l{ 11, 99, 26, 31 };
+      // exercise
+      custom::persistent_list<int> lNew = l.erase(1);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 99, 26, 31 }));
+      assertUnit(contents(lNew) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(lNew.pHead->pNext == l.pHead->pNext->pNext);
+      assertUnit(lNew.size() == 3);
+   }  // teardown
+
+   // a copy that throws leaves no node and no reference behind
+   void test_erase_copyThrows()
+   {  // setup
+      Fragile::numLive = 0;
+      custom::persistent_list<Fragile> l{ Fragile(11), Fragile(26), Fragile(31),
+                                          Fragile(49), Fragile(57) };
+      Fragile::numCopiesLeft = 1;
+      bool thrown = false;
+      // exercise
+      try
+      {
+         l.erase(2);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      Fragile::numCopiesLeft = -1;
+      assertUnit(thrown);
+      assertUnit(Fragile::numLive == 5);
+      assertUnit(l.pHead->pNext->pNext->pNext->refs == 1);
+      assertUnit(l.size() == 5);
+      assertUnit(l.at(3).value == 49);
+   }  // teardown
+
+   /***************************************
+    * RELEASE
+    ***************************************/
+
+   // every node is destroyed once the last version goes, and only then
+   void test_release_frees()
+   {  // setup
+      Spy::reset();
+      {
+         custom::persistent_list<Spy> l1{ Spy(11), Spy(26) };
+         custom::persistent_list<Spy> l2 = l1.push_front(Spy(99));
+         int destroyedBefore = Spy::numDestructor();
+         // exercise
+         l1 = custom::persistent_list<Spy>();
+         // verify
+         assertUnit(Spy::numDestructor() == destroyedBefore);
+         assertUnit(l2.size() == 3);
+         assertUnit(l2.at(2).get() == 26);
+      }
+      assertUnit(Spy::numAlloc() == Spy::numDelete());
+   }  // teardown
+
+   // a very long history comes apart without recursion
+   void test_release_longChain()
+   {  // setup
+      custom::persistent_list<int> l;
+      for (int i = 0; i < 200000; i++)
+         l = l.push_front(i);
+      // exercise
+      custom::persistent_list<int> lShort = l.erase(3);
+      l = custom::persistent_list<int>();
+      // verify
+      assertUnit(lShort.size() == 199999);
+      assertUnit(lShort.front() == 199999);
+      assertUnit(lShort.at(3) == 199995);
+   }  // teardown
+
+   // counts its live copies; once numCopiesLeft reaches 0 a copy throws
+   struct Fragile
+   {
+      Fragile(int value) : value(value) { numLive++; }
+      Fragile(const Fragile & rhs) : value(rhs.value)
+      {
+         if (numCopiesLeft == 0)
+            throw std::runtime_error("copy");
+         if (numCopiesLeft > 0)
+            numCopiesLeft--;
+         numLive++;
+      }
+      ~Fragile() { numLive--; }
+
+      int value;
+      static inline int numLive = 0;
+      static inline int numCopiesLeft = -1;   // -1 never throws
+   };
+
+   // read one version out
+   std::vector<int> contents(const custom::persistent_list<int> & l)
+   {
+      std::vector<int> values;
+      for (custom::persistent_list<int>::const_iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,251 @@
+/***********************************************************************
+ * Header:
+ *    TEST RCU LIST
+ * Summary:
+ *    Unit tests for rcu_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "rcuList.h"      // class under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/***********************************************
+ * TEST RCU LIST
+ * Unit tests for the rcu_list class
+ ***********************************************/
+class TestRcuList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Insert
+      test_pushback_standard();
+      test_pushfront_standard();
+
+      // Remove
+      test_remove_middle();
+      test_remove_tail();
+      test_clear_standard();
+
+      // Reclaim
+      test_reclaim_deferredWhileReading();
+      test_reader_slotReused();
+
+      // Concurrent
+      test_readers_concurrent();
+
+      report("RcuList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, nothing allocated
+   void test_construct_default()
+   {  // exercise
+      custom::rcu_list<int> l;
+      // verify
+      assertUnit(l.pHead.load() == nullptr);
+      assertUnit(l.pTail == nullptr);
+      assertUnit(l.pSlots.load() == nullptr);
+      assertUnit(l.retired.empty());
+      assertUnit(l.empty());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push three items onto the back
+   void test_pushback_standard()
+   {  // setup
+      custom::rcu_list<int> l;
+      // exercise
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.pTail != nullptr && l.pTail->data == 31);
+      assertUnit(l.size() == 3);
+   }  // teardown
+
+   // push three items onto the front
+   void test_pushfront_standard()
+   {  // setup
+      custom::rcu_list<int> l;
+      // exercise
+      l.push_front(31);
+      l.push_front(26);
+      l.push_front(11);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.pTail != nullptr && l.pTail->data == 31);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // remove 99 from [11][99][26][31]
+   void test_remove_middle()
+   {  // setup
+      custom::rcu_list<int> l;
+      l.push_back(11);
+      l.push_back(99);
+      l.push_back(26);
+      l.push_back(31);
+      // exercise
+      size_t count = l.remove(99);
+      // verify
+      assertUnit(count == 1);
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.size() == 3);
+      assertUnit(l.retired.empty()); // nobody was reading
+   }  // teardown
+
+   // removing the last node moves pTail back
+   void test_remove_tail()
+   {  // setup
+      custom::rcu_list<int> l;
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(99);
+      // exercise
+      l.remove(99);
+      l.push_back(31);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   // everything goes
+   void test_clear_standard()
+   {  // setup
+      custom::rcu_list<int> l;
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.pHead.load() == nullptr);
+      assertUnit(l.pTail == nullptr);
+      assertUnit(l.empty());
+   }  // teardown
+
+   /***************************************
+    * RECLAIM
+    ***************************************/
+
+   // a node removed while a reader is inside stays until it leaves
+   void test_reclaim_deferredWhileReading()
+   {  // setup
+      custom::rcu_list<int> l;
+      l.push_back(11);
+      l.push_back(99);
+      l.push_back(26);
+      custom::rcu_list<int>::reader r(l);
+      r.lock();
+      uint64_t epochBefore = l.epoch.load();
+      // exercise
+      l.remove(99);
+      // verify
+      assertUnit(l.epoch.load() == epochBefore + 1);
+      assertUnit(l.retired.size() == 1);
+      if (l.retired.size() == 1)
+      {
+         assertUnit(l.retired[0].first->data == 99);
+         assertUnit(l.retired[0].second == epochBefore);
+      }
+      r.unlock();
+      l.reclaim();
+      assertUnit(l.retired.empty());
+      assertUnit(r.contains(26));
+      assertUnit(!r.contains(99));
+   }  // teardown
+
+   // a departed reader's slot goes to the next one
+   void test_reader_slotReused()
+   {  // setup
+      custom::rcu_list<int> l;
+      custom::rcu_list<int>::Slot * pSlot;
+      {
+         custom::rcu_list<int>::reader r(l);
+         pSlot = r.pSlot;
+      }
+      // exercise
+      custom::rcu_list<int>::reader r(l);
+      // verify
+      assertUnit(r.pSlot == pSlot);
+      assertUnit(l.pSlots.load() == pSlot);
+      assertUnit(pSlot->pNext == nullptr);
+   }  // teardown
+
+   /***************************************
+    * CONCURRENT
+    ***************************************/
+
+   // readers walk while a writer adds and removes
+   void test_readers_concurrent()
+   {  // setup
+      custom::rcu_list<int> l;
+      for (int i = 0; i < 100; i++)
+         l.push_back(i);
+      std::atomic<bool> done(false);
+      std::atomic<bool> sawGarbage(false);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 4; t++)
+         threads.emplace_back([&]()
+         {
+            custom::rcu_list<int>::reader r(l);
+            while (!done)
+               r.for_each([&](const int & value)
+               {
+                  if (value < 0 || value >= 1000)
+                     sawGarbage = true;
+               });
+         });
+      for (int i = 100; i < 1000; i++)
+      {
+         l.push_back(i);
+         l.remove(i - 100);
+      }
+      done = true;
+      for (std::thread & thread : threads)
+         thread.join();
+      l.synchronize();
+      // verify
+      assertUnit(!sawGarbage);
+      assertUnit(l.size() == 100);
+      assertUnit(l.retired.empty());
+      std::vector<int> values = contents(l);
+      assertUnit(values.size() == 100 && values.front() == 900 && values.back() == 999);
+   }  // teardown
+
+   // read the list out through a reader
+   std::vector<int> contents(custom::rcu_list<int> & l)
+   {
+      std::vector<int> values;
+      custom::rcu_list<int>::reader r(l);
+      r.for_each([&values](const int & value) { values.push_back(value); });
+      return values;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,300 @@
+/***********************************************************************
+ * Header:
+ *    TEST SERIALIZE
+ * Summary:
+ *    Unit tests for serialize and deserialize
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "serialize.h"    // functions under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST SERIALIZE
+ * Unit tests for the binary list format
+ ***********************************************/
+class TestSerialize : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Round Trip
+      test_roundTrip_empty();
+      test_roundTrip_manyInts();
+      test_roundTrip_struct();
+      test_roundTrip_noDefault();
+      test_roundTrip_strings();
+      test_roundTrip_backToBack();
+
+      // Format
+      test_header_layout();
+      test_writer_buffers();
+
+      // Errors
+      test_error_notAList();
+      test_error_wrongType();
+      test_error_truncated();
+      test_error_stringTooLong();
+
+      report("Serialize");
+   }
+
+   /***************************************
+    * ROUND TRIP
+    ***************************************/
+
+   // an empty list is only a header
+   void test_roundTrip_empty()
+   {  // setup
+      custom::list<int> l;
+      std::stringstream stream;
+      // exercise
+      custom::serialize(l, stream);
+      custom::list<int> lCopy = custom::deserialize<int>(stream);
+      // verify
+      assertUnit(stream.str().size() == sizeof(custom::serial_header));
+      assertUnit(lCopy.empty());
+   }  // teardown
+
+   // many chunks of raw bytes, and nothing else
+   void test_roundTrip_manyInts()
+   {  // setup
+      custom::list<int> l;
+      for (int i = 0; i < 100000; i++)
+         l.push_back(i * 7 - 500);
+      std::stringstream stream;
+      // exercise
+      custom::serialize(l, stream);
+      custom::list<int> lCopy = custom::deserialize<int>(stream);
+      // verify
+      assertUnit(stream.str().size() == sizeof(custom::serial_header) + 100000 * sizeof(int));
+      assertUnit(values(lCopy) == values(l));
+      assertUnit(*lCopy.rbegin() == 99999 * 7 - 500);
+   }  // teardown
+
+   // a plain struct goes through the raw bytes path too
+   void test_roundTrip_struct()
+   {  // setup
+      custom::list<Point> l;
+      l.push_back(Point{ 11, 2.5 });
+      l.push_back(Point{ 26, -1.0 });
+      std::stringstream stream;
+      // exercise
+      custom::serialize(l, stream);
+      custom::list<Point> lCopy = custom::deserialize<Point>(stream);
+      // verify
+      assertUnit(lCopy.size() == 2);
+      assertUnit((*lCopy.begin()).id == 11);
+      assertUnit((*lCopy.begin()).weight == 2.5);
+      assertUnit((*lCopy.rbegin()).id == 26);
+      assertUnit((*lCopy.rbegin()).weight == -1.0);
+   }  // teardown
+
+   // a trivially copyable type needs no default constructor to be read
+   void test_roundTrip_noDefault()
+   {  // setup
+      custom::list<Tag> l;
+      l.push_back(Tag(11));
+      l.push_back(Tag(26));
+      std::stringstream stream;
+      // exercise
+      custom::serialize(l, stream);
+      custom::list<Tag> lCopy = custom::deserialize<Tag>(stream);
+      // verify
+      assertUnit(lCopy.size() == 2);
+      assertUnit((*lCopy.begin()).id == 11);
+      assertUnit((*lCopy.rbegin()).id == 26);
+   }  // teardown
+
+   // strings vary in size; one is bigger than a whole chunk
+   void test_roundTrip_strings()
+   {  // setup
+      custom::list<std::string> l{ "eleven", "", std::string(200000, 'x'), "thirty-one" };
+      std::stringstream stream;
+      // exercise
+      custom::serialize(l, stream);
+      custom::list<std::string> lCopy = custom::deserialize<std::string>(stream);
+      // verify
+      assertUnit(lCopy.size() == 4);
+      custom::list<std::string>::iterator it = lCopy.begin();
+      assertUnit(*it++ == "eleven");
+      assertUnit(*it++ == "");
+      assertUnit(*it++ == std::string(200000, 'x'));
+      assertUnit(*it++ == "thirty-one");
+   }  // teardown
+
+   // the reader stops at its payload, so the next list is intact
+   void test_roundTrip_backToBack()
+   {  // setup
+      custom::list<int> l1{ 11, 26, 31 };
+      custom::list<std::string> l2{ "a", "bc" };
+      std::stringstream stream;
+      custom::serialize(l1, stream);
+      custom::serialize(l2, stream);
+      stream << "tail";
+      // exercise
+      custom::list<int> l1Copy = custom::deserialize<int>(stream);
+      custom::list<std::string> l2Copy = custom::deserialize<std::string>(stream);
+      std::string rest;
+      stream >> rest;
+      // verify
+      assertUnit(values(l1Copy) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l2Copy.size() == 2);
+      assertUnit(*l2Copy.rbegin() == "bc");
+      assertUnit(rest == "tail");
+   }  // teardown
+
+   /***************************************
+    * FORMAT
+    ***************************************/
+
+   // magic, element size, count, payload, then the raw values
+   void test_header_layout()
+   {  // setup
+      custom::list<int> l{ 11, 26, 31 };
+      std::stringstream stream;
+      // exercise
+      custom::serialize(l, stream);
+      // verify
+      std::string bytes = stream.str();
+      custom::serial_header header;
+      std::memcpy(&header, bytes.data(), sizeof(header));
+      assertUnit(bytes.size() == 24 + 12);
+      assertUnit(header.magic == custom::serial_header::MAGIC);
+      assertUnit(header.elementSize == sizeof(int));
+      assertUnit(header.count == 3);
+      assertUnit(header.payload == 12);
+      int third;
+      std::memcpy(&third, bytes.data() + 24 + 8, sizeof(int));
+      assertUnit(third == 31);
+   }  // teardown
+
+   // small writes wait in the chunk until it fills or is flushed
+   void test_writer_buffers()
+   {  // setup
+      std::ostringstream out;
+      std::vector<char> big(custom::serial_writer::CHUNK, 'b');
+      custom::serial_writer writer(out);
+      // exercise
+      writer.write("abc", 3);
+      size_t numBefore = out.str().size();
+      writer.write(big.data(), big.size());
+      // verify
+      assertUnit(numBefore == 0);
+      assertUnit(writer.numBuffered == 0);
+      assertUnit(out.str().size() == 3 + custom::serial_writer::CHUNK);
+      writer.write("d", 1);
+      assertUnit(writer.numBuffered == 1);
+      writer.flush();
+      assertUnit(out.str().size() == 4 + custom::serial_writer::CHUNK);
+   }  // teardown
+
+   /***************************************
+    * ERRORS
+    ***************************************/
+
+   // text is not a list
+   void test_error_notAList()
+   {  // setup
+      std::stringstream stream("this is not a list, just some text");
+      // exercise
+      std::string message = errorOf<int>(stream);
+      // verify
+      assertUnit(message == "deserialize: not a serialized list");
+   }  // teardown
+
+   // ints read back as doubles are refused by the header
+   void test_error_wrongType()
+   {  // setup
+      custom::list<int> l{ 11, 26, 31 };
+      std::stringstream stream;
+      custom::serialize(l, stream);
+      // exercise
+      std::string message = errorOf<double>(stream);
+      // verify
+      assertUnit(message == "deserialize: element size does not match");
+   }  // teardown
+
+   // a cut off stream throws instead of returning part of a list
+   void test_error_truncated()
+   {  // setup
+      custom::list<int> l{ 11, 26, 31 };
+      std::stringstream full;
+      custom::serialize(l, full);
+      std::stringstream stream(full.str().substr(0, full.str().size() - 2));
+      // exercise
+      std::string message = errorOf<int>(stream);
+      // verify
+      assertUnit(message == "deserialize: stream ended early");
+   }  // teardown
+
+   // a corrupt string length cannot ask for more than the payload
+   void test_error_stringTooLong()
+   {  // setup
+      custom::list<std::string> l{ "eleven" };
+      std::stringstream full;
+      custom::serialize(l, full);
+      std::string bytes = full.str();
+      uint64_t length = 1ull << 40;
+      std::memcpy(&bytes[sizeof(custom::serial_header)], &length, sizeof(length));
+      std::stringstream stream(bytes);
+      // exercise
+      std::string message = errorOf<std::string>(stream);
+      // verify
+      assertUnit(message == "deserialize: string runs past the payload");
+   }  // teardown
+
+   /***************************************
+    * HELPERS
+    ***************************************/
+
+   struct Point
+   {
+      int id;
+      double weight;
+   };
+
+   struct Tag
+   {
+      explicit Tag(int id) : id(id) {}
+      int id;
+   };
+
+   // the list in order, for comparing
+   std::vector<int> values(custom::list<int> & l)
+   {
+      std::vector<int> result(l.size());
+      l.copy_to(result.data(), result.size());
+      return result;
+   }
+
+   // what deserialize complained about, or "" if it did not
+   template <typename T>
+   std::string errorOf(std::istream & in)
+   {
+      try
+      {
+         custom::deserialize<T>(in);
+      }
+      catch (const std::runtime_error & e)
+      {
+         return e.what();
+      }
+      return "";
+   }
+};
+
+#endif // DEBUG
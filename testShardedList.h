@@ -0,0 +1,185 @@
+/***********************************************************************
+ * Header:
+ *    TEST SHARDED LIST
+ * Summary:
+ *    Unit tests for sharded_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "shardedList.h"  // class under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <thread>
+#include <vector>
+
+/***********************************************
+ * TEST SHARDED LIST
+ * Unit tests for the sharded_list class
+ ***********************************************/
+class TestShardedList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_zeroShards();
+
+      // Insert
+      test_pushback_explicitShard();
+
+      // Iterator
+      test_iterator_empty();
+      test_iterator_skipsEmptyShards();
+
+      // Combine
+      test_collapse_standard();
+      test_pushback_concurrent();
+
+      report("ShardedList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // every shard starts empty and on its own cache line
+   void test_construct_default()
+   {  // exercise
+      custom::sharded_list<int> l(4);
+      // verify
+      assertUnit(l.numShards == 4);
+      assertUnit(l.shard_count() == 4);
+      for (size_t i = 0; i < 4; i++)
+         assertUnit(l.shards[i].l.empty());
+      assertUnit((char *)&l.shards[1] - (char *)&l.shards[0] >= 64);
+      assertUnit(l.localShard() < 4);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // asking for no shards still gives one
+   void test_construct_zeroShards()
+   {  // exercise
+      custom::sharded_list<int> l(0);
+      // verify
+      assertUnit(l.numShards == 1);
+      l.push_back(11);
+      assertUnit(l.size() == 1);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push to a chosen shard
+   void test_pushback_explicitShard()
+   {  // setup
+      custom::sharded_list<int> l(3);
+      // exercise
+      l.push_back(2, 11);
+      l.push_back(2, 26);
+      l.push_back(0, 31);
+      // verify
+      assertUnit(l.shards[0].l.size() == 1);
+      assertUnit(l.shards[1].l.size() == 0);
+      assertUnit(l.shards[2].l.size() == 2);
+      assertUnit(l.shards[2].l.front() == 11);
+      assertUnit(l.shards[2].l.back() == 26);
+      assertUnit(l.size() == 3);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // begin is end when every shard is empty
+   void test_iterator_empty()
+   {  // setup
+      custom::sharded_list<int> l(3);
+      // exercise
+      custom::sharded_list<int>::iterator it = l.begin();
+      // verify
+      assertUnit(it == l.end());
+   }  // teardown
+
+   // [] [11][26] [] [31] reads 11, 26, 31
+   void test_iterator_skipsEmptyShards()
+   {  // setup
+      custom::sharded_list<int> l(4);
+      l.push_back(1, 11);
+      l.push_back(1, 26);
+      l.push_back(3, 31);
+      std::vector<int> values;
+      // exercise
+      for (custom::sharded_list<int>::iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      // verify
+      assertUnit(values == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   /***************************************
+    * COMBINE
+    ***************************************/
+
+   // shards spliced together, in shard order, without copying
+   void test_collapse_standard()
+   {  // setup
+      custom::sharded_list<int> l(3);
+      l.push_back(0, 11);
+      l.push_back(2, 26);
+      l.push_back(2, 31);
+      int * p26 = &l.shards[2].l.front();
+      // exercise
+      custom::list<int> lAll = l.collapse();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(lAll.size() == 3);
+      custom::list<int>::iterator it = lAll.begin();
+      assertUnit(*it == 11);
+      ++it;
+      assertUnit(*it == 26);
+      assertUnit(&*it == p26);
+      ++it;
+      assertUnit(*it == 31);
+   }  // teardown
+
+   // every thread's items survive, each in the order it pushed them
+   void test_pushback_concurrent()
+   {  // setup
+      custom::sharded_list<int> l(4);
+      const int numThreads = 8;
+      const int numEach = 2000;
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.emplace_back([&l, t]()
+         {
+            for (int i = 0; i < numEach; i++)
+               l.push_back(t * numEach + i);
+         });
+      for (std::thread & thread : threads)
+         thread.join();
+      custom::list<int> lAll = l.collapse();
+      // verify
+      assertUnit(lAll.size() == numThreads * numEach);
+      std::vector<int> last(numThreads, -1);
+      bool inOrder = true;
+      for (custom::list<int>::iterator it = lAll.begin(); it != lAll.end(); ++it)
+      {
+         int t = *it / numEach;
+         if (*it % numEach <= last[t])
+            inOrder = false;
+         last[t] = *it % numEach;
+      }
+      assertUnit(inOrder);
+   }  // teardown
+};
+
+#endif // DEBUG
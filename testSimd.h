@@ -0,0 +1,285 @@
+/***********************************************************************
+ * Header:
+ *    TEST SIMD
+ * Summary:
+ *    Unit tests for the vectorized find, count, min_element and
+ *    accumulate
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "simd.h"         // functions under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST SIMD
+ * Unit tests for every kernel the build has,
+ * each checked against the scalar loop
+ ***********************************************/
+class TestSimd : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Dispatch
+      test_level_detected();
+
+      // Find
+      test_find_everyPosition();
+      test_find_double();
+      test_find_generic();
+
+      // Count
+      test_count_random();
+      test_count_double();
+
+      // Min Element
+      test_minElement_random();
+      test_minElement_firstOfTies();
+
+      // Accumulate
+      test_accumulate_wraps();
+
+      // List
+      test_list_findCount();
+      test_list_minAccumulate();
+
+      report("Simd");
+   }
+
+   /***************************************
+    * DISPATCH
+    ***************************************/
+
+   // the level never promises more than was compiled in
+   void test_level_detected()
+   {  // exercise
+      custom::simd_width level = custom::simd_level();
+      // verify
+#if defined(CUSTOM_SIMD_AVX2)
+      assertUnit(level == custom::SIMD_AVX2 || level == custom::SIMD_SSE2);
+#elif defined(CUSTOM_SIMD_SSE2)
+      assertUnit(level == custom::SIMD_SSE2);
+#else
+      assertUnit(level == custom::SIMD_SCALAR);
+#endif
+      assertUnit(level == custom::simd_level());
+   }
+
+   /***************************************
+    * FIND
+    ***************************************/
+
+   // every length and every position, including the vector tails
+   void test_find_everyPosition()
+   {  // setup
+      bool same = true;
+      for (int length = 0; length < 40; length++)
+      {
+         std::vector<int> values(length);
+         for (int i = 0; i < length; i++)
+            values[i] = i * 3;
+         const int * first = values.data();
+         const int * last = first + length;
+         // exercise
+         for (int target = -1; target <= length; target++)
+         {
+            const int * pExpected = custom::simd::findScalar(first, last, target * 3);
+            same = same && custom::find(first, last, target * 3) == pExpected;
+#ifdef CUSTOM_SIMD_SSE2
+            same = same && custom::simd::findSse2(first, last, target * 3) == pExpected;
+#endif
+#ifdef CUSTOM_SIMD_AVX2
+            if (custom::simd_level() == custom::SIMD_AVX2)
+               same = same && custom::simd::findAvx2(first, last, target * 3) == pExpected;
+#endif
+         }
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // doubles compare by value: -0.0 finds 0.0, NaN finds nothing
+   void test_find_double()
+   {  // setup
+      double nan = std::numeric_limits<double>::quiet_NaN();
+      std::vector<double> values({ 1.5, 2.5, 0.0, 3.5, 4.5, 5.5, 6.5, nan });
+      const double * first = values.data();
+      const double * last = first + values.size();
+      // exercise
+      const double * pZero = custom::find(first, last, -0.0);
+      const double * pLast = custom::find(first, last, 6.5);
+      const double * pNan = custom::find(first, last, nan);
+      // verify
+      assertUnit(pZero == first + 2);
+      assertUnit(pLast == first + 6);
+      assertUnit(pNan == last);
+   }  // teardown
+
+   // types without a kernel take the plain loop
+   void test_find_generic()
+   {  // setup
+      std::vector<std::string> values({ "eleven", "twenty-six", "thirty-one" });
+      const std::string * first = values.data();
+      // exercise
+      const std::string * p = custom::find(first, first + 3, std::string("thirty-one"));
+      // verify
+      assertUnit(p == first + 2);
+   }  // teardown
+
+   /***************************************
+    * COUNT
+    ***************************************/
+
+   // random small values so there are many matches
+   void test_count_random()
+   {  // setup
+      srand(47);
+      std::vector<int> values(1037);
+      for (int & value : values)
+         value = rand() % 5;
+      const int * first = values.data();
+      const int * last = first + values.size();
+      bool same = true;
+      // exercise
+      for (int target = -1; target < 6; target++)
+      {
+         size_t expected = custom::simd::countScalar(first, last, target);
+         same = same && custom::count(first, last, target) == expected;
+#ifdef CUSTOM_SIMD_SSE2
+         same = same && custom::simd::countSse2(first, last, target) == expected;
+#endif
+#ifdef CUSTOM_SIMD_AVX2
+         if (custom::simd_level() == custom::SIMD_AVX2)
+            same = same && custom::simd::countAvx2(first, last, target) == expected;
+#endif
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // double counts match the loop, odd length included
+   void test_count_double()
+   {  // setup
+      std::vector<double> values;
+      for (int i = 0; i < 103; i++)
+         values.push_back((i % 7) * 0.5);
+      const double * first = values.data();
+      const double * last = first + values.size();
+      // exercise
+      size_t numHalf = custom::count(first, last, 0.5);
+      // verify
+      assertUnit(numHalf == custom::simd::countScalar(first, last, 0.5));
+      assertUnit(numHalf == 15);
+   }  // teardown
+
+   /***************************************
+    * MIN ELEMENT
+    ***************************************/
+
+   // random values at every length up to a few vectors
+   void test_minElement_random()
+   {  // setup
+      srand(470);
+      bool same = true;
+      for (int length = 0; length < 50; length++)
+      {
+         std::vector<int> values(length);
+         for (int & value : values)
+            value = rand() - RAND_MAX / 2;
+         const int * first = values.data();
+         const int * last = first + length;
+         // exercise
+         const int * pExpected = custom::simd::minScalar(first, last);
+         same = same && custom::min_element(first, last) == pExpected;
+#ifdef CUSTOM_SIMD_SSE2
+         same = same && custom::simd::minSse2(first, last) == pExpected;
+#endif
+#ifdef CUSTOM_SIMD_AVX2
+         if (custom::simd_level() == custom::SIMD_AVX2)
+            same = same && custom::simd::minAvx2(first, last) == pExpected;
+#endif
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // the smallest value appears twice; the first one wins
+   void test_minElement_firstOfTies()
+   {  // setup
+      std::vector<int> values({ 9, 8, 7, 6, 5, 4, 3, 2, -4, 1, 0, 9, -4, 3, 2, 1, 7 });
+      const int * first = values.data();
+      // exercise
+      const int * p = custom::min_element(first, first + values.size());
+      // verify
+      assertUnit(p == first + 8);
+   }  // teardown
+
+   /***************************************
+    * ACCUMULATE
+    ***************************************/
+
+   // sums agree with the scalar loop, even past INT_MAX
+   void test_accumulate_wraps()
+   {  // setup
+      std::vector<int> values(301, std::numeric_limits<int>::max() / 100);
+      const int * first = values.data();
+      const int * last = first + values.size();
+      // exercise
+      int sum = custom::accumulate(first, last, 7);
+      // verify
+      assertUnit(sum == custom::simd::sumScalar(first, last, 7));
+#ifdef CUSTOM_SIMD_SSE2
+      assertUnit(custom::simd::sumSse2(first, last, 7) == sum);
+#endif
+      assertUnit(custom::accumulate(first, first + 3, 1) == 3 * values[0] + 1);
+   }  // teardown
+
+   /***************************************
+    * LIST
+    ***************************************/
+
+   // find and count walk the nodes
+   void test_list_findCount()
+   {  // setup
+      custom::list<int> l;
+      for (int i = 0; i < 600; i++)
+         l.push_back(i % 10);
+      // exercise
+      custom::list<int>::iterator it = custom::find(l, 7);
+      custom::list<int>::iterator itMissing = custom::find(l, 11);
+      size_t numSevens = custom::count(l, 7);
+      // verify
+      assertUnit(it == l.position(7));
+      assertUnit(itMissing == l.end());
+      assertUnit(numSevens == 60);
+   }  // teardown
+
+   // min_element and accumulate over a list, arithmetic or not
+   void test_list_minAccumulate()
+   {  // setup
+      custom::list<int> l{ 26, 11, 31, 11 };
+      custom::list<std::string> ls{ "a", "b", "c" };
+      // exercise
+      custom::list<int>::iterator itMin = custom::min_element(l);
+      int sum = custom::accumulate(l, 0);
+      std::string joined = custom::accumulate(ls, std::string(">"));
+      // verify
+      assertUnit(itMin == l.position(1));
+      assertUnit(sum == 79);
+      assertUnit(joined == ">abc");
+   }  // teardown
+};
+
+#endif // DEBUG
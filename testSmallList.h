@@ -0,0 +1,242 @@
+/***********************************************************************
+ * Header:
+ *    TEST SMALL LIST
+ * Summary:
+ *    Unit tests for small_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "smallList.h"    // class under test
+#include "spy.h"          // for the Spy class
+#include "unitTest.h"     // unit test baseclass
+
+#include <utility>
+#include <vector>
+
+/***********************************************
+ * TEST SMALL LIST
+ * Unit tests for the small_list class
+ ***********************************************/
+class TestSmallList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_copy();
+      test_construct_move();
+
+      // Insert
+      test_push_inline();
+      test_push_spills();
+      test_insert_middle();
+
+      // Remove
+      test_erase_reusesSlot();
+      test_pop_ends();
+      test_clear_destroysAll();
+
+      // Assign
+      test_assign_copy();
+
+      report("SmallList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no slot taken
+   void test_construct_default()
+   {  // exercise
+      custom::small_list<int, 4> l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.used == 0);
+      assertUnit(l.begin() == l.end());
+      assertUnit(l.inline_capacity() == 4);
+   }  // teardown
+
+   // a copy fills its own slots
+   void test_construct_copy()
+   {  // setup
+      custom::small_list<int, 2> lSource{ 11, 26, 31 };
+      // exercise
+      custom::small_list<int, 2> lCopy(lSource);
+      // verify
+      assertUnit(contents(lCopy) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(lCopy.isInline(lCopy.pHead));
+      assertUnit(!lSource.isInline(lCopy.pHead));
+      assertUnit(!lCopy.isInline(lCopy.pTail));
+      assertUnit(contents(lSource) == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   // moving moves the elements, not the nodes
+   void test_construct_move()
+   {  // setup
+      custom::small_list<Spy, 4> lSource;
+      lSource.push_back(Spy(11));
+      lSource.push_back(Spy(26));
+      Spy::reset();
+      // exercise
+      custom::small_list<Spy, 4> lDest(std::move(lSource));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 2);
+      assertUnit(lSource.empty());
+      assertUnit(lSource.used == 0);
+      assertUnit(lDest.size() == 2);
+      assertUnit(lDest.front().get() == 11);
+      assertUnit(lDest.back().get() == 26);
+      assertUnit(lDest.isInline(lDest.pHead));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // up to N elements never leave the object
+   void test_push_inline()
+   {  // setup
+      custom::small_list<int, 4> l;
+      // exercise
+      l.push_back(26);
+      l.push_back(31);
+      l.push_front(11);
+      l.push_back(49);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31, 49 }));
+      assertUnit(backwards(l) == std::vector<int>({ 49, 31, 26, 11 }));
+      assertUnit(l.used == 0xF);
+      for (custom::small_list<int, 4>::iterator it = l.begin(); it != l.end(); ++it)
+         assertUnit(l.isInline(it.p));
+   }  // teardown
+
+   // the N+1st element goes to the heap
+   void test_push_spills()
+   {  // setup
+      custom::small_list<int, 2> l{ 11, 26 };
+      // exercise
+      l.push_back(31);
+      l.push_front(5);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 5, 11, 26, 31 }));
+      assertUnit(l.used == 0x3);
+      assertUnit(!l.isInline(l.pHead));
+      assertUnit(!l.isInline(l.pTail));
+      assertUnit(l.size() == 4);
+   }  // teardown
+
+   // insert in front of an iterator
+   void test_insert_middle()
+   {  // setup
+      custom::small_list<int, 4> l{ 11, 31 };
+      // exercise
+      custom::small_list<int, 4>::iterator it = l.insert(++l.begin(), 26);
+      // verify
+      assertUnit(*it == 26);
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(backwards(l) == std::vector<int>({ 31, 26, 11 }));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // an erased inline node frees its slot for the next insert
+   void test_erase_reusesSlot()
+   {  // setup
+      custom::small_list<int, 2> l{ 11, 26, 31 };
+      custom::small_list<int, 2>::iterator itFirst = l.begin();
+      custom::small_list<int, 2>::Node * pSlot = itFirst.p;
+      // exercise
+      custom::small_list<int, 2>::iterator it = l.erase(itFirst);
+      l.push_back(49);
+      // verify
+      assertUnit(*it == 26);
+      assertUnit(contents(l) == std::vector<int>({ 26, 31, 49 }));
+      assertUnit(l.pTail == pSlot);
+      assertUnit(l.used == 0x3);
+   }  // teardown
+
+   // pop from both ends, mixing heap and inline nodes
+   void test_pop_ends()
+   {  // setup
+      custom::small_list<int, 1> l{ 11, 26, 31 };
+      // exercise
+      l.pop_front();
+      l.pop_back();
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 26 }));
+      assertUnit(l.used == 0);
+      assertUnit(l.pHead == l.pTail);
+   }  // teardown
+
+   // clear destroys every element once, inline or not
+   void test_clear_destroysAll()
+   {  // setup
+      custom::small_list<Spy, 2> l;
+      l.push_back(Spy(11));
+      l.push_back(Spy(26));
+      l.push_back(Spy(31));
+      Spy::reset();
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 3);
+      assertUnit(l.empty());
+      assertUnit(l.used == 0);
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assignment replaces the contents
+   void test_assign_copy()
+   {  // setup
+      custom::small_list<int, 2> lSource{ 11, 26, 31 };
+      custom::small_list<int, 2> lDest{ 99 };
+      // exercise
+      lDest = lSource;
+      // verify
+      assertUnit(contents(lDest) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(lDest.used == 0x3);
+   }  // teardown
+
+   /***************************************
+    * HELPERS
+    ***************************************/
+
+   // read the list out front to back
+   template <size_t N>
+   std::vector<int> contents(custom::small_list<int, N> & l)
+   {
+      std::vector<int> values;
+      for (typename custom::small_list<int, N>::iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+
+   // read the list out back to front
+   template <size_t N>
+   std::vector<int> backwards(custom::small_list<int, N> & l)
+   {
+      std::vector<int> values;
+      for (typename custom::small_list<int, N>::iterator it = l.rbegin(); it != l.end(); --it)
+         values.push_back(*it);
+      return values;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,257 @@
+/***********************************************************************
+ * Header:
+ *    TEST SOA LIST
+ * Summary:
+ *    Unit tests for soa_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "soaList.h"      // class under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+/***********************************************
+ * TEST SOA LIST
+ * Unit tests for the soa_list class
+ ***********************************************/
+class TestSoaList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Insert
+      test_push_columnsDense();
+      test_insert_middle();
+
+      // Access
+      test_iterator_fields();
+      test_column_scan();
+
+      // Remove
+      test_erase_swapsLast();
+      test_erase_nextWasLast();
+      test_pop_ends();
+      test_random_againstList();
+
+      report("SoaList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, empty columns
+   void test_construct_default()
+   {  // exercise
+      Records l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.column<0>().empty());
+      assertUnit(l.column<1>().empty());
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // each field lands in its own column, in storage order
+   void test_push_columnsDense()
+   {  // setup
+      Records l;
+      // exercise
+      l.push_back(26, 2.5);
+      l.push_front(11, 1.5);
+      l.push_back(31, 3.5);
+      // verify
+      assertUnit(l.column<0>() == std::vector<int>({ 26, 11, 31 }));
+      assertUnit(l.column<1>() == std::vector<double>({ 2.5, 1.5, 3.5 }));
+      assertUnit(ids(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(backwards(l) == std::vector<int>({ 31, 26, 11 }));
+      assertUnit(std::get<0>(l.front()) == 11);
+      assertUnit(std::get<1>(l.back()) == 3.5);
+   }  // teardown
+
+   // insert in front of an iterator only relinks
+   void test_insert_middle()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0);
+      l.push_back(31, 3.0);
+      // exercise
+      Records::iterator it = l.insert(++l.begin(), 26, 2.0);
+      // verify
+      assertUnit(it.get<0>() == 26);
+      assertUnit(it.i == 2);
+      assertUnit(ids(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(backwards(l) == std::vector<int>({ 31, 26, 11 }));
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // rows can be read and written through the iterator
+   void test_iterator_fields()
+   {  // setup
+      custom::soa_list<int, std::string> l;
+      l.push_back(11, "eleven");
+      l.push_back(26, "twenty-six");
+      // exercise
+      custom::soa_list<int, std::string>::iterator it = l.begin();
+      ++it;
+      it.get<1>() += "!";
+      std::get<0>(*it) = 27;
+      // verify
+      assertUnit(l.column<0>() == std::vector<int>({ 11, 27 }));
+      assertUnit(l.column<1>()[1] == "twenty-six!");
+   }  // teardown
+
+   // a scan over one column sees every row
+   void test_column_scan()
+   {  // setup
+      Records l;
+      for (int i = 0; i < 100; i++)
+         l.push_front(i, i * 0.5);
+      // exercise
+      double sum = 0.0;
+      for (double value : l.column<1>())
+         sum += value;
+      // verify
+      assertUnit(sum == 2475.0);
+      assertUnit(l.column<1>().size() == 100);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase fills the hole with the last row and relinks it
+   void test_erase_swapsLast()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0);
+      l.push_back(26, 2.0);
+      l.push_back(31, 3.0);
+      l.push_back(49, 4.0);
+      l.push_front(5, 0.5);   // stored last, listed first
+      // exercise
+      Records::iterator it = l.erase(++l.begin());
+      // verify
+      assertUnit(it.get<0>() == 26);
+      assertUnit(l.column<0>() == std::vector<int>({ 5, 26, 31, 49 }));
+      assertUnit(l.column<1>() == std::vector<double>({ 0.5, 2.0, 3.0, 4.0 }));
+      assertUnit(ids(l) == std::vector<int>({ 5, 26, 31, 49 }));
+      assertUnit(backwards(l) == std::vector<int>({ 49, 31, 26, 5 }));
+      assertUnit(l.head == 0);
+   }  // teardown
+
+   // the returned iterator follows the row that moved
+   void test_erase_nextWasLast()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0);
+      l.push_back(31, 3.0);
+      l.insert(++l.begin(), 26, 2.0);   // stored last, listed second
+      // exercise
+      Records::iterator it = l.erase(l.begin());
+      // verify
+      assertUnit(it.i == 0);
+      assertUnit(it.get<0>() == 26);
+      assertUnit(ids(l) == std::vector<int>({ 26, 31 }));
+      assertUnit(backwards(l) == std::vector<int>({ 31, 26 }));
+   }  // teardown
+
+   // pop from both ends down to empty
+   void test_pop_ends()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0);
+      l.push_back(26, 2.0);
+      // exercise
+      l.pop_back();
+      l.pop_front();
+      l.pop_front();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.head == Records::NONE);
+      assertUnit(l.tail == Records::NONE);
+      assertUnit(l.column<1>().empty());
+   }  // teardown
+
+   // random inserts and erases keep the same order as std::list
+   void test_random_againstList()
+   {  // setup
+      Records l;
+      std::list<int> expected;
+      srand(46);
+      // exercise
+      for (int n = 0; n < 1000; n++)
+      {
+         size_t i = expected.empty() ? 0 : rand() % (expected.size() + 1);
+         Records::iterator it = l.begin();
+         std::list<int>::iterator itExpected = expected.begin();
+         for (size_t j = 0; j < i; j++, ++it, ++itExpected)
+            ;
+         if (rand() % 3 == 0 && it != l.end())
+         {
+            l.erase(it);
+            expected.erase(itExpected);
+         }
+         else
+         {
+            l.insert(it, n, n * 2.0);
+            expected.insert(itExpected, n);
+         }
+      }
+      // verify
+      assertUnit(ids(l) == std::vector<int>(expected.begin(), expected.end()));
+      assertUnit(backwards(l) == std::vector<int>(expected.rbegin(), expected.rend()));
+      bool paired = true;
+      for (size_t i = 0; i < l.size(); i++)
+         paired = paired && l.column<1>()[i] == l.column<0>()[i] * 2.0;
+      assertUnit(paired);
+   }  // teardown
+
+   /***************************************
+    * HELPERS
+    ***************************************/
+
+   typedef custom::soa_list<int, double> Records;
+
+   // the first field in list order
+   std::vector<int> ids(Records & l)
+   {
+      std::vector<int> values;
+      for (Records::iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(it.get<0>());
+      return values;
+   }
+
+   // the first field in reverse list order
+   std::vector<int> backwards(Records & l)
+   {
+      std::vector<int> values;
+      for (Records::iterator it = l.rbegin(); it != l.end(); --it)
+         values.push_back(it.get<0>());
+      return values;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,308 @@
+/***********************************************************************
+ * Header:
+ *    TEST SORTED LIST
+ * Summary:
+ *    Unit tests for sorted_list
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "sortedList.h"   // class under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/***********************************************
+ * TEST SORTED LIST
+ * Unit tests for the sorted_list class
+ ***********************************************/
+class TestSortedList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_copy();
+
+      // Insert
+      test_insert_outOfOrder();
+      test_insert_appendUsesTail();
+      test_insert_stableForEqual();
+      test_insert_compare();
+
+      // Search
+      test_find_standard();
+      test_bounds_standard();
+
+      // Remove
+      test_erase_iterator();
+      test_erase_value();
+
+      // Everything at once
+      test_random_againstSorted();
+
+      report("SortedList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no levels in use
+   void test_construct_default()
+   {  // exercise
+      custom::sorted_list<int> l;
+      // verify
+      assertUnit(l.numElements == 0);
+      assertUnit(l.numLevels == 0);
+      assertUnit(l.first[0] == nullptr);
+      assertUnit(l.begin() == l.end());
+      assertUnit(l.find(11) == l.end());
+      assertUnit(l.lower_bound(11) == l.end());
+   }  // teardown
+
+   // a copy is independent
+   void test_construct_copy()
+   {  // setup
+      custom::sorted_list<int> l = build({ 31, 11, 26 });
+      // exercise
+      custom::sorted_list<int> lCopy(l);
+      lCopy.insert(99);
+      // verify
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(contents(lCopy) == std::vector<int>({ 11, 26, 31, 99 }));
+      assertUnit(structureValid(lCopy));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // whatever the insert order, iteration is sorted
+   void test_insert_outOfOrder()
+   {  // setup
+      custom::sorted_list<int> l;
+      // exercise
+      custom::sorted_list<int>::iterator it26 = l.insert(26);
+      l.insert(31);
+      l.insert(11);
+      // verify
+      assertUnit(*it26 == 26);
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.front() == 11);
+      assertUnit(l.back() == 31);
+      assertUnit(structureValid(l));
+   }  // teardown
+
+   // appending in order keeps every tail current
+   void test_insert_appendUsesTail()
+   {  // setup
+      custom::sorted_list<int> l;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         l.insert(i);
+      // verify
+      assertUnit(l.size() == 1000);
+      assertUnit(l.back() == 999);
+      assertUnit(structureValid(l));
+   }  // teardown
+
+   // equal elements come out in the order they went in
+   void test_insert_stableForEqual()
+   {  // setup
+      typedef std::pair<int, char> Event;
+      auto byTime = [](const Event & lhs, const Event & rhs) { return lhs.first < rhs.first; };
+      custom::sorted_list<Event, decltype(byTime)> l(byTime);
+      // exercise
+      l.insert(Event(26, 'a'));
+      l.insert(Event(11, 'b'));
+      l.insert(Event(26, 'c'));
+      l.insert(Event(26, 'd'));
+      // verify
+      std::vector<char> order;
+      for (auto it = l.begin(); it != l.end(); ++it)
+         order.push_back((*it).second);
+      assertUnit(order == std::vector<char>({ 'b', 'a', 'c', 'd' }));
+   }  // teardown
+
+   // a different ordering
+   void test_insert_compare()
+   {  // setup
+      custom::sorted_list<int, std::greater<int>> l;
+      // exercise
+      l.insert(26);
+      l.insert(31);
+      l.insert(11);
+      // verify
+      std::vector<int> values;
+      for (auto it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      assertUnit(values == std::vector<int>({ 31, 26, 11 }));
+   }  // teardown
+
+   /***************************************
+    * SEARCH
+    ***************************************/
+
+   // find the ones that are there and not the ones that are not
+   void test_find_standard()
+   {  // setup
+      custom::sorted_list<int> l;
+      for (int i = 0; i < 500; i++)
+         l.insert((i * 37) % 500 * 2);
+      // exercise and verify
+      bool allRight = true;
+      for (int i = 0; i < 1000; i++)
+      {
+         custom::sorted_list<int>::iterator it = l.find(i);
+         if (i % 2 == 0 ? (it == l.end() || *it != i) : it != l.end())
+            allRight = false;
+      }
+      assertUnit(allRight);
+      assertUnit(l.contains(998));
+      assertUnit(!l.contains(999));
+   }  // teardown
+
+   // [11][26][26][31]
+   void test_bounds_standard()
+   {  // setup
+      custom::sorted_list<int> l = build({ 26, 31, 11, 26 });
+      // exercise
+      custom::sorted_list<int>::iterator itLower = l.lower_bound(26);
+      custom::sorted_list<int>::iterator itUpper = l.upper_bound(26);
+      // verify
+      assertUnit(itLower != l.end() && *itLower == 26);
+      --itLower;
+      assertUnit(*itLower == 11);
+      assertUnit(itUpper != l.end() && *itUpper == 31);
+      assertUnit(l.lower_bound(5) == l.begin());
+      assertUnit(l.upper_bound(31) == l.end());
+      assertUnit(*l.lower_bound(27) == 31);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // remove the second of two equal elements
+   void test_erase_iterator()
+   {  // setup
+      custom::sorted_list<int> l = build({ 11, 26, 26, 31 });
+      custom::sorted_list<int>::iterator it = l.lower_bound(26);
+      ++it;
+      // exercise
+      it = l.erase(it);
+      // verify
+      assertUnit(*it == 31);
+      assertUnit(contents(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(structureValid(l));
+   }  // teardown
+
+   // remove every 26, even when passed one of them
+   void test_erase_value()
+   {  // setup
+      custom::sorted_list<int> l = build({ 26, 11, 26, 31, 26 });
+      // exercise
+      size_t count = l.erase(*l.find(26));
+      // verify
+      assertUnit(count == 3);
+      assertUnit(contents(l) == std::vector<int>({ 11, 31 }));
+      assertUnit(l.erase(99) == 0);
+      assertUnit(structureValid(l));
+   }  // teardown
+
+   /***************************************
+    * EVERYTHING AT ONCE
+    ***************************************/
+
+   // random inserts and erases agree with a sorted std::vector
+   void test_random_againstSorted()
+   {  // setup
+      custom::sorted_list<int> l;
+      std::vector<int> v;
+      unsigned int seed = 12345;
+      // exercise
+      for (int step = 0; step < 4000; step++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int value = (int)((seed >> 8) % 300);
+         if ((seed >> 4) % 3)
+         {
+            l.insert(value);
+            v.insert(std::upper_bound(v.begin(), v.end(), value), value);
+         }
+         else
+         {
+            custom::sorted_list<int>::iterator it = l.find(value);
+            if (it != l.end())
+            {
+               l.erase(it);
+               v.erase(std::lower_bound(v.begin(), v.end(), value));
+            }
+         }
+      }
+      // verify
+      assertUnit(contents(l) == v);
+      assertUnit(structureValid(l));
+   }  // teardown
+
+   // build a list by inserting
+   custom::sorted_list<int> build(const std::vector<int> & values)
+   {
+      custom::sorted_list<int> l;
+      for (int value : values)
+         l.insert(value);
+      return l;
+   }
+
+   // read the list out with the iterator
+   std::vector<int> contents(const custom::sorted_list<int> & l)
+   {
+      std::vector<int> values;
+      for (custom::sorted_list<int>::iterator it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+
+   // every level links exactly the nodes that reach it, in order
+   bool structureValid(const custom::sorted_list<int> & l)
+   {
+      typedef custom::sorted_list<int>::Node Node;
+      size_t count = 0;
+      const Node * pPrev = nullptr;
+      for (const Node * p = l.first[0]; p; pPrev = p, p = p->skips[0], count++)
+         if (p->pPrev != pPrev || (pPrev && p->data < pPrev->data))
+            return false;
+      if (count != l.numElements || l.tail[0] != pPrev)
+         return false;
+
+      for (unsigned L = 1; L < custom::sorted_list<int>::MAX_LEVELS; L++)
+      {
+         const Node * pLast = nullptr;
+         const Node * pExpect = l.first[L];
+         for (const Node * p = l.first[0]; p; p = p->skips[0])
+            if (p->height > L)
+            {
+               if (p != pExpect)
+                  return false;
+               pExpect = p->skips[L];
+               pLast = p;
+            }
+         if (pExpect != nullptr || l.tail[L] != pLast || (pLast && L >= l.numLevels))
+            return false;
+      }
+      return true;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,158 @@
+/***********************************************************************
+ * Header:
+ *    TEST WORK STEALING
+ * Summary:
+ *    Unit tests for run_work_stealing
+ * Author
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "workStealing.h" // function under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+/***********************************************
+ * TEST WORK STEALING
+ * Unit tests for the work-stealing executor
+ ***********************************************/
+class TestWorkStealing : public UnitTest
+{
+public:
+   typedef std::function<void()> Task;
+
+   void run()
+   {
+      reset();
+
+      test_run_noQueues();
+      test_run_singleThread();
+      test_run_unevenQueues();
+      test_run_exception();
+      test_run_noDefaultTask();
+
+      report("WorkStealing");
+   }
+
+   // nothing to do
+   void test_run_noQueues()
+   {  // setup
+      custom::list<custom::list<Task>> queues;
+      // exercise
+      custom::work_stealing_stats stats = custom::run_work_stealing(queues, 4);
+      // verify
+      assertUnit(stats.numRun == 0);
+      assertUnit(stats.numStolen == 0);
+   }  // teardown
+
+   // one worker runs every queue in order, stealing nothing
+   void test_run_singleThread()
+   {  // setup
+      custom::list<custom::list<Task>> queues;
+      std::vector<int> order;
+      for (int q = 0; q < 3; q++)
+      {
+         custom::list<Task> queue;
+         for (int i = 0; i < 2; i++)
+            queue.push_back([&order, q, i]() { order.push_back(q * 10 + i); });
+         queues.push_back(std::move(queue));
+      }
+      // exercise
+      custom::work_stealing_stats stats = custom::run_work_stealing(queues, 1);
+      // verify
+      assertUnit(stats.numRun == 6);
+      assertUnit(stats.numStolen == 0);
+      assertUnit(order == std::vector<int>({ 0, 1, 10, 11, 20, 21 }));
+      for (custom::list<custom::list<Task>>::iterator it = queues.begin();
+           it != queues.end(); ++it)
+         assertUnit((*it).empty());
+   }  // teardown
+
+   // one long queue and several short ones: idle workers help out
+   void test_run_unevenQueues()
+   {  // setup
+      custom::list<custom::list<Task>> queues;
+      std::atomic<int> numDone(0);
+      custom::list<Task> longQueue;
+      for (int i = 0; i < 200; i++)
+         longQueue.push_back([&numDone]()
+         {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            numDone++;
+         });
+      queues.push_back(std::move(longQueue));
+      for (int q = 1; q < 4; q++)
+      {
+         custom::list<Task> queue;
+         queue.push_back([&numDone]() { numDone++; });
+         queues.push_back(std::move(queue));
+      }
+      // exercise
+      custom::work_stealing_stats stats = custom::run_work_stealing(queues, 4);
+      // verify
+      assertUnit(numDone == 203);
+      assertUnit(stats.numRun == 203);
+      assertUnit(stats.numStolen > 0);
+      for (custom::list<custom::list<Task>>::iterator it = queues.begin();
+           it != queues.end(); ++it)
+         assertUnit((*it).empty());
+   }  // teardown
+
+   // an exception stops the run and reaches the caller
+   void test_run_exception()
+   {  // setup
+      custom::list<custom::list<Task>> queues;
+      custom::list<Task> queue;
+      queue.push_back([]() { throw std::runtime_error("task"); });
+      queues.push_back(std::move(queue));
+      bool caught = false;
+      // exercise
+      try
+      {
+         custom::run_work_stealing(queues, 2);
+      }
+      catch (const std::runtime_error &)
+      {
+         caught = true;
+      }
+      // verify
+      assertUnit(caught);
+   }  // teardown
+
+   // a task type with no default constructor or assignment still runs
+   void test_run_noDefaultTask()
+   {  // setup
+      std::atomic<int> numDone(0);
+      custom::list<custom::list<Counter>> queues;
+      for (int q = 0; q < 4; q++)
+      {
+         custom::list<Counter> queue;
+         for (int i = 0; i < 10; i++)
+            queue.push_back(Counter(numDone));
+         queues.push_back(std::move(queue));
+      }
+      // exercise
+      custom::work_stealing_stats stats = custom::run_work_stealing(queues, 2);
+      // verify
+      assertUnit(numDone == 40);
+      assertUnit(stats.numRun == 40);
+   }  // teardown
+
+   // counts its runs; the reference member rules out default construction
+   struct Counter
+   {
+      explicit Counter(std::atomic<int> & numDone) : numDone(numDone) {}
+      void operator () () { numDone++; }
+      std::atomic<int> & numDone;
+   };
+};
+
+#endif // DEBUG
@@ -0,0 +1,396 @@
+/***********************************************************************
+ * Header:
+ *    UNORDERED MAP
+ * Summary:
+ *    A hash table whose entries all live in one custom::list, kept in
+ *    the order they were inserted. Each bucket is the head of a chain
+ *    threaded through the list: every entry remembers its hash and an
+ *    iterator to the next entry in the same bucket. Finding a key walks
+ *    only its bucket's chain, which is O(1) on average, while iterating
+ *    the map is a plain walk of the list in insertion order.
+ *
+ *    This replaces keeping a custom::list alongside a separate
+ *    std::unordered_map<K, list::iterator>: one allocation per element,
+ *    one structure to keep consistent.
+ *
+ *    This will contain the class definition of:
+ *        unordered_map           : A hash map with insertion order
+ *        unordered_map::iterator : A walk in insertion order
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <functional>  // for std::hash, std::equal_to
+#include <stdexcept>   // for std::out_of_range
+#include <utility>     // for std::pair, std::move
+#include <vector>      // for std::vector
+#include "list.h"      // for custom::list
+
+class TestHash; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * UNORDERED MAP
+ * Like std::unordered_map, except that iteration
+ * follows insertion order
+ **************************************************/
+template <typename K, typename V,
+          typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class unordered_map
+{
+   friend class ::TestHash; // give unit tests access to the privates
+public:
+   typedef std::pair<const K, V> value_type;
+
+   //
+   // Construct
+   //
+
+   unordered_map(size_t numBuckets = 8,
+                 const Hash & hash = Hash(), const KeyEqual & equal = KeyEqual())
+   : buckets(numBuckets ? numBuckets : 1), hasher(hash), equal(equal) {}
+   unordered_map(const std::initializer_list<value_type> & il);
+   unordered_map(const unordered_map & rhs);
+   unordered_map(unordered_map && rhs);
+
+   //
+   // Assign
+   //
+
+   unordered_map & operator = (unordered_map rhs) { swap(rhs); return *this; }
+   void swap(unordered_map & rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() { return iterator(entries.begin()); }
+   iterator end()   { return iterator(entries.end());   }
+
+   //
+   // Access
+   //
+
+   iterator find(const K & key);
+   size_t count(const K & key) { return find(key) != end() ? 1 : 0; }
+   bool contains(const K & key) { return find(key) != end(); }
+   V & at(const K & key);
+   V & operator [] (const K & key);
+
+   //
+   // Insert
+   //
+
+   std::pair<iterator, bool> insert(const value_type & value);
+
+   //
+   // Remove
+   //
+
+   iterator erase(iterator it);
+   size_t erase(const K & key);
+   void clear();
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return entries.empty(); }
+   size_t size() const { return entries.size();  }
+   size_t bucket_count() const { return buckets.size(); }
+   size_t bucket_size(size_t iBucket);
+   float load_factor() const { return (float)size() / (float)buckets.size(); }
+   void rehash(size_t numBuckets);
+
+private:
+   // one element and its place in a bucket chain
+   struct Entry;
+   typedef list <Entry> Entries;
+   typedef typename Entries :: iterator EntryIt;
+
+   struct Entry
+   {
+      Entry(const value_type & value, size_t hash)
+      : value(value), hash(hash) {}
+
+      value_type value;    // the key and its value
+      size_t hash;         // cached so rehashing never calls the hasher
+      EntryIt itNext;      // next entry in the same bucket, end() at the last
+   };
+
+   EntryIt findEntry(const K & key, size_t hash);
+   EntryIt link(const value_type & value, size_t hash);
+
+   // member variables
+   Entries entries;               // every entry, in insertion order
+   std::vector<EntryIt> buckets;  // first entry of each chain, end() if none
+   Hash hasher;                   // hashes a key
+   KeyEqual equal;                // compares two keys
+};
+
+/*************************************************
+ * UNORDERED MAP ITERATOR
+ * Walks the shared list, so in insertion order
+ ************************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+class unordered_map <K, V, Hash, KeyEqual> :: iterator
+{
+   friend class ::TestHash; // give unit tests access to the privates
+   friend class custom::unordered_map <K, V, Hash, KeyEqual>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return it == rhs.it; }
+   bool operator != (const iterator & rhs) const { return it != rhs.it; }
+
+   // dereference operator, fetch an element
+   value_type & operator * ()  { return (*it).value;  }
+   value_type * operator -> () { return &(*it).value; }
+
+   // prefix increment
+   iterator & operator ++ () { ++it; return *this; }
+
+   // postfix increment
+   iterator operator ++ (int) { iterator tmp = *this; ++it; return tmp; }
+
+private:
+   iterator(const EntryIt & it) : it(it) {}
+
+   EntryIt it;   // where we are in the shared list
+};
+
+/*****************************************
+ * UNORDERED MAP :: CONSTRUCTORS
+ ****************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+unordered_map <K, V, Hash, KeyEqual> ::
+   unordered_map(const std::initializer_list<value_type> & il)
+: buckets(il.size() > 8 ? il.size() : 8)
+{
+   for (const value_type & value : il)
+      insert(value);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+unordered_map <K, V, Hash, KeyEqual> :: unordered_map(const unordered_map & rhs)
+: buckets(rhs.buckets.size()), hasher(rhs.hasher), equal(rhs.equal)
+{
+   for (typename Entries :: const_iterator it = rhs.entries.cbegin(); it != rhs.entries.cend(); ++it)
+      link((*it).value, (*it).hash);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+unordered_map <K, V, Hash, KeyEqual> :: unordered_map(unordered_map && rhs)
+: buckets(1), hasher(rhs.hasher), equal(rhs.equal)
+{
+   swap(rhs);
+}
+
+/*****************************************
+ * UNORDERED MAP :: SWAP
+ *    COST   : O(1)
+ ****************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void unordered_map <K, V, Hash, KeyEqual> :: swap(unordered_map & rhs)
+{
+   entries.swap(rhs.entries);
+   buckets.swap(rhs.buckets);
+   std::swap(hasher, rhs.hasher);
+   std::swap(equal, rhs.equal);
+}
+
+/*********************************************
+ * UNORDERED MAP :: FIND ENTRY
+ * Walk the key's bucket chain
+ *    INPUT  : the key and its hash
+ *    OUTPUT : its entry, or entries.end()
+ *    COST   : O(1) average
+ *********************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename unordered_map <K, V, Hash, KeyEqual> :: EntryIt
+unordered_map <K, V, Hash, KeyEqual> :: findEntry(const K & key, size_t hash)
+{
+   EntryIt it = buckets[hash % buckets.size()];
+   while (it != entries.end() &&
+          ((*it).hash != hash || !equal((*it).value.first, key)))
+      it = (*it).itNext;
+   return it;
+}
+
+/*********************************************
+ * UNORDERED MAP :: FIND
+ *    INPUT  : the key
+ *    OUTPUT : its element, or end()
+ *    COST   : O(1) average
+ *********************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename unordered_map <K, V, Hash, KeyEqual> :: iterator
+unordered_map <K, V, Hash, KeyEqual> :: find(const K & key)
+{
+   return iterator(findEntry(key, hasher(key)));
+}
+
+/*********************************************
+ * UNORDERED MAP :: AT
+ * The value for key, which must be present
+ *    COST   : O(1) average
+ *********************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+V & unordered_map <K, V, Hash, KeyEqual> :: at(const K & key)
+{
+   EntryIt it = findEntry(key, hasher(key));
+   if (it == entries.end())
+      throw std::out_of_range("unordered_map::at");
+   return (*it).value.second;
+}
+
+/*********************************************
+ * UNORDERED MAP :: SQUARE BRACKET
+ * The value for key, default-constructed and
+ * appended if the key is new
+ *    COST   : O(1) average
+ *********************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+V & unordered_map <K, V, Hash, KeyEqual> :: operator [] (const K & key)
+{
+   size_t hash = hasher(key);
+   EntryIt it = findEntry(key, hash);
+   if (it == entries.end())
+      it = link(value_type(key, V()), hash);
+   return (*it).value.second;
+}
+
+/*********************************************
+ * UNORDERED MAP :: INSERT
+ * Append the element unless its key is present
+ *    OUTPUT : the element with that key, and
+ *             whether it was just added
+ *    COST   : O(1) average, amortized over rehashing
+ *********************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+std::pair<typename unordered_map <K, V, Hash, KeyEqual> :: iterator, bool>
+unordered_map <K, V, Hash, KeyEqual> :: insert(const value_type & value)
+{
+   size_t hash = hasher(value.first);
+   EntryIt it = findEntry(value.first, hash);
+   if (it != entries.end())
+      return std::make_pair(iterator(it), false);
+   return std::make_pair(iterator(link(value, hash)), true);
+}
+
+/*********************************************
+ * UNORDERED MAP :: LINK
+ * Append a new entry to the list and the front of
+ * its bucket chain, growing the table first if
+ * that would push the load factor past 1
+ *    COST   : O(1), or O(n) when it rehashes
+ *********************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename unordered_map <K, V, Hash, KeyEqual> :: EntryIt
+unordered_map <K, V, Hash, KeyEqual> :: link(const value_type & value, size_t hash)
+{
+   if (entries.size() + 1 > buckets.size())
+      rehash(buckets.size() * 2);
+
+   entries.push_back(Entry(value, hash));
+   EntryIt it = entries.rbegin();
+   EntryIt & itHead = buckets[hash % buckets.size()];
+   (*it).itNext = itHead;
+   itHead = it;
+   return it;
+}
+
+/*********************************************
+ * UNORDERED MAP :: ERASE
+ * Unhook the entry from its bucket chain, then
+ * from the list
+ *    INPUT  : the element to remove
+ *    OUTPUT : the element inserted after it
+ *    COST   : O(1) average
+ *********************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename unordered_map <K, V, Hash, KeyEqual> :: iterator
+unordered_map <K, V, Hash, KeyEqual> :: erase(iterator itErase)
+{
+   EntryIt it = itErase.it;
+   EntryIt * pLink = &buckets[(*it).hash % buckets.size()];
+   while (*pLink != it)
+      pLink = &(**pLink).itNext;
+   *pLink = (*it).itNext;
+   return iterator(entries.erase(it));
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t unordered_map <K, V, Hash, KeyEqual> :: erase(const K & key)
+{
+   EntryIt it = findEntry(key, hasher(key));
+   if (it == entries.end())
+      return 0;
+   erase(iterator(it));
+   return 1;
+}
+
+/*********************************************
+ * UNORDERED MAP :: CLEAR
+ * Keep the bucket count, drop every entry
+ *    COST   : O(n + buckets)
+ *********************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void unordered_map <K, V, Hash, KeyEqual> :: clear()
+{
+   entries.clear();
+   for (EntryIt & it : buckets)
+      it = entries.end();
+}
+
+/*********************************************
+ * UNORDERED MAP :: BUCKET SIZE
+ * How long one bucket's chain is
+ *    COST   : O(chain length)
+ *********************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t unordered_map <K, V, Hash, KeyEqual> :: bucket_size(size_t iBucket)
+{
+   size_t count = 0;
+   for (EntryIt it = buckets[iBucket]; it != entries.end(); it = (*it).itNext)
+      count++;
+   return count;
+}
+
+/*********************************************
+ * UNORDERED MAP :: REHASH
+ * Rebuild the chains for a new bucket count using
+ * the cached hashes. No entry moves in the list,
+ * so iterators and insertion order survive.
+ *    INPUT  : the new bucket count
+ *    COST   : O(n + buckets)
+ *********************************************/
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void unordered_map <K, V, Hash, KeyEqual> :: rehash(size_t numBuckets)
+{
+   if (numBuckets < size())
+      numBuckets = size();
+   if (numBuckets == 0)
+      numBuckets = 1;
+
+   std::vector<EntryIt> newBuckets(numBuckets);
+   for (EntryIt it = entries.begin(); it != entries.end(); ++it)
+   {
+      EntryIt & itHead = newBuckets[(*it).hash % numBuckets];
+      (*it).itNext = itHead;
+      itHead = it;
+   }
+   buckets.swap(newBuckets);
+}
+
+}; // namespace custom
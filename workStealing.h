@@ -0,0 +1,160 @@
+/***********************************************************************
+ * Header:
+ *    WORK STEALING
+ * Summary:
+ *    Run a list of task queues, custom::list<custom::list<Task>>, on
+ *    several threads without letting one long queue hold up the rest.
+ *
+ *    Every queue is owned by one worker, which pops from the front of
+ *    its own queues. A worker that runs dry steals from the back of
+ *    somebody else's queue, taking the work its owner would reach last,
+ *    in one O(1) pop_back. Each queue has a single mutex that owner and
+ *    thief both take for every pop, whichever end they work at. It is
+ *    held only for that pop, and two workers contend only when they
+ *    want the same queue at the same moment.
+ *
+ *    This will contain the definition of:
+ *        run_work_stealing : execute every task in every queue
+ * Authors
+ *    Daniel Carr, Jarom Anderson, Arlo Jolly
+ ************************************************************************/
+
+#pragma once
+#include <atomic>      // for std::atomic
+#include <cstddef>     // for size_t
+#include <exception>   // for std::exception_ptr
+#include <mutex>       // for std::mutex
+#include <optional>    // for std::optional
+#include <thread>      // for std::thread
+#include <utility>     // for std::move
+#include <vector>      // for std::vector
+#include "list.h"      // for custom::list
+#include "parallel.h"  // for custom::defaultNumThreads
+
+namespace custom
+{
+
+/**************************************************
+ * WORK STEALING STATS
+ * What happened during one run
+ **************************************************/
+struct work_stealing_stats
+{
+   size_t numRun;     // tasks executed
+   size_t numStolen;  // of those, how many were taken from another worker
+};
+
+/*********************************************
+ * RUN WORK STEALING
+ * Execute task() for every task in every queue,
+ * emptying the queues. Queue i belongs to worker
+ * i % numThreads. Tasks must not add to the queues
+ * while they run. The first exception any task
+ * throws is rethrown after every worker stops.
+ *    INPUT  : the queues, the number of threads
+ *    OUTPUT : how many tasks ran and were stolen
+ *    COST   : O(tasks + queues * steal attempts)
+ *********************************************/
+template <typename Task, typename A, typename AA>
+work_stealing_stats run_work_stealing(list <list <Task, A>, AA> & queues,
+                                      size_t numThreads = defaultNumThreads())
+{
+   // index the queues so a thief can reach any of them in O(1)
+   std::vector<list <Task, A> *> qs;
+   for (typename list <list <Task, A>, AA> :: iterator it = queues.begin();
+        it != queues.end(); ++it)
+      qs.push_back(&*it);
+   if (numThreads > qs.size())
+      numThreads = qs.size();
+
+   work_stealing_stats stats = { 0, 0 };
+   if (numThreads == 0)
+      return stats;
+
+   std::vector<std::mutex> locks(qs.size());
+   std::atomic<size_t> numRun(0);
+   std::atomic<size_t> numStolen(0);
+   std::atomic<bool> failed(false);
+   std::exception_ptr error;
+   std::mutex errorLock;
+
+   // take one task from the front (own) or back (steal) of queue i,
+   // moved straight out of its node so Task needs no default constructor;
+   // front() and back() need one for their empty-list fallback
+   auto take = [&qs, &locks](size_t i, bool fromBack, std::optional<Task> & task) -> bool
+   {
+      std::lock_guard<std::mutex> guard(locks[i]);
+      if (qs[i]->empty())
+         return false;
+      if (fromBack)
+      {
+         task.emplace(std::move(*qs[i]->rbegin()));
+         qs[i]->pop_back();
+      }
+      else
+      {
+         task.emplace(std::move(*qs[i]->begin()));
+         qs[i]->pop_front();
+      }
+      return true;
+   };
+
+   auto worker = [&](size_t w)
+   {
+      size_t iOwn = w;                // next of our own queues to try
+      size_t iVictim = w + 1;         // next queue to rob
+      while (!failed)
+      {
+         bool stolen = false;
+         std::optional<Task> task;
+
+         // our own queues first, front to back
+         while (!task && iOwn < qs.size())
+            if (!take(iOwn, false, task))
+               iOwn += numThreads;
+
+         // then everybody else's, from the back
+         for (size_t tries = 0; !task && tries < qs.size(); tries++, iVictim++)
+         {
+            size_t i = iVictim % qs.size();
+            if (i % numThreads != w && take(i, true, task))
+               stolen = true;
+         }
+
+         // a full sweep came up empty and nothing is ever added: done
+         if (!task)
+            return;
+
+         try
+         {
+            (*task)();
+         }
+         catch (...)
+         {
+            std::lock_guard<std::mutex> guard(errorLock);
+            if (!error)
+               error = std::current_exception();
+            failed = true;
+         }
+         numRun++;
+         if (stolen)
+            numStolen++;
+      }
+   };
+
+   std::vector<std::thread> threads;
+   for (size_t w = 1; w < numThreads; w++)
+      threads.emplace_back(worker, w);
+   worker(0);
+   for (std::thread & thread : threads)
+      thread.join();
+
+   if (error)
+      std::rethrow_exception(error);
+
+   stats.numRun = numRun;
+   stats.numStolen = numStolen;
+   return stats;
+}
+
+}; // namespace custom